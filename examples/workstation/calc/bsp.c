@@ -45,6 +45,7 @@
 
 static char l_display[DISP_WIDTH + 1]; /* the calculator display */
 static int  l_len;  /* number of displayed characters */
+static int  l_quiet; /* suppress the output (benchmark)? */
 
 /*..........................................................................*/
 void BSP_clear(void) {
@@ -72,7 +73,9 @@ void BSP_negate(void) {
 }
 /*..........................................................................*/
 void BSP_display(void) {
-    PRINTF_S("\n[%" STRINGIFY(DISP_WIDTH) "s] ", l_display);
+    if (!l_quiet) {
+        PRINTF_S("\n[%" STRINGIFY(DISP_WIDTH) "s] ", l_display);
+    }
 }
 /*..........................................................................*/
 void BSP_exit(void) {
@@ -131,7 +134,13 @@ int BSP_eval(double operand1, int oper, double operand2) {
 }
 /*..........................................................................*/
 void BSP_message(char const *msg) {
-    PRINTF_S("%s", msg);
+    if (!l_quiet) {
+        PRINTF_S("%s", msg);
+    }
+}
+/*..........................................................................*/
+void BSP_setQuiet(int quiet) {
+    l_quiet = quiet;
 }
 
 /*..........................................................................*/
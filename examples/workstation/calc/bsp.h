@@ -42,5 +42,6 @@ void BSP_exit(void);
 
 void BSP_display(void);
 void BSP_message(char const *state);
+void BSP_setQuiet(int quiet); /* suppress the output (benchmark) */
 
 #endif                                                             /* BSP_H */
@@ -70,6 +70,42 @@ static Calc l_calc;    /* the only instance of the Calc class */
 /* global-scope definitions ---------------------------------------*/
 QHsm * const the_calc = &l_calc.super;  /* "opaque" pointer to MSM */
 
+#ifdef QHSM_SIG_MAP
+/* signals handled by the states of Calc (see QHsmSigMap) */
+static QSignal const l_on_sigs[]      = { C_SIG, OFF_SIG, 0U };
+static QSignal const l_none_sigs[]    = { 0U };
+static QSignal const l_negated_sigs[] = { DIGIT_0_SIG, DIGIT_1_9_SIG,
+                                          POINT_SIG, OPER_SIG, CE_SIG, 0U };
+static QSignal const l_ready_sigs[]   = { DIGIT_0_SIG, DIGIT_1_9_SIG,
+                                          POINT_SIG, OPER_SIG, 0U };
+static QSignal const l_begin_sigs[]   = { OPER_SIG, 0U };
+static QSignal const l_operand_sigs[] = { CE_SIG, OPER_SIG, EQUALS_SIG, 0U };
+static QSignal const l_number_sigs[]  = { DIGIT_0_SIG, DIGIT_1_9_SIG,
+                                          POINT_SIG, 0U };
+
+static QHsmStateSigs const l_stateSigs[] = {
+    { Q_STATE_CAST(&Calc_on),        l_on_sigs      },
+    { Q_STATE_CAST(&Calc_error),     l_none_sigs    },
+    { Q_STATE_CAST(&Calc_negated1),  l_negated_sigs },
+    { Q_STATE_CAST(&Calc_ready),     l_ready_sigs   },
+    { Q_STATE_CAST(&Calc_result),    l_none_sigs    },
+    { Q_STATE_CAST(&Calc_begin),     l_begin_sigs   },
+    { Q_STATE_CAST(&Calc_operand1),  l_operand_sigs },
+    { Q_STATE_CAST(&Calc_zero1),     l_number_sigs  },
+    { Q_STATE_CAST(&Calc_int1),      l_number_sigs  },
+    { Q_STATE_CAST(&Calc_frac1),     l_number_sigs  },
+    { Q_STATE_CAST(&Calc_opEntered), l_ready_sigs   },
+    { Q_STATE_CAST(&Calc_negated2),  l_negated_sigs },
+    { Q_STATE_CAST(&Calc_operand2),  l_operand_sigs },
+    { Q_STATE_CAST(&Calc_zero2),     l_number_sigs  },
+    { Q_STATE_CAST(&Calc_int2),      l_number_sigs  },
+    { Q_STATE_CAST(&Calc_frac2),     l_number_sigs  },
+    { Q_STATE_CAST(&Calc_final),     l_none_sigs    }
+};
+static uint8_t l_route[Q_DIM(l_stateSigs)][OFF_SIG + 1 - Q_USER_SIG];
+static QHsmSigMap l_sigMap;
+#endif /* QHSM_SIG_MAP */
+
 /*$skip${QP_VERSION} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
 /* Check for the minimum required QP version */
 #if (QP_VERSION < 690U) || (QP_VERSION != ((QP_RELEASE^4294967295U) % 0x3E8U))
@@ -83,6 +119,12 @@ QHsm * const the_calc = &l_calc.super;  /* "opaque" pointer to MSM */
 void Calc_ctor(void) {
     Calc *me = &l_calc;
     QHsm_ctor(&me->super, Q_STATE_CAST(&Calc_initial));
+#ifdef QHSM_SIG_MAP
+    /* route the events directly to the states that handle them */
+    QHsmSigMap_init(&l_sigMap, l_stateSigs, Q_DIM(l_stateSigs),
+                    &l_route[0][0], OFF_SIG + 1 - Q_USER_SIG);
+    QHsm_setSigMap(&me->super, &l_sigMap);
+#endif
 }
 /*$enddef${SMs::Calc_ctor} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
 /*$define${SMs::Calc} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
@@ -36,15 +36,30 @@
 #include "calc.h"
 
 #include "safe_std.h" /* portable "safe" <stdio.h>/<string.h> facilities */
+#include <stdlib.h>
+#include <time.h>     /* for clock() */
 
 Q_DEFINE_THIS_FILE
 
+static QSignal keyToSig(uint8_t const key);
+static void benchmark(uint32_t const loops);
+
+/* the sequence of keys dispatched repeatedly by the benchmark */
+static char const l_benchKeys[] =
+    "12.5*-3=c7/0=c-4.25+10.75=*2=e3=c0.001-0.0005=c99999*99999=/3=c";
+
 /*..........................................................................*/
-int main() {
+int main(int argc, char *argv[]) {
 
     QF_init();
     QF_onStartup();
 
+    if ((argc > 1) && (strcmp(argv[1], "-b") == 0)) { /* benchmark? */
+        benchmark((argc > 2) ? (uint32_t)atoi(argv[2]) : 200000U);
+        QF_onCleanup();
+        return 0;
+    }
+
     PRINTF_S("Calculator example, QP version: %s\n"
            "Press '0' .. '9'     to enter a digit\n"
            "Press '.'            to enter the decimal point\n"
@@ -71,58 +86,7 @@ int main() {
         e.key_code = (uint8_t)QF_consoleWaitForKey();
         PRINTF_S("%c ", (e.key_code >= ' ') ? e.key_code : 'X');
 
-        switch (e.key_code) {
-            case 'c': /* intentionally fall through */
-            case 'C': {
-                e.super.sig = C_SIG;
-                break;
-            }
-            case 'e': /* intentionally fall through */
-            case 'E': {
-                e.super.sig = CE_SIG;
-                break;
-            }
-            case '0': {
-                e.super.sig = DIGIT_0_SIG;
-                break;
-            }
-            case '1': /* intentionally fall through */
-            case '2': /* intentionally fall through */
-            case '3': /* intentionally fall through */
-            case '4': /* intentionally fall through */
-            case '5': /* intentionally fall through */
-            case '6': /* intentionally fall through */
-            case '7': /* intentionally fall through */
-            case '8': /* intentionally fall through */
-            case '9': {
-                e.super.sig = DIGIT_1_9_SIG;
-                break;
-            }
-            case '.': {
-                e.super.sig = POINT_SIG;
-                break;
-            }
-            case '+': /* intentionally fall through */
-            case '-': /* intentionally fall through */
-            case '*': /* intentionally fall through */
-            case '/': {
-                e.super.sig = OPER_SIG;
-                break;
-            }
-            case '=': /* intentionally fall through */
-            case '\r': { /* Enter key */
-                e.super.sig = EQUALS_SIG;
-                break;
-            }
-            case '\33': { /* ESC key */
-                e.super.sig = OFF_SIG;
-                break;
-            }
-            default: {
-                e.super.sig = 0; /* invalid event */
-                break;
-            }
-        }
+        e.super.sig = keyToSig(e.key_code);
 
         if (e.super.sig != 0) {  /* valid event generated? */
             QHSM_DISPATCH(the_calc, &e.super, 0U); /* dispatch event */
@@ -132,3 +96,91 @@ int main() {
     QF_onCleanup();
     return 0;
 }
+/*..........................................................................*/
+static QSignal keyToSig(uint8_t const key) {
+    QSignal sig;
+    switch (key) {
+        case 'c': /* intentionally fall through */
+        case 'C': {
+            sig = C_SIG;
+            break;
+        }
+        case 'e': /* intentionally fall through */
+        case 'E': {
+            sig = CE_SIG;
+            break;
+        }
+        case '0': {
+            sig = DIGIT_0_SIG;
+            break;
+        }
+        case '1': /* intentionally fall through */
+        case '2': /* intentionally fall through */
+        case '3': /* intentionally fall through */
+        case '4': /* intentionally fall through */
+        case '5': /* intentionally fall through */
+        case '6': /* intentionally fall through */
+        case '7': /* intentionally fall through */
+        case '8': /* intentionally fall through */
+        case '9': {
+            sig = DIGIT_1_9_SIG;
+            break;
+        }
+        case '.': {
+            sig = POINT_SIG;
+            break;
+        }
+        case '+': /* intentionally fall through */
+        case '-': /* intentionally fall through */
+        case '*': /* intentionally fall through */
+        case '/': {
+            sig = OPER_SIG;
+            break;
+        }
+        case '=': /* intentionally fall through */
+        case '\r': { /* Enter key */
+            sig = EQUALS_SIG;
+            break;
+        }
+        case '\33': { /* ESC key */
+            sig = OFF_SIG;
+            break;
+        }
+        default: {
+            sig = 0; /* invalid event */
+            break;
+        }
+    }
+    return sig;
+}
+/*..........................................................................*/
+static void benchmark(uint32_t const loops) {
+    /* usage: calc -b [<loops>] (no output from the calculator) */
+    BSP_setQuiet(1);
+    Calc_ctor(); /* explicitly instantiate the calculator object */
+    QHSM_INIT(the_calc, (void *)0, 0U); /* trigger initial transition */
+
+    clock_t const start = clock();
+    for (uint32_t n = 0U; n < loops; ++n) {
+        for (uint_fast8_t i = 0U; i < (Q_DIM(l_benchKeys) - 1U); ++i) {
+            CalcEvt e;
+            e.key_code = (uint8_t)l_benchKeys[i];
+            e.super.sig = keyToSig(e.key_code);
+            QHSM_DISPATCH(the_calc, &e.super, 0U);
+        }
+    }
+    double const sec = (double)(clock() - start) / (double)CLOCKS_PER_SEC;
+    uint64_t const evts = (uint64_t)loops * (Q_DIM(l_benchKeys) - 1U);
+    BSP_setQuiet(0);
+
+#ifdef QHSM_SIG_MAP
+    PRINTF_S("sigmap=on%s", " ");
+#else
+    PRINTF_S("sigmap=off%s", " ");
+#endif
+    PRINTF_S("evts=%llu sec=%.3f evts/sec=%.0f ",
+             (unsigned long long)evts, sec,
+             (sec > 0.0) ? ((double)evts / sec) : 0.0);
+    BSP_display(); /* the final display must not depend on the map */
+    PRINTF_S("%s", "\n");
+}
@@ -0,0 +1,412 @@
+/*****************************************************************************
+* Product: Deeply nested QHsm test of the transition-path cache
+* Last updated for version 7.1.1
+* Last updated on  2022-10-18
+*
+*                    Q u a n t u m  L e a P s
+*                    ------------------------
+*                    Modern Embedded Software
+*
+* Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <www.gnu.org/licenses/>.
+*
+* Contact information:
+* <www.state-machine.com/licensing>
+* <info@state-machine.com>
+*****************************************************************************/
+#include "qpc.h"
+
+#include "safe_std.h" /* portable "safe" <stdio.h>/<string.h> facilities */
+#include <stdlib.h>   /* for exit() and atoi() */
+#include <string.h>   /* for strcmp() */
+
+Q_DEFINE_THIS_FILE
+
+#ifdef Q_SPY
+    #error The deephsm test does not provide Spy build configuration
+#endif
+
+enum DeepSignals {
+    A_SIG = Q_USER_SIG, /* s7 <-> r7 (siblings 7 levels deep) */
+    B_SIG,              /* s1 -> s1 (exits the whole hierarchy) */
+    C_SIG,              /* s7 -> s5 (superstate, initial tran. to r7) */
+    D_SIG,              /* s3 -> u5, u3 -> s4 (across the branches) */
+    E_SIG,              /* u7 -> u7 (transition to self) */
+    MAX_SIG
+};
+
+/* the Deep state machine, 7 levels of nesting below QHsm_top:
+*
+* top
+*  +-s1
+*     +-s2
+*        +-s3
+*        |  +-s4
+*        |     +-s5
+*        |        +-s6
+*        |           +-s7
+*        |           +-r7
+*        +-u3
+*           +-u4
+*              +-u5
+*                 +-u6
+*                    +-u7
+*/
+typedef struct {
+    QHsm super;
+    char log[512];  /* the actions of the last event */
+    uint_fast16_t len;
+} Deep;
+
+static QState Deep_initial(Deep * const me, void const * const par);
+static QState Deep_s1(Deep * const me, QEvt const * const e);
+static QState Deep_s2(Deep * const me, QEvt const * const e);
+static QState Deep_s3(Deep * const me, QEvt const * const e);
+static QState Deep_s4(Deep * const me, QEvt const * const e);
+static QState Deep_s5(Deep * const me, QEvt const * const e);
+static QState Deep_s6(Deep * const me, QEvt const * const e);
+static QState Deep_s7(Deep * const me, QEvt const * const e);
+static QState Deep_r7(Deep * const me, QEvt const * const e);
+static QState Deep_u3(Deep * const me, QEvt const * const e);
+static QState Deep_u4(Deep * const me, QEvt const * const e);
+static QState Deep_u5(Deep * const me, QEvt const * const e);
+static QState Deep_u6(Deep * const me, QEvt const * const e);
+static QState Deep_u7(Deep * const me, QEvt const * const e);
+
+static Deep l_ref; /* reference instance, dispatched without the cache */
+static Deep l_tst; /* tested instance, dispatched with the cache */
+
+#ifdef QHSM_TRAN_CACHE
+static QHsmTranPath l_tranPathSto[32]; /* must be a power of 2 */
+static QHsmTranCache l_tranCache;
+#endif
+
+/*..........................................................................*/
+static void Deep_log(Deep * const me, char const *msg) {
+    while ((*msg != '\0') && (me->len < (sizeof(me->log) - 1U))) {
+        me->log[me->len] = *msg;
+        ++me->len;
+        ++msg;
+    }
+    me->log[me->len] = '\0';
+}
+/* the entry and exit actions of a state named name_ */
+#define DEEP_ENTRY_EXIT_(name_)            \
+    case Q_ENTRY_SIG: {                    \
+        Deep_log(me, name_ "-ENTRY;");     \
+        status_ = Q_HANDLED();             \
+        break;                             \
+    }                                      \
+    case Q_EXIT_SIG: {                     \
+        Deep_log(me, name_ "-EXIT;");      \
+        status_ = Q_HANDLED();             \
+        break;                             \
+    }
+
+/*..........................................................................*/
+static void Deep_ctor(Deep * const me) {
+    QHsm_ctor(&me->super, Q_STATE_CAST(&Deep_initial));
+    me->len = 0U;
+}
+/*..........................................................................*/
+static QState Deep_initial(Deep * const me, void const * const par) {
+    (void)par; /* unused parameter */
+    Deep_log(me, "top-INIT;");
+    return Q_TRAN(&Deep_s4);
+}
+/*..........................................................................*/
+static QState Deep_s1(Deep * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        DEEP_ENTRY_EXIT_("s1")
+        case Q_INIT_SIG: {
+            Deep_log(me, "s1-INIT;");
+            status_ = Q_TRAN(&Deep_s4);
+            break;
+        }
+        case B_SIG: {
+            Deep_log(me, "s1-B;");
+            status_ = Q_TRAN(&Deep_s1);
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status_;
+}
+/*..........................................................................*/
+static QState Deep_s2(Deep * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        DEEP_ENTRY_EXIT_("s2")
+        default: {
+            status_ = Q_SUPER(&Deep_s1);
+            break;
+        }
+    }
+    return status_;
+}
+/*..........................................................................*/
+static QState Deep_s3(Deep * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        DEEP_ENTRY_EXIT_("s3")
+        case D_SIG: {
+            Deep_log(me, "s3-D;");
+            status_ = Q_TRAN(&Deep_u5);
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&Deep_s2);
+            break;
+        }
+    }
+    return status_;
+}
+/*..........................................................................*/
+static QState Deep_s4(Deep * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        DEEP_ENTRY_EXIT_("s4")
+        case Q_INIT_SIG: {
+            Deep_log(me, "s4-INIT;");
+            status_ = Q_TRAN(&Deep_s7);
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&Deep_s3);
+            break;
+        }
+    }
+    return status_;
+}
+/*..........................................................................*/
+static QState Deep_s5(Deep * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        DEEP_ENTRY_EXIT_("s5")
+        case Q_INIT_SIG: {
+            Deep_log(me, "s5-INIT;");
+            status_ = Q_TRAN(&Deep_r7);
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&Deep_s4);
+            break;
+        }
+    }
+    return status_;
+}
+/*..........................................................................*/
+static QState Deep_s6(Deep * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        DEEP_ENTRY_EXIT_("s6")
+        default: {
+            status_ = Q_SUPER(&Deep_s5);
+            break;
+        }
+    }
+    return status_;
+}
+/*..........................................................................*/
+static QState Deep_s7(Deep * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        DEEP_ENTRY_EXIT_("s7")
+        case A_SIG: {
+            Deep_log(me, "s7-A;");
+            status_ = Q_TRAN(&Deep_r7);
+            break;
+        }
+        case C_SIG: {
+            Deep_log(me, "s7-C;");
+            status_ = Q_TRAN(&Deep_s5);
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&Deep_s6);
+            break;
+        }
+    }
+    return status_;
+}
+/*..........................................................................*/
+static QState Deep_r7(Deep * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        DEEP_ENTRY_EXIT_("r7")
+        case A_SIG: {
+            Deep_log(me, "r7-A;");
+            status_ = Q_TRAN(&Deep_s7);
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&Deep_s6);
+            break;
+        }
+    }
+    return status_;
+}
+/*..........................................................................*/
+static QState Deep_u3(Deep * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        DEEP_ENTRY_EXIT_("u3")
+        case D_SIG: {
+            Deep_log(me, "u3-D;");
+            status_ = Q_TRAN(&Deep_s4);
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&Deep_s2);
+            break;
+        }
+    }
+    return status_;
+}
+/*..........................................................................*/
+static QState Deep_u4(Deep * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        DEEP_ENTRY_EXIT_("u4")
+        default: {
+            status_ = Q_SUPER(&Deep_u3);
+            break;
+        }
+    }
+    return status_;
+}
+/*..........................................................................*/
+static QState Deep_u5(Deep * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        DEEP_ENTRY_EXIT_("u5")
+        case Q_INIT_SIG: {
+            Deep_log(me, "u5-INIT;");
+            status_ = Q_TRAN(&Deep_u7);
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&Deep_u4);
+            break;
+        }
+    }
+    return status_;
+}
+/*..........................................................................*/
+static QState Deep_u6(Deep * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        DEEP_ENTRY_EXIT_("u6")
+        default: {
+            status_ = Q_SUPER(&Deep_u5);
+            break;
+        }
+    }
+    return status_;
+}
+/*..........................................................................*/
+static QState Deep_u7(Deep * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        DEEP_ENTRY_EXIT_("u7")
+        case E_SIG: {
+            Deep_log(me, "u7-E;");
+            status_ = Q_TRAN(&Deep_u7);
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&Deep_u6);
+            break;
+        }
+    }
+    return status_;
+}
+
+/*..........................................................................*/
+int main(int argc, char *argv[]) {
+    /* usage: deephsm [<events>] */
+    uint32_t const nEvts = (argc > 1) ? (uint32_t)atoi(argv[1]) : 100000U;
+    uint32_t nErr = 0U;
+
+    Deep_ctor(&l_ref);
+    Deep_ctor(&l_tst);
+#ifdef QHSM_TRAN_CACHE
+    QHsmTranCache_init(&l_tranCache, l_tranPathSto, Q_DIM(l_tranPathSto));
+    QHsm_setTranCache(&l_tst.super, &l_tranCache);
+#endif
+
+    /* the initial transition drills down 7 levels (s4 -> s7) */
+    QHSM_INIT(&l_ref.super, (void *)0, 0U);
+    QHSM_INIT(&l_tst.super, (void *)0, 0U);
+    if (strcmp(l_ref.log, l_tst.log) != 0) {
+        ++nErr;
+    }
+
+    /* random events, the same exit/entry/init actions with the cache */
+    uint32_t rnd = 12345U;
+    for (uint32_t n = 0U; n < nEvts; ++n) {
+        rnd = (rnd * 1103515245U) + 12345U; /* linear congruential gen. */
+        QEvt e;
+        e.sig = (QSignal)(A_SIG + ((rnd >> 16) % (MAX_SIG - A_SIG)));
+
+        l_ref.len = 0U;
+        l_tst.len = 0U;
+        QHSM_DISPATCH(&l_ref.super, &e, 0U);
+        QHSM_DISPATCH(&l_tst.super, &e, 0U);
+        if ((strcmp(l_ref.log, l_tst.log) != 0)
+            || (l_ref.super.state.fun != l_tst.super.state.fun))
+        {
+            if (nErr == 0U) { /* report the first difference */
+                PRINTF_S("event %u: %c\n  ref: %s\n  tst: %s\n",
+                         (unsigned)n, 'A' + (e.sig - A_SIG),
+                         l_ref.log, l_tst.log);
+            }
+            ++nErr;
+        }
+    }
+
+#ifdef QHSM_TRAN_CACHE
+    PRINTF_S("cache=on misses=%u ", (unsigned)l_tranCache.nMiss);
+#else
+    PRINTF_S("cache=off%s", " ");
+#endif
+    PRINTF_S("evts=%u err=%u %s\n", (unsigned)nEvts, (unsigned)nErr,
+             (nErr == 0U) ? "PASS" : "FAIL");
+
+    return (nErr == 0U) ? 0 : 1;
+}
+/*..........................................................................*/
+Q_NORETURN Q_onAssert(char const * const module, int_t const loc) {
+    FPRINTF_S(stderr, "Assertion failed in %s:%d\n", module, loc);
+    exit(-1);
+}
+/*..........................................................................*/
+void QF_onStartup(void) {
+}
+/*..........................................................................*/
+void QF_onCleanup(void) {
+}
+/*..........................................................................*/
+void QF_onClockTick(void) {
+}
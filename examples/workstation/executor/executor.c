@@ -0,0 +1,235 @@
+/*****************************************************************************
+* Product: Executor benchmark for the POSIX-WS port (M:N work-stealing)
+* Last updated for version 7.1.1
+* Last updated on  2022-10-18
+*
+*                    Q u a n t u m  L e a P s
+*                    ------------------------
+*                    Modern Embedded Software
+*
+* Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <www.gnu.org/licenses/>.
+*
+* Contact information:
+* <www.state-machine.com/licensing>
+* <info@state-machine.com>
+*****************************************************************************/
+#define _POSIX_C_SOURCE 200809L /* for clock_gettime() */
+
+#include "qpc.h"
+
+#include "safe_std.h" /* portable "safe" <stdio.h>/<string.h> facilities */
+#include <stdlib.h>   /* for exit() and atoi() */
+#include <time.h>     /* for clock_gettime() */
+
+Q_DEFINE_THIS_FILE
+
+#ifdef Q_SPY
+    #error The executor benchmark does not provide Spy build configuration
+#endif
+
+enum ExecutorSignals {
+    TOKEN_SIG = Q_USER_SIG,
+    MAX_SIG
+};
+
+enum {
+    BSP_TICKS_PER_SEC = 100,
+    MAX_CELLS   = QF_MAX_ACTIVE - 1U, /* cells in the ring */
+    MAX_TOKENS  = 256, /* tokens circulating in the ring */
+    DRAIN_TICKS = 10   /* ticks to drain the tokens before stopping */
+};
+
+/* Cell active objects =====================================================*/
+typedef struct {
+    QActive super;           /* inherits QActive */
+
+    QActive *next;           /* the next cell in the ring */
+    uint32_t volatile nEvts; /* number of tokens received */
+    uint8_t busy;            /* executing an RTC step (sanity check) */
+} Cell;
+
+static QState Cell_initial(Cell * const me, void const * const par);
+static QState Cell_active (Cell * const me, QEvt const * const e);
+
+static Cell l_cell[MAX_CELLS];
+static bool volatile l_done; /* stop forwarding the tokens */
+static uint32_t l_work = 0U; /* busy-loop iterations per token */
+
+/*..........................................................................*/
+static void Cell_ctor(Cell * const me, QActive * const next) {
+    QActive_ctor(&me->super, Q_STATE_CAST(&Cell_initial));
+    me->next  = next;
+    me->nEvts = 0U;
+    me->busy  = 0U;
+}
+/*..........................................................................*/
+static QState Cell_initial(Cell * const me, void const * const par) {
+    (void)me;  /* unused parameter */
+    (void)par; /* unused parameter */
+    return Q_TRAN(&Cell_active);
+}
+/*..........................................................................*/
+static QState Cell_active(Cell * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case TOKEN_SIG: {
+            /* the executor must never run this AO on two threads at once */
+            Q_ASSERT(__atomic_exchange_n(&me->busy, 1U, __ATOMIC_ACQUIRE)
+                     == 0U);
+
+            ++me->nEvts;
+            for (uint32_t volatile i = 0U; i < l_work; ++i) {
+                /* simulated processing of the token */
+            }
+            if (!l_done) { /* still measuring? */
+                /* pass a new token to the next cell in the ring */
+                QEvt *pe = Q_NEW(QEvt, TOKEN_SIG);
+                QACTIVE_POST_MOVE(me->next, pe, me);
+            }
+
+            __atomic_store_n(&me->busy, 0U, __ATOMIC_RELEASE);
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status_;
+}
+
+/* measurement =============================================================*/
+static uint_fast16_t l_nWorkers = 4U;
+static uint_fast16_t l_nCells = (MAX_CELLS < 1000U) ? MAX_CELLS : 1000U;
+static uint_fast16_t l_nTokens = 64U;
+static uint32_t l_nTicks = 2U * BSP_TICKS_PER_SEC;
+static struct timespec l_start;
+
+/*..........................................................................*/
+static void report(void) {
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    uint64_t evts = 0U;
+    for (uint_fast16_t n = 0U; n < l_nCells; ++n) {
+        evts += l_cell[n].nEvts;
+    }
+    uint64_t steals = 0U;
+    uint64_t parks  = 0U;
+    for (uint_fast16_t n = 0U; n < l_nWorkers; ++n) {
+        QF_WorkerStats stats;
+        QF_getWorkerStats(n, &stats);
+        steals += stats.nSteals;
+        parks  += stats.nParks;
+    }
+    double const sec = (double)(end.tv_sec - l_start.tv_sec)
+                       + ((double)(end.tv_nsec - l_start.tv_nsec) * 1e-9);
+    PRINTF_S("workers=%u cells=%u tokens=%u evts=%llu sec=%.3f "
+             "evts/sec=%.0f steals=%llu parks=%llu\n",
+             (unsigned)l_nWorkers, (unsigned)l_nCells, (unsigned)l_nTokens,
+             (unsigned long long)evts, sec, (double)evts / sec,
+             (unsigned long long)steals, (unsigned long long)parks);
+}
+
+/* QF callbacks ============================================================*/
+void Q_onAssert(char const * const module, int loc) {
+    FPRINTF_S(stderr, "Assertion failed in %s:%d\n", module, loc);
+    exit(-1);
+}
+/*..........................................................................*/
+void QF_onStartup(void) {
+    QF_setTickRate(BSP_TICKS_PER_SEC, 50);
+    clock_gettime(CLOCK_MONOTONIC, &l_start);
+}
+/*..........................................................................*/
+void QF_onCleanup(void) {
+}
+/*..........................................................................*/
+void QF_onClockTick(void) {
+    static uint32_t ctr;
+    ++ctr;
+    if (ctr == l_nTicks) { /* measurement time elapsed? */
+        l_done = true; /* let the cells drain the tokens in flight */
+        report();
+    }
+    else if (ctr == l_nTicks + DRAIN_TICKS) {
+        QF_stop();
+    }
+    else {
+        /* keep measuring */
+    }
+}
+
+/*..........................................................................*/
+int main(int argc, char *argv[]) {
+    static QEvt const *queueSto[MAX_CELLS][MAX_TOKENS];
+    /* every worker can hold one more token while forwarding the current one */
+    static QF_MPOOL_EL(QEvt) poolSto[MAX_TOKENS + QF_WS_MAX_WORKERS];
+
+    /* usage: executor [<workers> [<cells> [<tokens> [<seconds> [<work>]]]]] */
+    if (argc > 1) {
+        int const n = atoi(argv[1]);
+        Q_REQUIRE((0 < n) && (n <= (int)QF_WS_MAX_WORKERS));
+        l_nWorkers = (uint_fast16_t)n;
+    }
+    if (argc > 2) {
+        int const n = atoi(argv[2]);
+        Q_REQUIRE((1 < n) && (n <= MAX_CELLS));
+        l_nCells = (uint_fast16_t)n;
+    }
+    if (argc > 3) {
+        int const n = atoi(argv[3]);
+        Q_REQUIRE((0 < n) && (n <= MAX_TOKENS));
+        l_nTokens = (uint_fast16_t)n;
+    }
+    if (argc > 4) {
+        int const sec = atoi(argv[4]);
+        Q_REQUIRE(sec > 0);
+        l_nTicks = (uint32_t)sec * BSP_TICKS_PER_SEC;
+    }
+    if (argc > 5) {
+        l_work = (uint32_t)atoi(argv[5]);
+    }
+    Q_REQUIRE(l_nCells <= MAX_CELLS);
+
+    QF_init(); /* initialize the framework */
+    QF_setWorkers(l_nWorkers);
+    QF_poolInit(poolSto, sizeof(poolSto), sizeof(poolSto[0]));
+
+    for (uint_fast16_t n = 0U; n < l_nCells; ++n) {
+        Cell_ctor(&l_cell[n], &l_cell[(n + 1U) % l_nCells].super);
+        QACTIVE_START(&l_cell[n].super,
+                      n + 1U, /* QP priority (only identifies the AO) */
+                      queueSto[n], l_nTokens,
+                      (void *)0, 0U, /* no stack */
+                      (void *)0);    /* no initialization parameter */
+    }
+
+    /* spread the tokens evenly around the ring */
+    for (uint_fast16_t n = 0U; n < l_nTokens; ++n) {
+        QEvt *pe = Q_NEW(QEvt, TOKEN_SIG);
+        QACTIVE_POST_MOVE(&l_cell[(n * l_nCells) / l_nTokens].super,
+                          pe, (void *)0);
+    }
+
+    return QF_run(); /* run the QF application */
+}
@@ -0,0 +1,496 @@
+/*****************************************************************************
+* Product: QHsmFarm benchmark (many small state machines of one class)
+* Last updated for version 7.1.1
+* Last updated on  2022-10-18
+*
+*                    Q u a n t u m  L e a P s
+*                    ------------------------
+*                    Modern Embedded Software
+*
+* Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <www.gnu.org/licenses/>.
+*
+* Contact information:
+* <www.state-machine.com/licensing>
+* <info@state-machine.com>
+*****************************************************************************/
+#define _POSIX_C_SOURCE 200809L /* for clock_gettime() */
+
+#include "qpc.h"
+
+#include "safe_std.h" /* portable "safe" <stdio.h>/<string.h> facilities */
+#include <stdlib.h>   /* for exit() and atoi() */
+#include <time.h>     /* for clock_gettime() */
+
+Q_DEFINE_THIS_FILE
+
+#ifdef Q_SPY
+    #error The farm benchmark does not provide Spy build configuration
+#endif
+
+enum FarmSignals {
+    TICK_SIG = Q_USER_SIG, /* periodic tick (broadcast to all sessions) */
+    OPEN_SIG,  /* request to open the session */
+    DATA_SIG,  /* data for the session */
+    CLOSE_SIG, /* request to close the session */
+    MAX_SIG
+};
+
+enum {
+    MAX_SESSIONS = 50000 /* capacity of the session arrays */
+};
+
+/* Session state machine ===================================================*/
+/*
+* session
+* +- idle        --OPEN-->  connecting
+* +- connecting  --TICK [timer expired]--> established
+* +- established --TICK [timer expired]--> closing
+* |  +- ready    --DATA-->  busy
+* |  +- busy     --TICK-->  ready
+* +- closing     --TICK-->  idle
+*
+* CLOSE in the "session" superstate --> closing
+*/
+typedef struct {
+    QHsm super;      /* inherits QHsm */
+
+    uint16_t id;     /* the index of the session */
+    uint16_t timer;  /* ticks to the timeout in the current state */
+    uint32_t nData;  /* number of data events received */
+    uint32_t nOpen;  /* number of times the session was opened */
+} Session;
+
+static QState Session_initial    (Session * const me, void const * const par);
+static QState Session_session    (Session * const me, QEvt const * const e);
+static QState Session_idle       (Session * const me, QEvt const * const e);
+static QState Session_connecting (Session * const me, QEvt const * const e);
+static QState Session_established(Session * const me, QEvt const * const e);
+static QState Session_ready      (Session * const me, QEvt const * const e);
+static QState Session_busy       (Session * const me, QEvt const * const e);
+static QState Session_closing    (Session * const me, QEvt const * const e);
+
+static QEvt const l_tickEvt  = { TICK_SIG,  0U, 0U };
+static QEvt const l_openEvt  = { OPEN_SIG,  0U, 0U };
+static QEvt const l_dataEvt  = { DATA_SIG,  0U, 0U };
+static QEvt const l_closeEvt = { CLOSE_SIG, 0U, 0U };
+
+/*..........................................................................*/
+static void Session_ctor(Session * const me, uint16_t const id) {
+    QHsm_ctor(&me->super, Q_STATE_CAST(&Session_initial));
+    me->id    = id;
+    me->timer = 0U;
+    me->nData = 0U;
+    me->nOpen = 0U;
+}
+/*..........................................................................*/
+static QState Session_initial(Session * const me, void const * const par) {
+    (void)par; /* unused parameter */
+    return Q_TRAN(&Session_idle);
+}
+/*..........................................................................*/
+static QState Session_session(Session * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case CLOSE_SIG: {
+            status_ = Q_TRAN(&Session_closing);
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status_;
+}
+/*..........................................................................*/
+static QState Session_idle(Session * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case OPEN_SIG: {
+            ++me->nOpen;
+            status_ = Q_TRAN(&Session_connecting);
+            break;
+        }
+        case CLOSE_SIG: { /* already closed */
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&Session_session);
+            break;
+        }
+    }
+    return status_;
+}
+/*..........................................................................*/
+static QState Session_connecting(Session * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case Q_ENTRY_SIG: {
+            me->timer = (uint16_t)(1U + (me->id % 3U));
+            status_ = Q_HANDLED();
+            break;
+        }
+        case TICK_SIG: {
+            --me->timer;
+            if (me->timer == 0U) {
+                status_ = Q_TRAN(&Session_established);
+            }
+            else {
+                status_ = Q_HANDLED();
+            }
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&Session_session);
+            break;
+        }
+    }
+    return status_;
+}
+/*..........................................................................*/
+static QState Session_established(Session * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case Q_ENTRY_SIG: {
+            me->timer = (uint16_t)(4U + (me->id % 8U));
+            status_ = Q_HANDLED();
+            break;
+        }
+        case Q_INIT_SIG: {
+            status_ = Q_TRAN(&Session_ready);
+            break;
+        }
+        case TICK_SIG: {
+            --me->timer;
+            if (me->timer == 0U) { /* idle timeout? */
+                status_ = Q_TRAN(&Session_closing);
+            }
+            else {
+                status_ = Q_HANDLED();
+            }
+            break;
+        }
+        case DATA_SIG: {
+            ++me->nData;
+            me->timer = (uint16_t)(4U + (me->id % 8U));
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&Session_session);
+            break;
+        }
+    }
+    return status_;
+}
+/*..........................................................................*/
+static QState Session_ready(Session * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case DATA_SIG: {
+            ++me->nData;
+            me->timer = (uint16_t)(4U + (me->id % 8U));
+            status_ = Q_TRAN(&Session_busy);
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&Session_established);
+            break;
+        }
+    }
+    return status_;
+}
+/*..........................................................................*/
+static QState Session_busy(Session * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case TICK_SIG: {
+            status_ = Q_TRAN(&Session_ready);
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&Session_established);
+            break;
+        }
+    }
+    return status_;
+}
+/*..........................................................................*/
+static QState Session_closing(Session * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case TICK_SIG: {
+            status_ = Q_TRAN(&Session_idle);
+            break;
+        }
+        case CLOSE_SIG: { /* already closing */
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&Session_session);
+            break;
+        }
+    }
+    return status_;
+}
+
+#ifdef QHSM_SIG_MAP
+/* signals handled by the states of Session (see QHsmSigMap) */
+static QSignal const l_sessionSigs[]     = { CLOSE_SIG, 0U };
+static QSignal const l_idleSigs[]        = { OPEN_SIG, CLOSE_SIG, 0U };
+static QSignal const l_connectingSigs[]  = { TICK_SIG, 0U };
+static QSignal const l_establishedSigs[] = { TICK_SIG, DATA_SIG, 0U };
+static QSignal const l_readySigs[]       = { DATA_SIG, 0U };
+static QSignal const l_busySigs[]        = { TICK_SIG, 0U };
+static QSignal const l_closingSigs[]     = { TICK_SIG, CLOSE_SIG, 0U };
+
+static QHsmStateSigs const l_stateSigs[] = {
+    { Q_STATE_CAST(&Session_session),     l_sessionSigs     },
+    { Q_STATE_CAST(&Session_idle),        l_idleSigs        },
+    { Q_STATE_CAST(&Session_connecting),  l_connectingSigs  },
+    { Q_STATE_CAST(&Session_established), l_establishedSigs },
+    { Q_STATE_CAST(&Session_ready),       l_readySigs       },
+    { Q_STATE_CAST(&Session_busy),        l_busySigs        },
+    { Q_STATE_CAST(&Session_closing),     l_closingSigs     }
+};
+static uint8_t l_route[Q_DIM(l_stateSigs)][MAX_SIG - Q_USER_SIG];
+static QHsmSigMap l_sigMap; /* shared by all the sessions */
+#endif /* QHSM_SIG_MAP */
+
+/* benchmark ===============================================================*/
+static Session l_loop[MAX_SESSIONS]; /* sessions dispatched one by one */
+static Session l_sessions[MAX_SESSIONS]; /* sessions in the farm */
+static uint8_t l_sessionGrps[MAX_SESSIONS];
+static uint16_t l_sessionOrder[MAX_SESSIONS];
+static QHsmFarm l_farm;
+
+static uint16_t l_set[MAX_SESSIONS]; /* the subset of the sessions */
+static uint_fast16_t l_nSessions = 10000U;
+static uint_fast32_t l_nRounds = 100U;
+
+/*..........................................................................*/
+/* deterministic subset of the sessions receiving @p sig in the round @p r */
+static uint_fast16_t makeSet(enum FarmSignals const sig,
+                             uint_fast32_t const r)
+{
+    uint_fast16_t n = 0U;
+    for (uint_fast16_t i = 0U; i < l_nSessions; ++i) {
+        uint32_t h = ((uint32_t)i * 2654435761U) ^ ((uint32_t)r * 40503U);
+        h ^= (h >> 15);
+        bool in;
+        switch (sig) {
+            case OPEN_SIG:  in = ((h % 4U)  == 0U); break;
+            case DATA_SIG:  in = ((h % 3U)  == 0U); break;
+            case CLOSE_SIG: in = ((h % 61U) == 0U); break;
+            default:        in = false;             break;
+        }
+        if (in) {
+            l_set[n] = (uint16_t)i;
+            ++n;
+        }
+    }
+    return n;
+}
+/*..........................................................................*/
+static double elapsed(struct timespec const * const start) {
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (double)(end.tv_sec - start->tv_sec)
+           + ((double)(end.tv_nsec - start->tv_nsec) * 1e-9);
+}
+/*..........................................................................*/
+/* dispatches @p e to the sessions in l_set[] (or all for @p nSet == 0) */
+static double dispatch(bool const farm, QEvt const * const e,
+                       uint_fast16_t const nSet)
+{
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (farm) {
+        if (nSet == 0U) {
+            QHsmFarm_broadcast(&l_farm, e, 0U);
+        }
+        else {
+            QHsmFarm_dispatchSet(&l_farm, e, l_set, nSet, 0U);
+        }
+    }
+    else {
+        if (nSet == 0U) {
+            for (uint_fast16_t i = 0U; i < l_nSessions; ++i) {
+                QHSM_DISPATCH(&l_loop[i].super, e, 0U);
+            }
+        }
+        else {
+            for (uint_fast16_t j = 0U; j < nSet; ++j) {
+                QHSM_DISPATCH(&l_loop[l_set[j]].super, e, 0U);
+            }
+        }
+    }
+    return elapsed(&start);
+}
+/*..........................................................................*/
+/* runs all the rounds of events: broadcast TICK, then OPEN, DATA and CLOSE
+* to the subsets of the sessions (only the dispatching is measured)
+*/
+static void run(bool const farm) {
+    static QEvt const * const evts[] = {
+        &l_openEvt, &l_dataEvt, &l_closeEvt
+    };
+    uint_fast64_t nEvts = 0U;
+    double sec = 0.0;
+
+    for (uint_fast32_t r = 0U; r < l_nRounds; ++r) {
+        sec += dispatch(farm, &l_tickEvt, 0U);
+        nEvts += l_nSessions;
+        for (uint_fast8_t k = 0U; k < Q_DIM(evts); ++k) {
+            uint_fast16_t const nSet =
+                makeSet((enum FarmSignals)evts[k]->sig, r);
+            if (nSet != 0U) {
+                sec += dispatch(farm, evts[k], nSet);
+                nEvts += nSet;
+            }
+        }
+    }
+#ifdef QHSM_SIG_MAP
+    char const * const sigmap = " sigmap=on";
+#else
+    char const * const sigmap = "";
+#endif
+    PRINTF_S("farm=%s%s sessions=%u rounds=%u evts=%llu sec=%.3f "
+             "evts/sec=%.0f\n",
+             farm ? "on" : "off", sigmap,
+             (unsigned)l_nSessions, (unsigned)l_nRounds,
+             (unsigned long long)nEvts, sec, (double)nEvts / sec);
+}
+
+/* QF callbacks ============================================================*/
+void Q_onAssert(char const * const module, int loc) {
+    FPRINTF_S(stderr, "Assertion failed in %s:%d\n", module, loc);
+    exit(-1);
+}
+/*..........................................................................*/
+void QF_onStartup(void) {
+}
+/*..........................................................................*/
+void QF_onCleanup(void) {
+}
+/*..........................................................................*/
+void QF_onClockTick(void) {
+}
+
+/*..........................................................................*/
+int main(int argc, char *argv[]) {
+    /* usage: farm [<sessions> [<rounds>]] */
+    if (argc > 1) {
+        int const n = atoi(argv[1]);
+        Q_REQUIRE((0 < n) && (n <= MAX_SESSIONS));
+        l_nSessions = (uint_fast16_t)n;
+    }
+    if (argc > 2) {
+        int const n = atoi(argv[2]);
+        Q_REQUIRE(0 < n);
+        l_nRounds = (uint_fast32_t)n;
+    }
+
+#ifdef QHSM_SIG_MAP
+    QHsmSigMap_init(&l_sigMap, l_stateSigs, Q_DIM(l_stateSigs),
+                    &l_route[0][0], MAX_SIG - Q_USER_SIG);
+#endif
+    for (uint_fast16_t i = 0U; i < l_nSessions; ++i) {
+        Session_ctor(&l_loop[i], (uint16_t)i);
+        Session_ctor(&l_sessions[i], (uint16_t)i);
+#ifdef QHSM_SIG_MAP
+        /* the same signal map for the sessions dispatched both ways */
+        QHsm_setSigMap(&l_loop[i].super, &l_sigMap);
+        QHsm_setSigMap(&l_sessions[i].super, &l_sigMap);
+#endif
+        QHSM_INIT(&l_loop[i].super, (void *)0, 0U);
+    }
+    QHsmFarm_ctor(&l_farm, l_sessions, sizeof(Session), l_nSessions,
+                  l_sessionGrps, l_sessionOrder);
+    QHsmFarm_init(&l_farm, (void *)0, 0U);
+
+    run(false); /* dispatch to the sessions one by one */
+    run(true);  /* dispatch to the sessions in the farm */
+
+    /* both runs must leave the sessions in exactly the same condition */
+    uint_fast16_t nBad = 0U;
+    uint_fast16_t nEstablished = 0U;
+    for (uint_fast16_t i = 0U; i < l_nSessions; ++i) {
+        Session const * const a = &l_loop[i];
+        Session const * const b =
+            (Session const *)QHsmFarm_inst(&l_farm, i);
+        if ((a->super.state.fun != QHsmFarm_state(&l_farm, i))
+            || (b->super.state.fun != QHsmFarm_state(&l_farm, i))
+            || (a->timer != b->timer)
+            || (a->nData != b->nData)
+            || (a->nOpen != b->nOpen))
+        {
+            ++nBad;
+        }
+        if (QHsm_isIn((QHsm *)&l_sessions[i].super,
+                      Q_STATE_CAST(&Session_established)))
+        {
+            ++nEstablished;
+        }
+    }
+    /* the groups of the farm must match the current states of the sessions
+    * and every group must be counted exactly and reclaimed when empty
+    */
+    uint_fast16_t grpCnt[QHSM_FARM_STATES];
+    for (uint_fast16_t g = 0U; g < QHSM_FARM_STATES; ++g) {
+        grpCnt[g] = 0U;
+    }
+    for (uint_fast16_t i = 0U; i < l_nSessions; ++i) {
+        uint_fast8_t const g = l_farm.grp[i];
+        ++grpCnt[g];
+        if ((g < QHSM_FARM_STATES - 1U)
+            && (l_farm.grpState[g] != QHsmFarm_state(&l_farm, i)))
+        {
+            ++nBad;
+        }
+    }
+    uint_fast8_t nGrp = 0U;
+    for (uint_fast16_t g = 0U; g < QHSM_FARM_STATES; ++g) {
+        if (grpCnt[g] != l_farm.grpCnt[g]) {
+            ++nBad;
+        }
+        if (g < QHSM_FARM_STATES - 1U) {
+            if ((grpCnt[g] == 0U)
+                != (l_farm.grpState[g] == Q_STATE_CAST(0)))
+            {
+                ++nBad;
+            }
+            if (grpCnt[g] != 0U) {
+                ++nGrp;
+            }
+        }
+    }
+    if (nGrp != l_farm.nGrp) {
+        ++nBad;
+    }
+
+    PRINTF_S("established=%u check=%s\n",
+             (unsigned)nEstablished, (nBad == 0U) ? "ok" : "FAILED");
+
+    return (nBad == 0U) ? 0 : -1;
+}
@@ -0,0 +1,233 @@
+/*****************************************************************************
+* Product: Multithreaded stress test of the QMPool memory pool
+* Last updated for version 7.1.1
+* Last updated on  2022-10-18
+*
+*                    Q u a n t u m  L e a P s
+*                    ------------------------
+*                    Modern Embedded Software
+*
+* Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <www.gnu.org/licenses/>.
+*
+* Contact information:
+* <www.state-machine.com/licensing>
+* <info@state-machine.com>
+*****************************************************************************/
+#define _POSIX_C_SOURCE 200809L /* for rand_r() */
+
+#include "qpc.h"
+
+#include "safe_std.h" /* portable "safe" <stdio.h>/<string.h> facilities */
+#include <stdlib.h>   /* for exit() and atoi() */
+#include <string.h>   /* for memset() */
+#include <pthread.h>  /* POSIX-thread API */
+
+Q_DEFINE_THIS_FILE
+
+#ifdef Q_SPY
+    #error The mpool stress test does not provide Spy build configuration
+#endif
+
+enum {
+    MAX_THREADS = 16,  /* maximum number of the stressing threads */
+    N_BLOCKS    = 64,  /* blocks in the pool (fewer than all threads hold) */
+    BLOCK_SIZE  = 32,  /* size of a block [bytes] */
+    MAX_HELD    = 16,  /* maximum number of blocks held by one thread */
+    MAX_BATCH   = 4    /* maximum number of blocks in QMPool_getBatch_() */
+};
+
+static QF_MPOOL_EL(uint8_t[BLOCK_SIZE]) l_poolSto[N_BLOCKS];
+static QMPool l_pool;
+
+static uint_fast8_t l_nThreads = 6U;
+static uint32_t     l_nIter    = 2000000U; /* iterations per thread */
+
+/* the owner thread (1-based) of every block or 0 if the block is free */
+static uint8_t l_owner[N_BLOCKS];
+static uint32_t l_nErr;  /* blocks owned twice or released by a non-owner */
+static uint32_t l_nNull; /* QMPool_get() that returned NULL */
+
+/*..........................................................................*/
+static uint_fast16_t blockIdx(void const * const b) {
+    uint_fast16_t const idx = (uint_fast16_t)
+        (((uint8_t const *)b - (uint8_t const *)&l_poolSto[0])
+         / l_pool.blockSize);
+    Q_ASSERT(idx < N_BLOCKS); /* the block must come from the pool */
+    return idx;
+}
+/*..........................................................................*/
+static void acquire(void * const b, uint8_t const me) {
+    if (__atomic_exchange_n(&l_owner[blockIdx(b)], me, __ATOMIC_SEQ_CST)
+        != 0U)
+    {
+        (void)__atomic_add_fetch(&l_nErr, 1U, __ATOMIC_RELAXED);
+    }
+    memset(b, 0xA5, BLOCK_SIZE); /* overwrite the link of the free list */
+}
+/*..........................................................................*/
+static void release(void * const b, uint8_t const me) {
+    if (__atomic_exchange_n(&l_owner[blockIdx(b)], 0U, __ATOMIC_SEQ_CST)
+        != me)
+    {
+        (void)__atomic_add_fetch(&l_nErr, 1U, __ATOMIC_RELAXED);
+    }
+}
+/*..........................................................................*/
+/* thread taking and returning the blocks in a random order, which mixes
+* QMPool_get() (with and without margin), QMPool_put() and the batched
+* QMPool_getBatch_()/QMPool_putBatch_()
+*/
+static void *stressThread(void *arg) {
+    uint8_t const me = (uint8_t)((uintptr_t)arg + 1U);
+    unsigned seed = (unsigned)me * 7919U;
+    void *held[MAX_HELD];
+    uint_fast16_t nHeld = 0U;
+
+    for (uint32_t i = 0U; i < l_nIter; ++i) {
+        unsigned const r = (unsigned)rand_r(&seed);
+        if (((r & 1U) != 0U) && (nHeld < MAX_HELD)) { /* take? */
+            if ((r & 6U) == 0U) { /* batch? */
+                void *batch[MAX_BATCH];
+                uint_fast16_t n = MAX_HELD - nHeld;
+                if (n > MAX_BATCH) {
+                    n = MAX_BATCH;
+                }
+                n = QMPool_getBatch_(&l_pool, &batch[0], n, 0U);
+                for (uint_fast16_t k = 0U; k < n; ++k) {
+                    acquire(batch[k], me);
+                    held[nHeld] = batch[k];
+                    ++nHeld;
+                }
+            }
+            else {
+                uint_fast16_t const margin = ((r & 8U) != 0U) ? 3U : 0U;
+                void * const b = QMPool_get(&l_pool, margin, 0U);
+                if (b != (void *)0) {
+                    acquire(b, me);
+                    held[nHeld] = b;
+                    ++nHeld;
+                }
+                else { /* the margin is not available */
+                    (void)__atomic_add_fetch(&l_nNull, 1U,
+                                             __ATOMIC_RELAXED);
+                }
+            }
+        }
+        else if (nHeld >= 2U) { /* return? */
+            if ((r & 6U) == 0U) { /* batch? */
+                nHeld -= 2U;
+                release(held[nHeld], me);
+                release(held[nHeld + 1U], me);
+                QMPool_putBatch_(&l_pool, &held[nHeld], 2U, 0U);
+            }
+            else {
+                --nHeld;
+                release(held[nHeld], me);
+                QMPool_put(&l_pool, held[nHeld], 0U);
+            }
+        }
+        else if (nHeld == 1U) {
+            nHeld = 0U;
+            release(held[0], me);
+            QMPool_put(&l_pool, held[0], 0U);
+        }
+        else {
+            /* nothing to return */
+        }
+    }
+    while (nHeld > 0U) { /* return all the blocks still held */
+        --nHeld;
+        release(held[nHeld], me);
+        QMPool_put(&l_pool, held[nHeld], 0U);
+    }
+    return (void *)0;
+}
+
+/* QF callbacks ============================================================*/
+void Q_onAssert(char const * const module, int loc) {
+    FPRINTF_S(stderr, "Assertion failed in %s:%d\n", module, loc);
+    exit(-1);
+}
+/*..........................................................................*/
+void QF_onStartup(void) {
+}
+/*..........................................................................*/
+void QF_onCleanup(void) {
+}
+/*..........................................................................*/
+void QF_onClockTick(void) {
+}
+
+/*..........................................................................*/
+int main(int argc, char *argv[]) {
+    pthread_t thread[MAX_THREADS];
+
+    /* usage: mpool [<threads> [<iterations per thread>]] */
+    if (argc > 1) {
+        int const n = atoi(argv[1]);
+        Q_REQUIRE((0 < n) && (n <= MAX_THREADS));
+        l_nThreads = (uint_fast8_t)n;
+    }
+    if (argc > 2) {
+        int const n = atoi(argv[2]);
+        Q_REQUIRE(n > 0);
+        l_nIter = (uint32_t)n;
+    }
+
+    QF_init(); /* initialize the framework (and its critical sections) */
+    QMPool_init(&l_pool, l_poolSto, sizeof(l_poolSto), BLOCK_SIZE);
+
+    for (uint_fast8_t n = 0U; n < l_nThreads; ++n) {
+        Q_ALLEGE(pthread_create(&thread[n], (pthread_attr_t *)0,
+                                &stressThread, (void *)(uintptr_t)n) == 0);
+    }
+    for (uint_fast8_t n = 0U; n < l_nThreads; ++n) {
+        Q_ALLEGE(pthread_join(thread[n], (void **)0) == 0);
+    }
+
+    /* all the blocks must be back in the pool exactly once */
+    uint_fast16_t const nFree = (uint_fast16_t)l_pool.nFree;
+    uint_fast16_t nDrained = 0U;
+    for (void *b = QMPool_get(&l_pool, 0U, 0U);
+         b != (void *)0;
+         b = QMPool_get(&l_pool, 0U, 0U))
+    {
+        acquire(b, 1U);
+        ++nDrained;
+    }
+
+#ifdef QF_MPOOL_LOCKFREE
+    char const * const pool = "lockfree";
+#elif (defined QF_OBJ_CRIT)
+    char const * const pool = "obj";
+#else
+    char const * const pool = "global";
+#endif
+    bool const ok = (nFree == N_BLOCKS) && (nDrained == N_BLOCKS)
+                    && (l_nErr == 0U);
+    PRINTF_S("pool=%s threads=%u iter=%u nFree=%u drained=%u nMin=%u "
+             "null=%u err=%u %s\n",
+             pool, (unsigned)l_nThreads, (unsigned)l_nIter,
+             (unsigned)nFree, (unsigned)nDrained, (unsigned)l_pool.nMin,
+             (unsigned)l_nNull, (unsigned)l_nErr, ok ? "PASS" : "FAIL");
+
+    return ok ? 0 : 1;
+}
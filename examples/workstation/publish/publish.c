@@ -0,0 +1,301 @@
+/*****************************************************************************
+* Product: Publish latency benchmark for the POSIX port
+* Last updated for version 7.1.1
+* Last updated on  2022-10-18
+*
+*                    Q u a n t u m  L e a P s
+*                    ------------------------
+*                    Modern Embedded Software
+*
+* Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <www.gnu.org/licenses/>.
+*
+* Contact information:
+* <www.state-machine.com/licensing>
+* <info@state-machine.com>
+*****************************************************************************/
+#define _POSIX_C_SOURCE 200809L /* for clock_gettime() */
+
+#include "qpc.h"
+
+#include "safe_std.h" /* portable "safe" <stdio.h>/<string.h> facilities */
+#include <stdlib.h>   /* for exit() and atoi() */
+#include <time.h>     /* for clock_gettime() */
+#include <sched.h>    /* for sched_get_priority_max() and sched_yield() */
+
+Q_DEFINE_THIS_FILE
+
+#ifdef Q_SPY
+    #error The publish benchmark does not provide Spy build configuration
+#endif
+
+enum PublishSignals {
+    MARKET_SIG = Q_USER_SIG, /* published to all subscribers */
+    MAX_PUB_SIG,  /* the last published signal */
+
+    PUB_SIG,      /* self-posted by the publisher to publish again */
+    MAX_SIG
+};
+
+enum {
+    BSP_TICKS_PER_SEC = 100,
+    MAX_SUBS    = QF_MAX_ACTIVE - 1U, /* subscribers (+1 publisher) */
+    WINDOW      = 16, /* published events in flight */
+    DRAIN_TICKS = 10  /* ticks to drain the events before stopping */
+};
+
+/* market-data event published to all subscribers */
+typedef struct {
+    QEvt super;   /* inherits QEvt */
+
+    uint32_t seq; /* sequence number */
+} MarketEvt;
+
+/* Subscriber active objects ===============================================*/
+typedef struct {
+    QActive super;           /* inherits QActive */
+
+    uint32_t volatile nEvts; /* number of events received */
+} Subscriber;
+
+static QState Subscriber_initial(Subscriber * const me,
+                                 void const * const par);
+static QState Subscriber_active (Subscriber * const me,
+                                 QEvt const * const e);
+
+static Subscriber l_sub[MAX_SUBS];
+
+/*..........................................................................*/
+static void Subscriber_ctor(Subscriber * const me) {
+    QActive_ctor(&me->super, Q_STATE_CAST(&Subscriber_initial));
+    me->nEvts = 0U;
+}
+/*..........................................................................*/
+static QState Subscriber_initial(Subscriber * const me,
+                                 void const * const par)
+{
+    (void)par; /* unused parameter */
+    QActive_subscribe(&me->super, MARKET_SIG);
+    return Q_TRAN(&Subscriber_active);
+}
+/*..........................................................................*/
+static QState Subscriber_active(Subscriber * const me,
+                                QEvt const * const e)
+{
+    QState status_;
+    switch (e->sig) {
+        case MARKET_SIG: {
+            ++me->nEvts;
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status_;
+}
+
+/* Publisher active object =================================================*/
+typedef struct {
+    QActive super; /* inherits QActive */
+
+    uint32_t nPubs;   /* number of events published */
+    uint64_t sumNs;   /* total time spent in QACTIVE_PUBLISH() */
+    uint64_t minNs;   /* shortest QACTIVE_PUBLISH() */
+    uint64_t maxNs;   /* longest QACTIVE_PUBLISH() */
+} Publisher;
+
+static QState Publisher_initial(Publisher * const me, void const * const par);
+static QState Publisher_active (Publisher * const me, QEvt const * const e);
+
+static Publisher l_pub;
+static QEvt const l_pubEvt = QEVT_INITIALIZER(PUB_SIG);
+static uint_fast16_t l_nSubs = 40U;
+static bool volatile l_done; /* stop publishing */
+
+/*..........................................................................*/
+static void Publisher_ctor(Publisher * const me) {
+    QActive_ctor(&me->super, Q_STATE_CAST(&Publisher_initial));
+    me->nPubs = 0U;
+    me->sumNs = 0U;
+    me->minNs = ~(uint64_t)0U;
+    me->maxNs = 0U;
+}
+/*..........................................................................*/
+static QState Publisher_initial(Publisher * const me, void const * const par) {
+    (void)me;  /* unused parameter */
+    (void)par; /* unused parameter */
+    return Q_TRAN(&Publisher_active);
+}
+/*..........................................................................*/
+static uint64_t nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000U) + (uint64_t)ts.tv_nsec;
+}
+/*..........................................................................*/
+static QState Publisher_active(Publisher * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case PUB_SIG: {
+            if (!l_done) { /* still measuring? */
+                /* the slowest subscriber limits the events in flight */
+                uint32_t nMin = l_sub[0].nEvts;
+                for (uint_fast16_t n = 1U; n < l_nSubs; ++n) {
+                    uint32_t const nEvts = l_sub[n].nEvts;
+                    if (nMin > nEvts) {
+                        nMin = nEvts;
+                    }
+                }
+                if ((me->nPubs - nMin) < (uint32_t)WINDOW) {
+                    MarketEvt *pe = Q_NEW(MarketEvt, MARKET_SIG);
+                    pe->seq = me->nPubs;
+
+                    uint64_t const start = nowNs();
+                    QACTIVE_PUBLISH(&pe->super, me);
+                    uint64_t const ns = nowNs() - start;
+
+                    ++me->nPubs;
+                    me->sumNs += ns;
+                    if (me->minNs > ns) {
+                        me->minNs = ns;
+                    }
+                    if (me->maxNs < ns) {
+                        me->maxNs = ns;
+                    }
+                }
+                else {
+                    sched_yield(); /* let the subscribers catch up */
+                }
+                QACTIVE_POST(&me->super, &l_pubEvt, me); /* publish again */
+            }
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status_;
+}
+
+/* measurement =============================================================*/
+static uint32_t l_nTicks = 2U * BSP_TICKS_PER_SEC;
+
+/*..........................................................................*/
+static void report(void) {
+#if (defined QF_MPSC_EQUEUE)
+    char const * const crit = "mpsc";
+#elif (defined QF_OBJ_CRIT)
+    char const * const crit = "obj";
+#else
+    char const * const crit = "global";
+#endif
+#ifdef QF_PUBLISH_BATCH
+    char const * const publish = "batch";
+#else
+    char const * const publish = "loop";
+#endif
+    uint32_t const nPubs = l_pub.nPubs;
+    PRINTF_S("crit=%s publish=%s subs=%u pubs=%u "
+             "ns/publish: avg=%.0f min=%llu max=%llu\n",
+             crit, publish, (unsigned)l_nSubs, (unsigned)nPubs,
+             (nPubs != 0U) ? ((double)l_pub.sumNs / (double)nPubs) : 0.0,
+             (unsigned long long)((nPubs != 0U) ? l_pub.minNs : 0U),
+             (unsigned long long)l_pub.maxNs);
+}
+
+/* QF callbacks ============================================================*/
+void Q_onAssert(char const * const module, int loc) {
+    FPRINTF_S(stderr, "Assertion failed in %s:%d\n", module, loc);
+    exit(-1);
+}
+/*..........................................................................*/
+void QF_onStartup(void) {
+    /* the ticker must preempt the AOs, which never block in this test */
+    QF_setTickRate(BSP_TICKS_PER_SEC, sched_get_priority_max(SCHED_FIFO));
+}
+/*..........................................................................*/
+void QF_onCleanup(void) {
+}
+/*..........................................................................*/
+void QF_onClockTick(void) {
+    static uint32_t ctr;
+    ++ctr;
+    if (ctr == l_nTicks) { /* measurement time elapsed? */
+        l_done = true; /* let the subscribers drain all events in flight */
+        report();
+    }
+    else if (ctr == l_nTicks + DRAIN_TICKS) {
+        QF_stop();
+    }
+    else {
+        /* keep measuring */
+    }
+}
+
+/*..........................................................................*/
+int main(int argc, char *argv[]) {
+    static QEvt const *subQueueSto[MAX_SUBS][2 * WINDOW];
+    static QEvt const *pubQueueSto[4];
+    static QSubscrList subscrSto[MAX_PUB_SIG];
+    static QF_MPOOL_EL(MarketEvt) poolSto[2 * WINDOW];
+
+    /* usage: publish [<subscribers> [<seconds>]] */
+    if (argc > 1) {
+        int const n = atoi(argv[1]);
+        Q_REQUIRE((0 < n) && (n <= MAX_SUBS));
+        l_nSubs = (uint_fast16_t)n;
+    }
+    if (argc > 2) {
+        int const sec = atoi(argv[2]);
+        Q_REQUIRE(sec > 0);
+        l_nTicks = (uint32_t)sec * BSP_TICKS_PER_SEC;
+    }
+    Q_REQUIRE(l_nSubs <= MAX_SUBS);
+
+    QF_init(); /* initialize the framework */
+    QActive_psInit(subscrSto, Q_DIM(subscrSto));
+    QF_poolInit(poolSto, sizeof(poolSto), sizeof(poolSto[0]));
+
+    Publisher_ctor(&l_pub);
+    QACTIVE_START(&l_pub.super,
+                  1U, /* the lowest QP priority */
+                  pubQueueSto, Q_DIM(pubQueueSto),
+                  (void *)0, 0U, /* no stack */
+                  (void *)0);    /* no initialization parameter */
+
+    for (uint_fast16_t n = 0U; n < l_nSubs; ++n) {
+        Subscriber_ctor(&l_sub[n]);
+        QACTIVE_START(&l_sub[n].super,
+                      n + 2U, /* QP priority */
+                      subQueueSto[n], Q_DIM(subQueueSto[n]),
+                      (void *)0, 0U, /* no stack */
+                      (void *)0);    /* no initialization parameter */
+    }
+
+    /* start publishing */
+    QACTIVE_POST(&l_pub.super, &l_pubEvt, (void *)0);
+
+    return QF_run(); /* run the QF application */
+}
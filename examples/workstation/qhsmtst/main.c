@@ -36,12 +36,34 @@
 
 #include "safe_std.h" /* portable "safe" <stdio.h>/<string.h> facilities */
 #include <stdlib.h>
+#include <time.h>     /* for clock() and timespec_get() */
 
 Q_DEFINE_THIS_FILE
 
 /* local objects -----------------------------------------------------------*/
 static FILE *l_outFile = (FILE *)0;
 static void dispatch(QSignal sig);
+static void benchmark(uint32_t const loops);
+#ifdef QHSM_PROFILER
+static void profReport(void);
+#endif
+
+/* the test sequence of events (testing of dynamic transitions) */
+static QSignal const l_testSeq[] = {
+    A_SIG, B_SIG, D_SIG, E_SIG, I_SIG, F_SIG, I_SIG,
+    I_SIG, F_SIG, A_SIG, B_SIG, D_SIG, D_SIG, E_SIG,
+    G_SIG, H_SIG, H_SIG, C_SIG, G_SIG, C_SIG, C_SIG
+};
+
+#ifdef QHSM_TRAN_CACHE
+static QHsmTranPath l_tranPathSto[64]; /* must be a power of 2 */
+static QHsmTranCache l_tranCache;
+#endif
+
+#ifdef QHSM_PROFILER
+static QHsmProfEntry l_profSto[64]; /* must be a power of 2 */
+static QHsmProf l_prof;
+#endif
 
 /*..........................................................................*/
 int main(int argc, char *argv[]) {
@@ -51,6 +73,18 @@ int main(int argc, char *argv[]) {
 
     QHsmTst_ctor(); /* instantiate the QHsmTst object */
 
+#ifdef QHSM_TRAN_CACHE
+    /* replay the transitions of QHsmTst from the transition-path cache */
+    QHsmTranCache_init(&l_tranCache, l_tranPathSto, Q_DIM(l_tranPathSto));
+    QHsm_setTranCache(the_sm, &l_tranCache);
+#endif
+
+#ifdef QHSM_PROFILER
+    /* profile the dispatching of the events to QHsmTst */
+    QHsmProf_init(&l_prof, l_profSto, Q_DIM(l_profSto));
+    QHsm_setProf(the_sm, &l_prof);
+#endif
+
     Q_ALLEGE(QS_INIT((void *)0));
     QS_OBJ_DICTIONARY(the_sm);
     QS_SIG_DICTIONARY(A_SIG, (void *)0);
@@ -65,6 +99,15 @@ int main(int argc, char *argv[]) {
     QS_GLB_FILTER(QS_ALL_RECORDS);
     QS_GLB_FILTER(-QS_QF_TICK);
 
+    if ((argc > 1) && (strcmp(argv[1], "-b") == 0)) { /* benchmark? */
+        benchmark((argc > 2) ? (uint32_t)atoi(argv[2]) : 1000000U);
+#ifdef QHSM_PROFILER
+        profReport();
+#endif
+        QF_onCleanup();
+        return 0;
+    }
+
     if (argc > 1) {   /* file name provided? */
         l_outFile = fopen(argv[1], "w");
     }
@@ -116,29 +159,14 @@ int main(int argc, char *argv[]) {
         QHSM_INIT(the_sm, (void *)0, 0U); /* the top-most initial tran. */
 
         /* testing of dynamic transitions... */
-        dispatch(A_SIG);
-        dispatch(B_SIG);
-        dispatch(D_SIG);
-        dispatch(E_SIG);
-        dispatch(I_SIG);
-        dispatch(F_SIG);
-        dispatch(I_SIG);
-        dispatch(I_SIG);
-        dispatch(F_SIG);
-        dispatch(A_SIG);
-        dispatch(B_SIG);
-        dispatch(D_SIG);
-        dispatch(D_SIG);
-        dispatch(E_SIG);
-        dispatch(G_SIG);
-        dispatch(H_SIG);
-        dispatch(H_SIG);
-        dispatch(C_SIG);
-        dispatch(G_SIG);
-        dispatch(C_SIG);
-        dispatch(C_SIG);
+        for (uint_fast8_t i = 0U; i < Q_DIM(l_testSeq); ++i) {
+            dispatch(l_testSeq[i]);
+        }
 
         fclose(l_outFile);
+#ifdef QHSM_PROFILER
+        profReport();
+#endif
     }
 
     QF_onCleanup();
@@ -152,7 +180,9 @@ Q_NORETURN Q_onAssert(char const * const module, int_t const loc) {
 }
 /*..........................................................................*/
 void BSP_display(char const *msg) {
-    FPRINTF_S(l_outFile, "%s", msg);
+    if (l_outFile != (FILE *)0) { /* not benchmarking? */
+        FPRINTF_S(l_outFile, "%s", msg);
+    }
 }
 /*..........................................................................*/
 void BSP_exit(void) {
@@ -169,6 +199,85 @@ static void dispatch(QSignal sig) {
     QHSM_DISPATCH(the_sm, &e, 0U); /* dispatch the event */
     QS_OUTPUT(); /* handle the QS output */
 }
+/*..........................................................................*/
+static void benchmark(uint32_t const loops) {
+    /* usage: qhsmtst -b [<loops>] (no output from the state machine) */
+    QHSM_INIT(the_sm, (void *)0, 0U); /* the top-most initial tran. */
+
+    clock_t const start = clock();
+    for (uint32_t n = 0U; n < loops; ++n) {
+        for (uint_fast8_t i = 0U; i < Q_DIM(l_testSeq); ++i) {
+            QEvt e;
+            e.sig = l_testSeq[i];
+            QHSM_DISPATCH(the_sm, &e, 0U); /* dispatch the event */
+        }
+    }
+    double const sec = (double)(clock() - start) / (double)CLOCKS_PER_SEC;
+    uint64_t const evts = (uint64_t)loops * Q_DIM(l_testSeq);
+
+#ifdef QHSM_PROFILER
+    PRINTF_S("prof=on%s", " ");
+#elif defined QHSM_TRAN_CACHE
+    PRINTF_S("cache=on misses=%u ", (unsigned)l_tranCache.nMiss);
+#elif defined QHSMTST_TSM
+    PRINTF_S("tsm=on%s", " "); /* table-driven QTsm (../qtsmtst) */
+#elif defined QHSM_SIG_MAP
+    PRINTF_S("sigmap=on%s", " ");
+#else
+    PRINTF_S("cache=off%s", " ");
+#endif
+    PRINTF_S("evts=%llu sec=%.3f evts/sec=%.0f\n",
+             (unsigned long long)evts, sec,
+             (sec > 0.0) ? ((double)evts / sec) : 0.0);
+}
+
+#ifdef QHSM_PROFILER
+/*..........................................................................*/
+QHsmProfCtr QHsmProf_onGetTime(void) { /* time stamps in ns */
+    struct timespec ts;
+    (void)timespec_get(&ts, TIME_UTC);
+    return (QHsmProfCtr)(((uint32_t)ts.tv_sec * 1000000000U)
+                         + (uint32_t)ts.tv_nsec);
+}
+/*..........................................................................*/
+static void profReport(void) {
+    static QHsmProfEntry sum[Q_DIM(l_profSto)];
+    uint_fast16_t const n = QHsmProf_export(&l_prof, sum, Q_DIM(sum));
+
+    PRINTF_S("\n%-18s %-5s %9s %12s %7s %7s  %s\n",
+             "state", "sig", "count", "total[ns]", "min", "max",
+             "histogram[log2 ns:count]");
+    for (uint_fast16_t i = 0U; i < n; ++i) {
+        QHsmProfEntry const * const p = &sum[i];
+        char sig[8];
+        if (p->sig == (QSignal)Q_ENTRY_SIG) {
+            SNPRINTF_S(sig, sizeof(sig), "%s", "ENTRY");
+        }
+        else if (p->sig == (QSignal)Q_EXIT_SIG) {
+            SNPRINTF_S(sig, sizeof(sig), "%s", "EXIT");
+        }
+        else if (p->sig == (QSignal)Q_INIT_SIG) {
+            SNPRINTF_S(sig, sizeof(sig), "%s", "INIT");
+        }
+        else {
+            SNPRINTF_S(sig, sizeof(sig), "%c", 'A' + p->sig - A_SIG);
+        }
+        /* the state-handler addresses can be looked up with 'nm' */
+        PRINTF_S("0x%016llx %-5s %9u %12llu %7u %7u ",
+                 (unsigned long long)(uintptr_t)p->state, sig,
+                 (unsigned)p->count, (unsigned long long)p->total,
+                 (unsigned)p->min, (unsigned)p->max);
+        for (uint_fast8_t b = 0U; b < QHSM_PROF_BUCKETS; ++b) {
+            if (p->hist[b] != 0U) {
+                PRINTF_S(" %u:%u", (unsigned)b, (unsigned)p->hist[b]);
+            }
+        }
+        PRINTF_S("%s\n", "");
+    }
+    PRINTF_S("entries=%u lost=%u\n",
+             (unsigned)l_prof.used, (unsigned)l_prof.lost);
+}
+#endif /* QHSM_PROFILER */
 
 /*--------------------------------------------------------------------------*/
 void QF_onStartup(void) {
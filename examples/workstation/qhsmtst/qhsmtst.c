@@ -57,6 +57,29 @@ static QHsmTst l_sm; /* the only instance of the QHsmTst class */
 /* global-scope definitions ---------------------------------------*/
 QHsm * const the_sm = &l_sm.super;  /* the opaque pointer */
 
+/* the table-driven QTsm of this model (../qtsmtst) has no signal map */
+#if (defined QHSM_SIG_MAP) && (!defined QHSMTST_TSM)
+/* signals handled by the states of QHsmTst (see QHsmSigMap) */
+static QSignal const l_s_sigs[]    = { I_SIG, E_SIG, TERMINATE_SIG, 0U };
+static QSignal const l_s1_sigs[]   = { I_SIG, D_SIG, A_SIG, B_SIG, F_SIG,
+                                       C_SIG, 0U };
+static QSignal const l_s11_sigs[]  = { H_SIG, D_SIG, G_SIG, 0U };
+static QSignal const l_s2_sigs[]   = { I_SIG, F_SIG, C_SIG, 0U };
+static QSignal const l_s21_sigs[]  = { G_SIG, A_SIG, B_SIG, 0U };
+static QSignal const l_s211_sigs[] = { H_SIG, D_SIG, 0U };
+
+static QHsmStateSigs const l_stateSigs[] = {
+    { Q_STATE_CAST(&QHsmTst_s),    l_s_sigs    },
+    { Q_STATE_CAST(&QHsmTst_s1),   l_s1_sigs   },
+    { Q_STATE_CAST(&QHsmTst_s11),  l_s11_sigs  },
+    { Q_STATE_CAST(&QHsmTst_s2),   l_s2_sigs   },
+    { Q_STATE_CAST(&QHsmTst_s21),  l_s21_sigs  },
+    { Q_STATE_CAST(&QHsmTst_s211), l_s211_sigs }
+};
+static uint8_t l_route[Q_DIM(l_stateSigs)][MAX_SIG - Q_USER_SIG];
+static QHsmSigMap l_sigMap;
+#endif /* QHSM_SIG_MAP && !QHSMTST_TSM */
+
 /*$skip${QP_VERSION} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
 /* Check for the minimum required QP version */
 #if (QP_VERSION < 690U) || (QP_VERSION != ((QP_RELEASE^4294967295U) % 0x3E8U))
@@ -70,6 +93,12 @@ QHsm * const the_sm = &l_sm.super;  /* the opaque pointer */
 void QHsmTst_ctor(void) {
     QHsmTst *me = &l_sm;
     QHsm_ctor(&me->super, Q_STATE_CAST(&QHsmTst_initial));
+    #if (defined QHSM_SIG_MAP) && (!defined QHSMTST_TSM)
+    /* route the events directly to the states that handle them */
+    QHsmSigMap_init(&l_sigMap, l_stateSigs, Q_DIM(l_stateSigs),
+                    &l_route[0][0], MAX_SIG - Q_USER_SIG);
+    QHsm_setSigMap(&me->super, &l_sigMap);
+    #endif
 }
 /*$enddef${HSMs::QHsmTst_ctor} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
 /*$define${HSMs::QHsmTst} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
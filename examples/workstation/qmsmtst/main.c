@@ -36,6 +36,9 @@
 
 #include "safe_std.h" /* portable "safe" <stdio.h>/<string.h> facilities */
 #include <stdlib.h>
+#ifdef QHSM_PROFILER
+#include <time.h>     /* for timespec_get() */
+#endif
 
 Q_DEFINE_THIS_FILE
 
@@ -43,6 +46,12 @@ Q_DEFINE_THIS_FILE
 static FILE *l_outFile = (FILE *)0;
 static void dispatch(QSignal sig);
 
+#ifdef QHSM_PROFILER
+static QHsmProfEntry l_profSto[64]; /* must be a power of 2 */
+static QHsmProf l_prof;
+static void profReport(void);
+#endif
+
 /*..........................................................................*/
 int main(int argc, char *argv[]) {
 
@@ -51,6 +60,12 @@ int main(int argc, char *argv[]) {
 
     QMsmTst_ctor(); /* instantiate the QMsmTst object */
 
+#ifdef QHSM_PROFILER
+    /* profile the dispatching of the events to QMsmTst */
+    QHsmProf_init(&l_prof, l_profSto, Q_DIM(l_profSto));
+    QHsm_setProf(the_sm, &l_prof);
+#endif
+
     Q_ALLEGE(QS_INIT((void *)0));
     QS_OBJ_DICTIONARY(the_sm);
     QS_SIG_DICTIONARY(A_SIG, (void *)0);
@@ -139,6 +154,9 @@ int main(int argc, char *argv[]) {
         dispatch(C_SIG);
 
         fclose(l_outFile);
+#ifdef QHSM_PROFILER
+        profReport();
+#endif
     }
 
     QF_onCleanup();
@@ -170,6 +188,54 @@ static void dispatch(QSignal sig) {
     QS_OUTPUT(); /* handle the QS output */
 }
 
+#ifdef QHSM_PROFILER
+/*..........................................................................*/
+QHsmProfCtr QHsmProf_onGetTime(void) { /* time stamps in ns */
+    struct timespec ts;
+    (void)timespec_get(&ts, TIME_UTC);
+    return (QHsmProfCtr)(((uint32_t)ts.tv_sec * 1000000000U)
+                         + (uint32_t)ts.tv_nsec);
+}
+/*..........................................................................*/
+static void profReport(void) {
+    static QHsmProfEntry sum[Q_DIM(l_profSto)];
+    uint_fast16_t const n = QHsmProf_export(&l_prof, sum, Q_DIM(sum));
+
+    PRINTF_S("\n%-18s %-5s %9s %12s %7s %7s  %s\n",
+             "state", "sig", "count", "total[ns]", "min", "max",
+             "histogram[log2 ns:count]");
+    for (uint_fast16_t i = 0U; i < n; ++i) {
+        QHsmProfEntry const * const p = &sum[i];
+        char sig[8];
+        if (p->sig == (QSignal)Q_ENTRY_SIG) {
+            SNPRINTF_S(sig, sizeof(sig), "%s", "ENTRY");
+        }
+        else if (p->sig == (QSignal)Q_EXIT_SIG) {
+            SNPRINTF_S(sig, sizeof(sig), "%s", "EXIT");
+        }
+        else if (p->sig == (QSignal)Q_INIT_SIG) {
+            SNPRINTF_S(sig, sizeof(sig), "%s", "INIT");
+        }
+        else {
+            SNPRINTF_S(sig, sizeof(sig), "%c", 'A' + p->sig - A_SIG);
+        }
+        /* the state-handler addresses can be looked up with 'nm' */
+        PRINTF_S("0x%016llx %-5s %9u %12llu %7u %7u ",
+                 (unsigned long long)(uintptr_t)p->state, sig,
+                 (unsigned)p->count, (unsigned long long)p->total,
+                 (unsigned)p->min, (unsigned)p->max);
+        for (uint_fast8_t b = 0U; b < QHSM_PROF_BUCKETS; ++b) {
+            if (p->hist[b] != 0U) {
+                PRINTF_S(" %u:%u", (unsigned)b, (unsigned)p->hist[b]);
+            }
+        }
+        PRINTF_S("%s\n", "");
+    }
+    PRINTF_S("entries=%u lost=%u\n",
+             (unsigned)l_prof.used, (unsigned)l_prof.lost);
+}
+#endif /* QHSM_PROFILER */
+
 /*--------------------------------------------------------------------------*/
 void QF_onStartup(void) {
     QF_consoleSetup();
@@ -0,0 +1,487 @@
+/*****************************************************************************
+* Table-driven state machine code (see QTsm) for the file: qhsmtst.c
+* generated by qtsmgen.py 7.1.1 from the model: qhsmtst.qm
+*
+* DO NOT EDIT THIS FILE MANUALLY. All your changes will be lost.
+*****************************************************************************/
+#include "qpc.h"
+#include "qhsmtst.h"
+
+/*${HSMs::QHsmTst} .........................................................*/
+typedef struct QHsmTst {
+/* protected: */
+    QHsm super;
+
+/* private: */
+    uint8_t foo;
+} QHsmTst;
+
+/* the constant tables of the state machine */
+extern QTsmTable const QHsmTst_table;
+
+static QHsmTst l_sm; /* the only instance of the QHsmTst class */
+
+/* global-scope definitions ---------------------------------------*/
+QHsm * const the_sm = &l_sm.super;  /* the opaque pointer */
+
+/* the table-driven QTsm of this model (../qtsmtst) has no signal map */
+#if (defined QHSM_SIG_MAP) && (!defined QHSMTST_TSM)
+/* signals handled by the states of QHsmTst (see QHsmSigMap) */
+static QSignal const l_s_sigs[]    = { I_SIG, E_SIG, TERMINATE_SIG, 0U };
+static QSignal const l_s1_sigs[]   = { I_SIG, D_SIG, A_SIG, B_SIG, F_SIG,
+                                       C_SIG, 0U };
+static QSignal const l_s11_sigs[]  = { H_SIG, D_SIG, G_SIG, 0U };
+static QSignal const l_s2_sigs[]   = { I_SIG, F_SIG, C_SIG, 0U };
+static QSignal const l_s21_sigs[]  = { G_SIG, A_SIG, B_SIG, 0U };
+static QSignal const l_s211_sigs[] = { H_SIG, D_SIG, 0U };
+
+static QHsmStateSigs const l_stateSigs[] = {
+    { Q_STATE_CAST(&QHsmTst_s),    l_s_sigs    },
+    { Q_STATE_CAST(&QHsmTst_s1),   l_s1_sigs   },
+    { Q_STATE_CAST(&QHsmTst_s11),  l_s11_sigs  },
+    { Q_STATE_CAST(&QHsmTst_s2),   l_s2_sigs   },
+    { Q_STATE_CAST(&QHsmTst_s21),  l_s21_sigs  },
+    { Q_STATE_CAST(&QHsmTst_s211), l_s211_sigs }
+};
+static uint8_t l_route[Q_DIM(l_stateSigs)][MAX_SIG - Q_USER_SIG];
+static QHsmSigMap l_sigMap;
+#endif /* QHSM_SIG_MAP && !QHSMTST_TSM */
+
+/*${HSMs::QHsmTst_ctor} ....................................................*/
+void QHsmTst_ctor(void) {
+    QHsmTst *me = &l_sm;
+    QTsm_ctor(&me->super, &QHsmTst_table);
+    #if (defined QHSM_SIG_MAP) && (!defined QHSMTST_TSM)
+    /* route the events directly to the states that handle them */
+    QHsmSigMap_init(&l_sigMap, l_stateSigs, Q_DIM(l_stateSigs),
+                    &l_route[0][0], MAX_SIG - Q_USER_SIG);
+    QHsm_setSigMap(&me->super, &l_sigMap);
+    #endif
+}
+/*${HSMs::QHsmTst} .........................................................*/
+
+/*${HSMs::QHsmTst::SM} .....................................................*/
+/*${HSMs::QHsmTst::SM::s} ..................................................*/
+static void QHsmTst_s(QHsmTst * const me, QEvt const * const e) {
+    (void)me; /* unused parameter */
+    (void)e; /* unused parameter */
+    BSP_display("s-ENTRY;");
+}
+
+static void QHsmTst_s_exit(QHsmTst * const me, QEvt const * const e) {
+    (void)me; /* unused parameter */
+    (void)e; /* unused parameter */
+    BSP_display("s-EXIT;");
+}
+
+/*${HSMs::QHsmTst::SM::s::initial} .........................................*/
+static void QHsmTst_s_init(QHsmTst * const me, QEvt const * const e) {
+    (void)me; /* unused parameter */
+    (void)e; /* unused parameter */
+    BSP_display("s-INIT;");
+}
+
+/*${HSMs::QHsmTst::SM::s::I::[me->foo]} ....................................*/
+static bool QHsmTst_s_I_g1(QHsmTst * const me, QEvt const * const e) {
+    (void)e; /* unused parameter */
+    return (me->foo);
+}
+
+static void QHsmTst_s_I_1(QHsmTst * const me, QEvt const * const e) {
+    (void)e; /* unused parameter */
+    me->foo = 0U;
+    BSP_display("s-I;");
+}
+
+/*${HSMs::QHsmTst::SM::s::E} ...............................................*/
+static void QHsmTst_s_E(QHsmTst * const me, QEvt const * const e) {
+    (void)me; /* unused parameter */
+    (void)e; /* unused parameter */
+    BSP_display("s-E;");
+}
+
+/*${HSMs::QHsmTst::SM::s::TERMINATE} .......................................*/
+static void QHsmTst_s_TERMINATE(QHsmTst * const me, QEvt const * const e) {
+    (void)me; /* unused parameter */
+    (void)e; /* unused parameter */
+    BSP_exit();
+}
+
+/*${HSMs::QHsmTst::SM::s::s1} ..............................................*/
+static void QHsmTst_s1(QHsmTst * const me, QEvt const * const e) {
+    (void)me; /* unused parameter */
+    (void)e; /* unused parameter */
+    BSP_display("s1-ENTRY;");
+}
+
+static void QHsmTst_s1_exit(QHsmTst * const me, QEvt const * const e) {
+    (void)me; /* unused parameter */
+    (void)e; /* unused parameter */
+    BSP_display("s1-EXIT;");
+}
+
+/*${HSMs::QHsmTst::SM::s::s1::initial} .....................................*/
+static void QHsmTst_s1_init(QHsmTst * const me, QEvt const * const e) {
+    (void)me; /* unused parameter */
+    (void)e; /* unused parameter */
+    BSP_display("s1-INIT;");
+}
+
+/*${HSMs::QHsmTst::SM::s::s1::I} ...........................................*/
+static void QHsmTst_s1_I(QHsmTst * const me, QEvt const * const e) {
+    (void)me; /* unused parameter */
+    (void)e; /* unused parameter */
+    BSP_display("s1-I;");
+}
+
+/*${HSMs::QHsmTst::SM::s::s1::D::[!me->foo]} ...............................*/
+static bool QHsmTst_s1_D_g1(QHsmTst * const me, QEvt const * const e) {
+    (void)e; /* unused parameter */
+    return (!me->foo);
+}
+
+static void QHsmTst_s1_D_1(QHsmTst * const me, QEvt const * const e) {
+    (void)e; /* unused parameter */
+    me->foo = 1U;
+    BSP_display("s1-D;");
+}
+
+/*${HSMs::QHsmTst::SM::s::s1::A} ...........................................*/
+static void QHsmTst_s1_A(QHsmTst * const me, QEvt const * const e) {
+    (void)me; /* unused parameter */
+    (void)e; /* unused parameter */
+    BSP_display("s1-A;");
+}
+
+/*${HSMs::QHsmTst::SM::s::s1::B} ...........................................*/
+static void QHsmTst_s1_B(QHsmTst * const me, QEvt const * const e) {
+    (void)me; /* unused parameter */
+    (void)e; /* unused parameter */
+    BSP_display("s1-B;");
+}
+
+/*${HSMs::QHsmTst::SM::s::s1::F} ...........................................*/
+static void QHsmTst_s1_F(QHsmTst * const me, QEvt const * const e) {
+    (void)me; /* unused parameter */
+    (void)e; /* unused parameter */
+    BSP_display("s1-F;");
+}
+
+/*${HSMs::QHsmTst::SM::s::s1::C} ...........................................*/
+static void QHsmTst_s1_C(QHsmTst * const me, QEvt const * const e) {
+    (void)me; /* unused parameter */
+    (void)e; /* unused parameter */
+    BSP_display("s1-C;");
+}
+
+/*${HSMs::QHsmTst::SM::s::s1::s11} .........................................*/
+static void QHsmTst_s11(QHsmTst * const me, QEvt const * const e) {
+    (void)me; /* unused parameter */
+    (void)e; /* unused parameter */
+    BSP_display("s11-ENTRY;");
+}
+
+static void QHsmTst_s11_exit(QHsmTst * const me, QEvt const * const e) {
+    (void)me; /* unused parameter */
+    (void)e; /* unused parameter */
+    BSP_display("s11-EXIT;");
+}
+
+/*${HSMs::QHsmTst::SM::s::s1::s11::H} ......................................*/
+static void QHsmTst_s11_H(QHsmTst * const me, QEvt const * const e) {
+    (void)me; /* unused parameter */
+    (void)e; /* unused parameter */
+    BSP_display("s11-H;");
+}
+
+/*${HSMs::QHsmTst::SM::s::s1::s11::D::[me->foo]} ...........................*/
+static bool QHsmTst_s11_D_g1(QHsmTst * const me, QEvt const * const e) {
+    (void)e; /* unused parameter */
+    return (me->foo);
+}
+
+static void QHsmTst_s11_D_1(QHsmTst * const me, QEvt const * const e) {
+    (void)e; /* unused parameter */
+    me->foo = 0U;
+    BSP_display("s11-D;");
+}
+
+/*${HSMs::QHsmTst::SM::s::s1::s11::G} ......................................*/
+static void QHsmTst_s11_G(QHsmTst * const me, QEvt const * const e) {
+    (void)me; /* unused parameter */
+    (void)e; /* unused parameter */
+    BSP_display("s11-G;");
+}
+
+/*${HSMs::QHsmTst::SM::s::s2} ..............................................*/
+static void QHsmTst_s2(QHsmTst * const me, QEvt const * const e) {
+    (void)me; /* unused parameter */
+    (void)e; /* unused parameter */
+    BSP_display("s2-ENTRY;");
+}
+
+static void QHsmTst_s2_exit(QHsmTst * const me, QEvt const * const e) {
+    (void)me; /* unused parameter */
+    (void)e; /* unused parameter */
+    BSP_display("s2-EXIT;");
+}
+
+/*${HSMs::QHsmTst::SM::s::s2::initial} .....................................*/
+static void QHsmTst_s2_init(QHsmTst * const me, QEvt const * const e) {
+    (void)me; /* unused parameter */
+    (void)e; /* unused parameter */
+    BSP_display("s2-INIT;");
+}
+
+/*${HSMs::QHsmTst::SM::s::s2::I::[!me->foo]} ...............................*/
+static bool QHsmTst_s2_I_g1(QHsmTst * const me, QEvt const * const e) {
+    (void)e; /* unused parameter */
+    return (!me->foo);
+}
+
+static void QHsmTst_s2_I_1(QHsmTst * const me, QEvt const * const e) {
+    (void)e; /* unused parameter */
+    me->foo = 1U;
+    BSP_display("s2-I;");
+}
+
+/*${HSMs::QHsmTst::SM::s::s2::F} ...........................................*/
+static void QHsmTst_s2_F(QHsmTst * const me, QEvt const * const e) {
+    (void)me; /* unused parameter */
+    (void)e; /* unused parameter */
+    BSP_display("s2-F;");
+}
+
+/*${HSMs::QHsmTst::SM::s::s2::C} ...........................................*/
+static void QHsmTst_s2_C(QHsmTst * const me, QEvt const * const e) {
+    (void)me; /* unused parameter */
+    (void)e; /* unused parameter */
+    BSP_display("s2-C;");
+}
+
+/*${HSMs::QHsmTst::SM::s::s2::s21} .........................................*/
+static void QHsmTst_s21(QHsmTst * const me, QEvt const * const e) {
+    (void)me; /* unused parameter */
+    (void)e; /* unused parameter */
+    BSP_display("s21-ENTRY;");
+}
+
+static void QHsmTst_s21_exit(QHsmTst * const me, QEvt const * const e) {
+    (void)me; /* unused parameter */
+    (void)e; /* unused parameter */
+    BSP_display("s21-EXIT;");
+}
+
+/*${HSMs::QHsmTst::SM::s::s2::s21::initial} ................................*/
+static void QHsmTst_s21_init(QHsmTst * const me, QEvt const * const e) {
+    (void)me; /* unused parameter */
+    (void)e; /* unused parameter */
+    BSP_display("s21-INIT;");
+}
+
+/*${HSMs::QHsmTst::SM::s::s2::s21::G} ......................................*/
+static void QHsmTst_s21_G(QHsmTst * const me, QEvt const * const e) {
+    (void)me; /* unused parameter */
+    (void)e; /* unused parameter */
+    BSP_display("s21-G;");
+}
+
+/*${HSMs::QHsmTst::SM::s::s2::s21::A} ......................................*/
+static void QHsmTst_s21_A(QHsmTst * const me, QEvt const * const e) {
+    (void)me; /* unused parameter */
+    (void)e; /* unused parameter */
+    BSP_display("s21-A;");
+}
+
+/*${HSMs::QHsmTst::SM::s::s2::s21::B} ......................................*/
+static void QHsmTst_s21_B(QHsmTst * const me, QEvt const * const e) {
+    (void)me; /* unused parameter */
+    (void)e; /* unused parameter */
+    BSP_display("s21-B;");
+}
+
+/*${HSMs::QHsmTst::SM::s::s2::s21::s211} ...................................*/
+static void QHsmTst_s211(QHsmTst * const me, QEvt const * const e) {
+    (void)me; /* unused parameter */
+    (void)e; /* unused parameter */
+    BSP_display("s211-ENTRY;");
+}
+
+static void QHsmTst_s211_exit(QHsmTst * const me, QEvt const * const e) {
+    (void)me; /* unused parameter */
+    (void)e; /* unused parameter */
+    BSP_display("s211-EXIT;");
+}
+
+/*${HSMs::QHsmTst::SM::s::s2::s21::s211::H} ................................*/
+static void QHsmTst_s211_H(QHsmTst * const me, QEvt const * const e) {
+    (void)me; /* unused parameter */
+    (void)e; /* unused parameter */
+    BSP_display("s211-H;");
+}
+
+/*${HSMs::QHsmTst::SM::s::s2::s21::s211::D} ................................*/
+static void QHsmTst_s211_D(QHsmTst * const me, QEvt const * const e) {
+    (void)me; /* unused parameter */
+    (void)e; /* unused parameter */
+    BSP_display("s211-D;");
+}
+
+/*${HSMs::QHsmTst::SM::initial} ............................................*/
+static void QHsmTst_initial(QHsmTst * const me, void const * const par) {
+    (void)par; /* unused parameter */
+    me->foo = 0U;
+    BSP_display("top-INIT;");
+
+    QS_FUN_DICTIONARY(&QHsmTst_s);
+    QS_FUN_DICTIONARY(&QHsmTst_s1);
+    QS_FUN_DICTIONARY(&QHsmTst_s11);
+    QS_FUN_DICTIONARY(&QHsmTst_s2);
+    QS_FUN_DICTIONARY(&QHsmTst_s21);
+    QS_FUN_DICTIONARY(&QHsmTst_s211);
+}
+
+/*${HSMs::QHsmTst::SM::tables} .............................................*/
+static QTsmState const QHsmTst_states[7] = {
+    /* 0: top */
+    { (QTsmAction)0, (QTsmAction)0, 0U, 1U },
+    /* 1: s */
+    { (QTsmAction)&QHsmTst_s, (QTsmAction)&QHsmTst_s_exit, 0U, 2U },
+    /* 2: s::s1 */
+    { (QTsmAction)&QHsmTst_s1, (QTsmAction)&QHsmTst_s1_exit, 1U, 6U },
+    /* 3: s::s1::s11 */
+    { (QTsmAction)&QHsmTst_s11, (QTsmAction)&QHsmTst_s11_exit, 2U, 0U },
+    /* 4: s::s2 */
+    { (QTsmAction)&QHsmTst_s2, (QTsmAction)&QHsmTst_s2_exit, 1U, 16U },
+    /* 5: s::s2::s21 */
+    { (QTsmAction)&QHsmTst_s21, (QTsmAction)&QHsmTst_s21_exit, 4U, 20U },
+    /* 6: s::s2::s21::s211 */
+    { (QTsmAction)&QHsmTst_s211, (QTsmAction)&QHsmTst_s211_exit, 5U, 0U }
+};
+
+static QTsmTran const QHsmTst_trans[26] = {
+    /* 0: not used */
+    { (QTsmGuard)0, (QTsmAction)0, 0U, 0U, 0U, 0U, 0U, 0U },
+    /* 1: initial */
+    { (QTsmGuard)0, (QTsmAction)&QHsmTst_initial, 0U, 2U, 0U, 4U, 0U, 0U },
+    /* 2: s::initial */
+    { (QTsmGuard)0, (QTsmAction)&QHsmTst_s_init, 2U, 2U, 1U, 3U, 1U, 0U },
+    /* 3: s::I::[me->foo] */
+    { (QTsmGuard)&QHsmTst_s_I_g1, (QTsmAction)&QHsmTst_s_I_1, 0U, 0U, 1U, 0U, 0U, 0U },
+    /* 4: s::E */
+    { (QTsmGuard)0, (QTsmAction)&QHsmTst_s_E, 2U, 2U, 1U, 3U, 1U, 0U },
+    /* 5: s::TERMINATE */
+    { (QTsmGuard)0, (QTsmAction)&QHsmTst_s_TERMINATE, 0U, 0U, 1U, 0U, 0U, 0U },
+    /* 6: s::s1::initial */
+    { (QTsmGuard)0, (QTsmAction)&QHsmTst_s1_init, 4U, 1U, 2U, 3U, 2U, 0U },
+    /* 7: s::s1::I */
+    { (QTsmGuard)0, (QTsmAction)&QHsmTst_s1_I, 0U, 0U, 2U, 0U, 0U, 0U },
+    /* 8: s::s1::D::[!me->foo] */
+    { (QTsmGuard)&QHsmTst_s1_D_g1, (QTsmAction)&QHsmTst_s1_D_1, 0U, 0U, 2U, 1U, 1U, 0U },
+    /* 9: s::s1::A */
+    { (QTsmGuard)0, (QTsmAction)&QHsmTst_s1_A, 5U, 1U, 2U, 2U, 1U, 0U },
+    /* 10: s::s1::B */
+    { (QTsmGuard)0, (QTsmAction)&QHsmTst_s1_B, 4U, 1U, 2U, 3U, 2U, 0U },
+    /* 11: s::s1::F */
+    { (QTsmGuard)0, (QTsmAction)&QHsmTst_s1_F, 6U, 3U, 2U, 6U, 1U, 0U },
+    /* 12: s::s1::C */
+    { (QTsmGuard)0, (QTsmAction)&QHsmTst_s1_C, 9U, 1U, 2U, 4U, 1U, 0U },
+    /* 13: s::s1::s11::H */
+    { (QTsmGuard)0, (QTsmAction)&QHsmTst_s11_H, 0U, 0U, 3U, 1U, 1U, 0U },
+    /* 14: s::s1::s11::D::[me->foo] */
+    { (QTsmGuard)&QHsmTst_s11_D_g1, (QTsmAction)&QHsmTst_s11_D_1, 0U, 0U, 3U, 2U, 2U, 8U },
+    /* 15: s::s1::s11::G */
+    { (QTsmGuard)0, (QTsmAction)&QHsmTst_s11_G, 6U, 3U, 3U, 6U, 1U, 0U },
+    /* 16: s::s2::initial */
+    { (QTsmGuard)0, (QTsmAction)&QHsmTst_s2_init, 10U, 2U, 4U, 6U, 4U, 0U },
+    /* 17: s::s2::I::[!me->foo] */
+    { (QTsmGuard)&QHsmTst_s2_I_g1, (QTsmAction)&QHsmTst_s2_I_1, 0U, 0U, 4U, 0U, 0U, 3U },
+    /* 18: s::s2::F */
+    { (QTsmGuard)0, (QTsmAction)&QHsmTst_s2_F, 2U, 2U, 4U, 3U, 1U, 0U },
+    /* 19: s::s2::C */
+    { (QTsmGuard)0, (QTsmAction)&QHsmTst_s2_C, 5U, 1U, 4U, 2U, 1U, 0U },
+    /* 20: s::s2::s21::initial */
+    { (QTsmGuard)0, (QTsmAction)&QHsmTst_s21_init, 12U, 1U, 5U, 6U, 5U, 0U },
+    /* 21: s::s2::s21::G */
+    { (QTsmGuard)0, (QTsmAction)&QHsmTst_s21_G, 5U, 1U, 5U, 2U, 1U, 0U },
+    /* 22: s::s2::s21::A */
+    { (QTsmGuard)0, (QTsmAction)&QHsmTst_s21_A, 13U, 1U, 5U, 5U, 4U, 0U },
+    /* 23: s::s2::s21::B */
+    { (QTsmGuard)0, (QTsmAction)&QHsmTst_s21_B, 12U, 1U, 5U, 6U, 5U, 0U },
+    /* 24: s::s2::s21::s211::H */
+    { (QTsmGuard)0, (QTsmAction)&QHsmTst_s211_H, 0U, 0U, 6U, 1U, 1U, 0U },
+    /* 25: s::s2::s21::s211::D */
+    { (QTsmGuard)0, (QTsmAction)&QHsmTst_s211_D, 0U, 0U, 6U, 5U, 5U, 0U }
+};
+
+static uint8_t const QHsmTst_paths[14] = {
+    1U, 4U, 2U, 3U, 3U, 2U, 4U, 5U, 6U, 4U, 5U, 6U,
+    6U, 5U
+};
+
+static uint8_t const QHsmTst_dispatch[7][MAX_SIG - Q_USER_SIG] = {
+    [1] = { /* s */
+        [I_SIG - Q_USER_SIG] = 3U,
+        [E_SIG - Q_USER_SIG] = 4U,
+        [TERMINATE_SIG - Q_USER_SIG] = 5U
+    },
+    [2] = { /* s::s1 */
+        [I_SIG - Q_USER_SIG] = 7U,
+        [E_SIG - Q_USER_SIG] = 4U,
+        [TERMINATE_SIG - Q_USER_SIG] = 5U,
+        [D_SIG - Q_USER_SIG] = 8U,
+        [A_SIG - Q_USER_SIG] = 9U,
+        [B_SIG - Q_USER_SIG] = 10U,
+        [F_SIG - Q_USER_SIG] = 11U,
+        [C_SIG - Q_USER_SIG] = 12U
+    },
+    [3] = { /* s::s1::s11 */
+        [I_SIG - Q_USER_SIG] = 7U,
+        [E_SIG - Q_USER_SIG] = 4U,
+        [TERMINATE_SIG - Q_USER_SIG] = 5U,
+        [D_SIG - Q_USER_SIG] = 14U,
+        [A_SIG - Q_USER_SIG] = 9U,
+        [B_SIG - Q_USER_SIG] = 10U,
+        [F_SIG - Q_USER_SIG] = 11U,
+        [C_SIG - Q_USER_SIG] = 12U,
+        [H_SIG - Q_USER_SIG] = 13U,
+        [G_SIG - Q_USER_SIG] = 15U
+    },
+    [4] = { /* s::s2 */
+        [I_SIG - Q_USER_SIG] = 17U,
+        [E_SIG - Q_USER_SIG] = 4U,
+        [TERMINATE_SIG - Q_USER_SIG] = 5U,
+        [F_SIG - Q_USER_SIG] = 18U,
+        [C_SIG - Q_USER_SIG] = 19U
+    },
+    [5] = { /* s::s2::s21 */
+        [I_SIG - Q_USER_SIG] = 17U,
+        [E_SIG - Q_USER_SIG] = 4U,
+        [TERMINATE_SIG - Q_USER_SIG] = 5U,
+        [A_SIG - Q_USER_SIG] = 22U,
+        [B_SIG - Q_USER_SIG] = 23U,
+        [F_SIG - Q_USER_SIG] = 18U,
+        [C_SIG - Q_USER_SIG] = 19U,
+        [G_SIG - Q_USER_SIG] = 21U
+    },
+    [6] = { /* s::s2::s21::s211 */
+        [I_SIG - Q_USER_SIG] = 17U,
+        [E_SIG - Q_USER_SIG] = 4U,
+        [TERMINATE_SIG - Q_USER_SIG] = 5U,
+        [D_SIG - Q_USER_SIG] = 25U,
+        [A_SIG - Q_USER_SIG] = 22U,
+        [B_SIG - Q_USER_SIG] = 23U,
+        [F_SIG - Q_USER_SIG] = 18U,
+        [C_SIG - Q_USER_SIG] = 19U,
+        [H_SIG - Q_USER_SIG] = 24U,
+        [G_SIG - Q_USER_SIG] = 21U
+    }
+};
+
+QTsmTable const QHsmTst_table = {
+    &QHsmTst_states[0],
+    &QHsmTst_trans[0],
+    &QHsmTst_paths[0],
+    &QHsmTst_dispatch[0][0],
+    (uint16_t)(MAX_SIG - Q_USER_SIG)
+};
@@ -0,0 +1,609 @@
+#!/usr/bin/env python3
+#============================================================================
+# QTsm table generator (table-driven state machines for QP/C)
+# Last updated for version 7.1.1
+# Last updated on  2022-10-18
+#
+#                    Q u a n t u m  L e a P s
+#                    ------------------------
+#                    Modern Embedded Software
+#
+# Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+#
+# SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+#
+# Contact information:
+# <www.state-machine.com/licensing>
+# <info@state-machine.com>
+#============================================================================
+"""
+Generates the C code of the table-driven state machines (see ::QTsm in
+qep.h) from a QM model (.qm) of ::QHsm or ::QActive state machines.
+
+usage: qtsmgen.py [-o <out.c>] [-s <nSigs>] <model.qm> <file>
+
+The <file> is the name of a file template in the model (e.g., qhsmtst.c).
+The template is expanded like QM would do it, except that:
+
+- $declare${<Class>} declares the class and the extern ::QTsmTable
+  <Class>_table of its state machine
+- $define${<Class>} defines the class operations, the actions and guards
+  as static functions and the constant tables of the state machine
+- the calls to QHsm_ctor()/QActive_ctor() with Q_STATE_CAST(&<Class>_initial)
+  in the operations are replaced with QTsm_ctor()/QTActive_ctor() with
+  &<Class>_table
+
+The <nSigs> is the number of the signals in every row of the dispatch
+table, "MAX_SIG - Q_USER_SIG" by default.
+
+Supported are the states with entry/exit actions, initial transitions,
+regular and internal transitions and choices with guards (including
+"else"). History, junctions and submachines are not supported.
+"""
+import sys
+import re
+import argparse
+import xml.etree.ElementTree as ET
+
+VERSION = '7.1.1'
+# the model elements counted in the target paths (e.g., "../1/3")
+NUMBERED = ('initial', 'tran', 'state', 'choice', 'history', 'junction',
+            'smstate')
+
+
+class GenError(Exception):
+    pass
+
+
+def hdr(name):
+    """QM-style comment header of a model element"""
+    text = '/*${%s} ' % name
+    return text + '.' * max(0, 76 - len(text)) + '*/'
+
+
+def indent(code, n=4):
+    return '\n'.join((' ' * n + ln) if ln.strip() else ''
+                     for ln in code.strip('\n').split('\n'))
+
+
+def comment(text):
+    return text.replace('*/', '* /')
+
+
+class State:
+    def __init__(self, elem, name, parent):
+        self.elem = elem
+        self.name = name
+        self.parent = parent
+        self.path = name if (parent is None or parent.parent is None) \
+            else parent.path + '::' + name
+        self.children = []
+        self.idx = 0
+        self.entry = None
+        self.exit = None
+        self.init = 0   # index of the initial transition
+        self.sigs = {}  # signal -> index of the first transition
+        self.chains = []  # (signal, [transitions tried in order])
+
+    def ancestors(self):
+        """this state and all its superstates up to the top state"""
+        s = self
+        while s is not None:
+            yield s
+            s = s.parent
+
+
+class Tran:
+    def __init__(self, source, path):
+        self.source = source
+        self.path = path
+        self.guard = None    # guard expression
+        self.action = None   # action code
+        self.target = None   # target State (None for internal tran.)
+        self.guardFun = None
+        self.actionFun = None
+        self.next = 0
+        self.stop = None
+        self.entries = []
+        self.pathIdx = 0
+        self.idx = 0
+
+
+class StateMachine:
+    def __init__(self, cls, pkgPath, parents):
+        self.cls = cls
+        self.name = cls.get('name')
+        self.path = pkgPath + '::' + self.name
+        self.parents = parents
+        self.states = []
+        self.trans = [None]  # trans[0] is not used
+        sc = cls.find('statechart')
+        self.top = State(sc, 'top', None)
+        self.states.append(self.top)
+        init = sc.find('initial')
+        if init is None:
+            raise GenError('%s: no top-most initial transition' % self.path)
+        self._states(sc, self.top)
+        self.topInit = self._init(init, self.top)
+        self._trans(self.top)
+        self._resolve()
+
+    # parsing ...............................................................
+    def _states(self, elem, parent):
+        for e in elem.findall('state'):
+            s = State(e, e.get('name'), parent)
+            s.idx = len(self.states)
+            self.states.append(s)
+            parent.children.append(s)
+            s.entry = e.findtext('entry')
+            s.exit = e.findtext('exit')
+            self._states(e, s)
+        for tag in ('history', 'junction', 'smstate', 'submachine'):
+            if elem.find(tag) is not None:
+                raise GenError('%s: <%s> is not supported'
+                               % (self.path, tag))
+
+    def _target(self, elem, src):
+        """resolve the target path (e.g., "../../4/7") of a model element"""
+        cur = elem
+        for part in elem.get('target').split('/'):
+            if part == '..':
+                cur = self.parents[cur]
+            else:
+                kids = [k for k in cur if k.tag in NUMBERED]
+                cur = kids[int(part)]
+        for s in self.states:
+            if s.elem is cur:
+                return s
+        raise GenError('%s: target "%s" is not a state'
+                       % (src, elem.get('target')))
+
+    def _init(self, elem, state):
+        t = Tran(state, (state.path + '::initial') if state.parent
+                 else 'initial')
+        t.action = elem.findtext('action')
+        t.target = self._target(elem, t.path)
+        if state not in list(t.target.ancestors())[1:]:
+            raise GenError('%s: initial transition must target a substate'
+                           % t.path)
+        t.actionFun = '%s_%s_init' % (self.name, state.name) \
+            if state.parent else '%s_initial' % self.name
+        self._add(t)
+        state.init = t.idx
+        return t
+
+    def _add(self, t):
+        t.idx = len(self.trans)
+        self.trans.append(t)
+        if t.idx > 255:
+            raise GenError('%s: too many transitions' % self.path)
+
+    def _fold(self, s, e, path, base, choices):
+        """a transition with an action followed by a choice, where the
+        guards might depend on the action (e.g., on its local variables),
+        is folded into a single transition with the whole if-else chain in
+        its action. This requires the same target of all the branches and
+        the final [else] branch.
+        """
+        t = Tran(s, path)
+        targets = set(c.get('target') for c in choices)
+        if (len(targets) != 1) or (choices[-1].findtext('guard').strip()
+                                   != 'else'):
+            raise GenError('%s: action before a choice requires the same '
+                           'target of all branches and [else]' % path)
+        code = [e.findtext('action').rstrip()]
+        for k, c in enumerate(choices):
+            g = c.findtext('guard').strip()
+            code.append('%s {\n%s\n}' % (
+                'else' if g == 'else' else
+                ('if (%s)' if k == 0 else 'else if (%s)') % g,
+                indent(c.findtext('action') or '/* no action */')))
+        t.action = '\n'.join(code)
+        t.actionFun = base
+        if choices[0].get('target') is not None:
+            t.target = self._target(choices[0], path)
+        self._add(t)
+        return t
+
+    def _trans(self, parent):
+        for s in parent.children:
+            init = s.elem.find('initial')
+            if init is not None:
+                self._init(init, s)
+            for e in s.elem.findall('tran'):
+                trigs = [x.strip() for x in e.get('trig').split(',')]
+                base = '%s_%s_%s' % (self.name, s.name, '_'.join(trigs))
+                path = '%s::%s' % (s.path, e.get('trig'))
+                # the [else] branch is always evaluated last
+                choices = sorted(e.findall('choice'), key=lambda c:
+                                 c.findtext('guard', '').strip() == 'else')
+                if not choices:
+                    t = Tran(s, path)
+                    t.action = e.findtext('action')
+                    t.actionFun = base
+                    if e.get('target') is not None:
+                        t.target = self._target(e, path)
+                    self._add(t)
+                    chain = [t]
+                elif e.findtext('action'):
+                    chain = [self._fold(s, e, path, base, choices)]
+                else:
+                    chain = []
+                    for k, c in enumerate(choices, 1):
+                        if c.find('choice') is not None:
+                            raise GenError('%s: nested choices are not '
+                                           'supported' % path)
+                        g = c.findtext('guard').strip()
+                        t = Tran(s, '%s::[%s]' % (path, g))
+                        if g != 'else':
+                            t.guard = g
+                            t.guardFun = '%s_g%d' % (base, k)
+                        t.action = c.findtext('action')
+                        t.actionFun = '%s_%d' % (base, k)
+                        if c.get('target') is not None:
+                            t.target = self._target(c, t.path)
+                        self._add(t)
+                        chain.append(t)
+                for a, b in zip(chain, chain[1:]):
+                    if a.guard is None:
+                        raise GenError('%s: unreachable branch' % b.path)
+                    a.next = b.idx
+                for sig in trigs:
+                    if sig in s.sigs:
+                        raise GenError('%s: duplicate trigger' % path)
+                    s.sigs[sig] = chain[0].idx
+                    s.chains.append((sig, chain))
+            self._trans(s)
+
+    # precomputing the tables ...............................................
+    def dispatch(self, s, sig):
+        """the first transition for the signal in s or its superstates"""
+        for a in s.ancestors():
+            if sig in a.sigs:
+                return a.sigs[sig]
+        return 0
+
+    def _resolve(self):
+        self.sigs = []
+        for s in self.states:
+            for sig in s.sigs:
+                if sig not in self.sigs:
+                    self.sigs.append(sig)
+            for sig, chain in s.chains:
+                if chain[-1].guard is not None:  # last branch guarded?
+                    chain[-1].next = self.dispatch(s.parent, sig)
+        if len(self.states) > 255:
+            raise GenError('%s: too many states' % self.path)
+
+        self.paths = []
+        known = {}
+        for t in self.trans[1:]:
+            if t.target is None:
+                continue
+            S, T = t.source, t.target
+            anc = list(T.ancestors())
+            if S in anc[1:]:  # source is a superstate of the target?
+                stop = S
+            else:
+                stop = S.parent
+                while stop not in anc:
+                    stop = stop.parent
+            t.stop = stop
+            t.entries = [a for a in reversed(anc[:anc.index(stop)])
+                         if a.entry is not None]
+            key = tuple(a.idx for a in t.entries)
+            if key and key not in known:
+                known[key] = len(self.paths)
+                self.paths.extend(key)
+            t.pathIdx = known.get(key, 0)
+
+    # code generation .......................................................
+    def declare(self):
+        sup = self.cls.get('superclass')
+        if sup not in ('qpc::QHsm', 'qpc::QActive'):
+            raise GenError('%s: superclass %s is not supported'
+                           % (self.path, sup))
+        out = [hdr(self.path), 'typedef struct %s {' % self.name,
+               '/* protected: */', '    %s super;' % sup.split('::')[1]]
+        vis = 0x01
+        for a in self.attrs(False):
+            v = int(a.get('visibility'), 16)
+            if v != vis:
+                vis = v
+                out.append('\n/* %s: */' % ('public', 'protected',
+                                            'private')[v])
+            typ = a.get('type')
+            out.append('    %s %s;' % (typ, a.get('name'))
+                       if not typ.endswith('*') else
+                       '    %s%s;' % (typ, a.get('name')))
+        out.append('} %s;' % self.name)
+        out += ['extern %s;' % attr_decl(a, self.name)
+                for a in self.attrs(True)]
+        ops = [op_proto(o, self.name) + ';'
+               for o in self.cls.findall('operation')]
+        if ops:
+            out += [''] + ops
+        out += ['', '/* the constant tables of the state machine */',
+                'extern QTsmTable const %s_table;' % self.name]
+        return '\n'.join(out)
+
+    def attrs(self, static):
+        return [a for a in self.cls.findall('attribute')
+                if bool(int(a.get('properties'), 16) & 0x01) == static]
+
+    def _fun(self, name, code, par='e', ret='void', pre=()):
+        body = code.strip('\n') if code and code.strip() else ''
+        lines = []
+        if not re.search(r'\bme\b', body):
+            lines.append('(void)me; /* unused parameter */')
+        if not re.search(r'\b%s\b' % par, body):
+            lines.append('(void)%s; /* unused parameter */' % par)
+        lines += list(pre)
+        if body:
+            lines.append(body)
+        ptype = 'void const * const' if par == 'par' \
+            else 'QEvt const * const'
+        return '%s %s(%s * const me, %s %s) {\n%s\n}\n' % (
+            'static ' + ret, name, self.name, ptype, par,
+            indent('\n'.join(lines)))
+
+    def define(self):
+        n = self.name
+        out = [hdr(self.path)]
+        out += ['%s;' % attr_decl(a, n) for a in self.attrs(True)]
+        for o in self.cls.findall('operation'):
+            out.append('\n' + hdr('%s::%s' % (self.path, o.get('name'))))
+            out.append(op_def(o, n))
+        out.append('\n' + hdr(self.path + '::SM'))
+
+        # actions and guards of every state...
+        for s in self.states[1:]:
+            out.append(hdr('%s::SM::%s' % (self.path, s.path)))
+            out.append(self._fun('%s_%s' % (n, s.name), s.entry, pre=(
+                () if s.entry is not None else
+                ('/* no entry action (identifies the state only) */',))))
+            if s.exit is not None:
+                out.append(self._fun('%s_%s_exit' % (n, s.name), s.exit))
+            for t in self.trans[2:]:
+                if t.source is not s:
+                    continue
+                out.append(hdr('%s::SM::%s' % (self.path, t.path)))
+                if t.guard is not None:
+                    out.append(self._fun(t.guardFun,
+                                         'return (%s);' % t.guard,
+                                         ret='bool'))
+                if t.action:
+                    out.append(self._fun(t.actionFun, t.action))
+                else:
+                    t.actionFun = None
+        out.append(hdr('%s::SM::initial' % self.path))
+        out.append(self._fun(self.topInit.actionFun,
+            (self.topInit.action or '') + '\n\n' +
+            '\n'.join('QS_FUN_DICTIONARY(&%s_%s);' % (n, s.name)
+                      for s in self.states[1:]), par='par'))
+
+        # tables...
+        out.append(hdr('%s::SM::tables' % self.path))
+        out.append('static QTsmState const %s_states[%d] = {'
+                   % (n, len(self.states)))
+        rows = []
+        for s in self.states:
+            ent = '(QTsmAction)&%s_%s' % (n, s.name) if s.parent \
+                else '(QTsmAction)0'
+            ext = '(QTsmAction)&%s_%s_exit' % (n, s.name) \
+                if s.exit is not None else '(QTsmAction)0'
+            rows.append('    /* %d: %s */\n    { %s, %s, %dU, %dU }'
+                        % (s.idx, s.path if s.parent else 'top', ent, ext,
+                           s.parent.idx if s.parent else 0, s.init))
+        out.append(',\n'.join(rows) + '\n};\n')
+
+        out.append('static QTsmTran const %s_trans[%d] = {'
+                   % (n, len(self.trans)))
+        rows = ['    /* 0: not used */\n'
+                '    { (QTsmGuard)0, (QTsmAction)0, 0U, 0U, 0U, 0U, 0U, 0U }']
+        for t in self.trans[1:]:
+            g = '(QTsmGuard)&%s' % t.guardFun if t.guard is not None \
+                else '(QTsmGuard)0'
+            a = '(QTsmAction)&%s' % t.actionFun if t.actionFun \
+                else '(QTsmAction)0'
+            rows.append('    /* %d: %s */\n'
+                        '    { %s, %s, %dU, %dU, %dU, %dU, %dU, %dU }' % (
+                            t.idx, comment(t.path), g, a, t.pathIdx,
+                            len(t.entries), t.source.idx,
+                            t.target.idx if t.target else 0,
+                            t.stop.idx if t.stop else 0, t.next))
+        out.append(',\n'.join(rows) + '\n};\n')
+
+        paths = self.paths or [0]
+        out.append('static uint8_t const %s_paths[%d] = {' % (n, len(paths)))
+        out.append(indent(re.sub(r'((?:\d+U, ){12})', lambda m:
+                   m.group(1).rstrip() + '\n',
+                   ', '.join('%dU' % p for p in paths))))
+        out.append('};\n')
+
+        out.append('static uint8_t const %s_dispatch[%d][%s] = {'
+                   % (n, len(self.states), self.nSigs))
+        rows = []
+        for s in self.states[1:]:
+            cols = ['[%s_SIG - Q_USER_SIG] = %dU' % (sig, self.dispatch(s, sig))
+                    for sig in self.sigs if self.dispatch(s, sig) != 0]
+            rows.append('    [%d] = { /* %s */\n%s\n    }'
+                        % (s.idx, s.path, indent(',\n'.join(cols), 8))
+                        if cols else '    [%d] = { 0U } /* %s */'
+                        % (s.idx, s.path))
+        out.append(',\n'.join(rows) + '\n};\n')
+
+        out.append('QTsmTable const %s_table = {' % n)
+        out.append('    &%s_states[0],\n    &%s_trans[0],\n    &%s_paths[0],'
+                   % (n, n, n))
+        out.append('    &%s_dispatch[0][0],\n    (uint16_t)(%s)\n};'
+                   % (n, self.nSigs))
+        return '\n'.join(out)
+
+
+CTOR_RE = re.compile(r'\b(QHsm|QActive)_ctor\(\s*([^,]+?)\s*,\s*'
+                     r'Q_STATE_CAST\(\s*&(\w+)_initial\s*\)\s*\)')
+
+
+def ctor(code):
+    return CTOR_RE.sub(lambda m: '%s_ctor(%s, &%s_table)' % (
+        'QTsm' if m.group(1) == 'QHsm' else 'QTActive',
+        m.group(2), m.group(3)), code)
+
+
+def attr_decl(a, cls=None, code=False):
+    typ = a.get('type')
+    name = a.get('name') if cls is None \
+        else '%s_%s' % (cls, a.get('name'))
+    init = (a.findtext('code') or '').strip() if code else ''
+    return '%s%s%s%s' % (typ, '' if typ.endswith('*') else ' ', name,
+                         (' ' + init.rstrip(';')) if init else '')
+
+
+def op_params(o, cls):
+    pars = ['%s%s%s' % (p.get('type'),
+                        '' if p.get('type').endswith('*') else ' ',
+                        p.get('name')) for p in o.findall('parameter')]
+    if cls is not None and not (int(o.get('properties'), 16) & 0x01):
+        const = ' const' if o.findtext('specifiers', '').strip() == 'const' \
+            else ''
+        pars.insert(0, '%s%s * const me' % (cls, const))
+    return pars
+
+
+def op_proto(o, cls=None):
+    name = o.get('name') if cls is None else '%s_%s' % (cls, o.get('name'))
+    typ = o.get('type')
+    pars = op_params(o, cls)
+    return '%s%s%s(%s)' % (typ, '' if typ.endswith('*') else ' ', name,
+                           ', '.join(pars) if pars else 'void')
+
+
+def op_def(o, cls=None):
+    return '%s {\n%s\n}' % (op_proto(o, cls), indent(ctor(o.findtext(
+        'code') or '')))
+
+
+def plain_class(elem, path, kind):
+    """declaration/definition of a class without a state machine"""
+    name = elem.get('name')
+    sup = elem.get('superclass')
+    if kind == 'define':
+        out = [hdr(path)]
+        out += ['%s;' % attr_decl(a, name, code=True)
+                for a in elem.findall('attribute')
+                if int(a.get('properties'), 16) & 0x01]
+        for o in elem.findall('operation'):
+            out.append('\n' + hdr('%s::%s' % (path, o.get('name'))))
+            out.append(op_def(o, name))
+        return '\n'.join(out)
+    out = [hdr(path), 'typedef struct %s {' % name]
+    if sup:
+        out += ['/* protected: */', '    %s super;' % sup.split('::')[-1]]
+    vis = 0x01 if sup else None
+    for a in elem.findall('attribute'):
+        if int(a.get('properties'), 16) & 0x01:
+            continue
+        v = int(a.get('visibility'), 16)
+        if v != vis:
+            vis = v
+            out.append(('\n' if len(out) > 2 else '') + '/* %s: */'
+                       % ('public', 'protected', 'private')[v])
+        out.append('    %s;' % attr_decl(a))
+    out.append('} %s;' % name)
+    out += ['extern %s;' % attr_decl(a, name)
+            for a in elem.findall('attribute')
+            if int(a.get('properties'), 16) & 0x01]
+    ops = [op_proto(o, name) + ';' for o in elem.findall('operation')]
+    if ops:
+        out += [''] + ops
+    return '\n'.join(out)
+
+
+def generate(model, fname, nSigs):
+    tree = ET.parse(model)
+    root = tree.getroot()
+    parents = {c: p for p in root.iter() for c in p}
+
+    # index the model elements by their paths...
+    elems = {}
+    files = {}
+
+    def walk(elem, path):
+        for c in elem:
+            name = c.get('name')
+            if c.tag in ('package', 'class', 'operation', 'attribute'):
+                p = name if path is None else path + '::' + name
+                elems[p] = (c, path)
+                if c.tag == 'package':
+                    walk(c, p)
+            elif c.tag == 'directory':
+                walk(c, path)
+            elif c.tag == 'file':
+                files[name] = c
+    walk(root, None)
+    if fname not in files:
+        raise GenError('file %s not found in %s' % (fname, model))
+
+    sms = {}
+
+    def expand(m):
+        kind, name = m.group(1), m.group(2) or m.group(3)
+        if name not in elems:
+            raise GenError('element %s not found' % name)
+        elem, pkg = elems[name]
+        if elem.tag == 'class':
+            if elem.find('statechart') is None:
+                return plain_class(elem, name, kind)
+            if name not in sms:
+                sms[name] = StateMachine(elem, pkg, parents)
+                sms[name].nSigs = nSigs
+            sm = sms[name]
+            return sm.declare() if kind == 'declare' else sm.define()
+        if elem.tag == 'operation':
+            if kind == 'declare':
+                return '%s\n%s;' % (hdr(name), op_proto(elem))
+            return '%s\n%s' % (hdr(name), op_def(elem))
+        if elem.tag == 'attribute':
+            if kind == 'declare':
+                return '%s\nextern %s;' % (hdr(name), attr_decl(elem))
+            return '%s\n%s;' % (hdr(name), attr_decl(elem, code=True))
+        raise GenError('%s: $%s not supported' % (name, kind))
+
+    text = files[fname].findtext('text')
+    text = re.sub(r'\$(declare|define)\s*(?:\$\{([^}]*)\}|\(([^)]*)\))',
+                  expand, text)
+    text = ctor(text)  # constructors coded directly in the file template
+    head = ('/*' + '*' * 76 + '\n'
+            '* Table-driven state machine code (see QTsm) for the file: %s\n'
+            '* generated by qtsmgen.py %s from the model: %s\n'
+            '*\n'
+            '* DO NOT EDIT THIS FILE MANUALLY. All your changes will be lost.\n'
+            + '*' * 77 + '/\n') % (fname, VERSION, model.split('/')[-1])
+    return head + text.rstrip('\n') + '\n'
+
+
+def main():
+    ap = argparse.ArgumentParser(
+        description='QTsm table generator for the QP/C framework')
+    ap.add_argument('model', help='QM model file (.qm)')
+    ap.add_argument('file', help='name of the file template in the model')
+    ap.add_argument('-o', '--output', help='output file (default: stdout)')
+    ap.add_argument('-s', '--sigs', default='MAX_SIG - Q_USER_SIG',
+                    help='number of signals per state (C expression)')
+    args = ap.parse_args()
+    try:
+        code = generate(args.model, args.file, args.sigs)
+    except GenError as ex:
+        sys.stderr.write('qtsmgen: error: %s\n' % ex)
+        return 1
+    if args.output:
+        with open(args.output, 'w') as f:
+            f.write(code)
+    else:
+        sys.stdout.write(code)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
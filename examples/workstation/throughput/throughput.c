@@ -0,0 +1,277 @@
+/*****************************************************************************
+* Product: Event throughput benchmark for the POSIX port
+* Last updated for version 7.1.1
+* Last updated on  2022-10-18
+*
+*                    Q u a n t u m  L e a P s
+*                    ------------------------
+*                    Modern Embedded Software
+*
+* Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <www.gnu.org/licenses/>.
+*
+* Contact information:
+* <www.state-machine.com/licensing>
+* <info@state-machine.com>
+*****************************************************************************/
+#define _POSIX_C_SOURCE 200809L /* for clock_gettime() */
+#ifdef __linux__
+    #define _GNU_SOURCE /* for cpu_set_t */
+#endif
+
+#include "qpc.h"
+
+#include "safe_std.h" /* portable "safe" <stdio.h>/<string.h> facilities */
+#include <stdlib.h>   /* for exit() and atoi() */
+#include <time.h>     /* for clock_gettime() */
+#include <sched.h>    /* for sched_get_priority_max() and cpu_set_t */
+#include <unistd.h>   /* for sysconf() */
+
+Q_DEFINE_THIS_FILE
+
+#ifdef Q_SPY
+    #error The throughput benchmark does not provide Spy build configuration
+#endif
+
+enum ThroughputSignals {
+    PING_SIG = Q_USER_SIG,
+    MAX_SIG
+};
+
+enum {
+    BSP_TICKS_PER_SEC = 100,
+    MAX_PAIRS  = (QF_MAX_ACTIVE / 2U) - 1U, /* pairs of active objects */
+    WINDOW     = 8,  /* events in flight between the two AOs of a pair */
+    DRAIN_TICKS = 10 /* ticks to drain the events before stopping */
+};
+
+#ifdef QF_EPOOL_MAG_SIZE
+/* free events cached by every AO thread and the main thread */
+#define POOL_CACHED ((2U * MAX_PAIRS + 1U) * QF_EPOOL_MAG_SIZE)
+#else
+#define POOL_CACHED 0U
+#endif
+
+/* Peer active object ======================================================*/
+typedef struct {
+    QActive super;       /* inherits QActive */
+
+    QActive *peer;       /* the other AO of the pair */
+    uint32_t volatile nEvts; /* number of events received */
+} Peer;
+
+static QState Peer_initial(Peer * const me, void const * const par);
+static QState Peer_active (Peer * const me, QEvt const * const e);
+
+static Peer l_peer[2 * MAX_PAIRS];
+static bool volatile l_done; /* stop forwarding the events */
+
+/*..........................................................................*/
+static void Peer_ctor(Peer * const me, QActive * const peer) {
+    QActive_ctor(&me->super, Q_STATE_CAST(&Peer_initial));
+    me->peer  = peer;
+    me->nEvts = 0U;
+}
+/*..........................................................................*/
+static QState Peer_initial(Peer * const me, void const * const par) {
+    (void)me;  /* unused parameter */
+    (void)par; /* unused parameter */
+    return Q_TRAN(&Peer_active);
+}
+/*..........................................................................*/
+static QState Peer_active(Peer * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case PING_SIG: {
+            ++me->nEvts;
+            if (!l_done) { /* still measuring? */
+                /* return a new dynamic event, which exercises the
+                * event pool, the queue of the peer and the garbage
+                * collection of the received event. The peer is the only
+                * recipient, so the event is moved to it.
+                */
+                QEvt *pe = Q_NEW(QEvt, PING_SIG);
+                QACTIVE_POST_MOVE(me->peer, pe, me);
+            }
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status_;
+}
+
+/* measurement =============================================================*/
+static uint_fast8_t l_nPairs = 1U;
+static uint32_t l_nTicks = 2U * BSP_TICKS_PER_SEC;
+static struct timespec l_start;
+
+/*..........................................................................*/
+static uint64_t countEvts(void) {
+    uint64_t sum = 0U;
+    for (uint_fast8_t n = 0U; n < 2U * l_nPairs; ++n) {
+        sum += l_peer[n].nEvts;
+    }
+    return sum;
+}
+/*..........................................................................*/
+static void report(void) {
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    uint64_t const nEvts = countEvts();
+    double const sec = (double)(end.tv_sec - l_start.tv_sec)
+                       + ((double)(end.tv_nsec - l_start.tv_nsec) * 1e-9);
+#if (defined QF_FUTEX_WAIT)
+    char const * const crit = "futex";
+#elif (defined QF_MPSC_EQUEUE)
+    char const * const crit = "mpsc";
+#elif (defined QF_OBJ_CRIT)
+    char const * const crit = "obj";
+#else
+    char const * const crit = "global";
+#endif
+#if (defined QF_EPOOL_MAG_SIZE) && (defined QF_MPOOL_LOCKFREE)
+    char const * const pool = "+mag+lfpool";
+#elif (defined QF_EPOOL_MAG_SIZE)
+    char const * const pool = "+mag";
+#elif (defined QF_MPOOL_LOCKFREE)
+    char const * const pool = "+lfpool";
+#else
+    char const * const pool = "";
+#endif
+#ifdef QF_ACTQ_BATCH
+    char const * const batch = "+batch";
+#else
+    char const * const batch = "";
+#endif
+    PRINTF_S("crit=%s%s%s pairs=%u evts=%llu sec=%.3f evts/sec=%.0f\n",
+             crit, pool, batch, (unsigned)l_nPairs,
+             (unsigned long long)nEvts, sec, (double)nEvts / sec);
+#ifdef QF_FUTEX_WAIT
+    QF_WaitStats sum = { 0U, 0U, 0U };
+    for (uint_fast8_t n = 0U; n < 2U * l_nPairs; ++n) {
+        QF_WaitStats stats;
+        QF_getWaitStats(l_peer[n].super.prio, &stats);
+        sum.spin  += stats.spin;
+        sum.yield += stats.yield;
+        sum.block += stats.block;
+    }
+    PRINTF_S("  waits: spin=%u yield=%u block=%u\n",
+             (unsigned)sum.spin, (unsigned)sum.yield, (unsigned)sum.block);
+#endif
+}
+
+/* QF callbacks ============================================================*/
+void Q_onAssert(char const * const module, int loc) {
+    FPRINTF_S(stderr, "Assertion failed in %s:%d\n", module, loc);
+    exit(-1);
+}
+/*..........................................................................*/
+void QF_onStartup(void) {
+    /* the ticker must preempt the AOs, which never block in this test */
+    QF_setTickRate(BSP_TICKS_PER_SEC, sched_get_priority_max(SCHED_FIFO));
+    clock_gettime(CLOCK_MONOTONIC, &l_start);
+}
+/*..........................................................................*/
+void QF_onCleanup(void) {
+}
+/*..........................................................................*/
+void QF_onClockTick(void) {
+    static uint32_t ctr;
+    ++ctr;
+    if (ctr == l_nTicks) { /* measurement time elapsed? */
+        report();
+        l_done = true; /* let the AOs drain all events in flight */
+    }
+    else if (ctr == l_nTicks + DRAIN_TICKS) {
+        QF_stop();
+    }
+    else {
+        /* keep measuring */
+    }
+}
+
+/*..........................................................................*/
+int main(int argc, char *argv[]) {
+    static QEvt const *queueSto[2 * MAX_PAIRS][2 * WINDOW];
+    static QF_MPOOL_EL(QEvt) poolSto[(MAX_PAIRS * (WINDOW + 2)) + POOL_CACHED];
+    static char threadName[2 * MAX_PAIRS][16];
+#ifdef __linux__
+    static cpu_set_t cpuSet[MAX_PAIRS];
+#endif
+    bool pin = false;
+
+    /* usage: throughput [<pairs> [<seconds> [pin]]] */
+    if (argc > 1) {
+        int const n = atoi(argv[1]);
+        Q_REQUIRE((0 < n) && (n <= MAX_PAIRS));
+        l_nPairs = (uint_fast8_t)n;
+    }
+    if (argc > 2) {
+        int const sec = atoi(argv[2]);
+        Q_REQUIRE(sec > 0);
+        l_nTicks = (uint32_t)sec * BSP_TICKS_PER_SEC;
+    }
+    if (argc > 3) {
+        pin = (strcmp(argv[3], "pin") == 0);
+    }
+
+    QF_init(); /* initialize the framework */
+    QF_poolInit(poolSto, sizeof(poolSto), sizeof(poolSto[0]));
+
+    for (uint_fast8_t n = 0U; n < 2U * l_nPairs; ++n) {
+        Peer_ctor(&l_peer[n], &l_peer[n ^ 1U].super);
+    }
+    for (uint_fast8_t n = 0U; n < 2U * l_nPairs; ++n) {
+        /* name the AO threads for top, perf and ftrace */
+        SNPRINTF_S(threadName[n], sizeof(threadName[n]), "peer%u",
+                   (unsigned)n);
+        QActive_setAttr(&l_peer[n].super, THREAD_NAME_ATTR, threadName[n]);
+#ifdef __linux__
+        if (pin) { /* pin both AOs of a pair to the same CPU core? */
+            long const nCpus = sysconf(_SC_NPROCESSORS_ONLN);
+            CPU_ZERO(&cpuSet[n / 2U]);
+            CPU_SET((int)((long)(n / 2U) % nCpus), &cpuSet[n / 2U]);
+            QActive_setAttr(&l_peer[n].super, THREAD_AFFINITY_ATTR,
+                            &cpuSet[n / 2U]);
+        }
+#else
+        (void)pin; /* CPU affinity not supported */
+#endif
+        QACTIVE_START(&l_peer[n].super,
+                      n + 1U, /* QP priority */
+                      queueSto[n], Q_DIM(queueSto[n]),
+                      (void *)0, 0U, /* no stack */
+                      (void *)0);    /* no initialization parameter */
+    }
+
+    /* put the WINDOW events in flight in every pair */
+    for (uint_fast8_t n = 0U; n < 2U * l_nPairs; n += 2U) {
+        for (uint_fast8_t i = 0U; i < WINDOW; ++i) {
+            QEvt *pe = Q_NEW(QEvt, PING_SIG);
+            QACTIVE_POST_MOVE(&l_peer[n].super, pe, (void *)0);
+        }
+    }
+
+    return QF_run(); /* run the QF application */
+}
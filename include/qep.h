@@ -115,8 +115,74 @@ typedef double float64_t;
 #ifndef Q_SIGNAL_SIZE
 #define Q_SIGNAL_SIZE 2U
 #endif /* ndef Q_SIGNAL_SIZE */
+
+/*${QEP-config::Q_EVT_REF_CTR_SIZE} ........................................*/
+/*! The size (in bytes) of the reference counter of an event. Valid values:
+* 1U, 2U, or 4U; default 1U
+*
+* @details
+* This macro can be defined in the QEP port file (qep_port.h) or on the
+* command line to configure the ::QEvtRefCtr type. The default of 1 byte
+* limits the number of references to one dynamic event (e.g., the number
+* of event queues holding it) to 255. The QS trace records report only
+* the low byte of a wider counter.
+*/
+#ifndef Q_EVT_REF_CTR_SIZE
+#define Q_EVT_REF_CTR_SIZE 1U
+#endif /* ndef Q_EVT_REF_CTR_SIZE */
+
+/*${QEP-config::QHSM_SIG_MAP_HASH} .........................................*/
+/*! The number of the entries in the hash table of the states in the
+* ::QHsmSigMap. Valid values: powers of 2 up to 256U; default 64U
+*
+* @details
+* This macro can be defined in the QEP port file (qep_port.h) or on the
+* command line. Because the hash table is kept at most half full, the
+* number of the states registered in one ::QHsmSigMap is limited to
+* QHSM_SIG_MAP_HASH/2.
+*/
+#ifndef QHSM_SIG_MAP_HASH
+#define QHSM_SIG_MAP_HASH 64U
+#endif /* ndef QHSM_SIG_MAP_HASH */
+
+/*${QEP-config::QHSM_FARM_STATES} ..........................................*/
+/*! The maximum number of the groups of the instances in one ::QHsmFarm.
+* Valid values: 2U..256U; default 32U
+*
+* @details
+* This macro can be defined in the QEP port file (qep_port.h) or on the
+* command line. Every group collects the instances in one current state,
+* except the last group, which collects the instances in all the states
+* that do not fit in the other groups. A group is freed when its last
+* instance leaves it. The instances of the last group then move to the
+* free group with their next dispatch.
+*/
+#ifndef QHSM_FARM_STATES
+#define QHSM_FARM_STATES 32U
+#endif /* ndef QHSM_FARM_STATES */
+
+/*${QEP-config::QHSM_PROF_BUCKETS} .........................................*/
+/*! The number of the buckets in the histograms of the dispatch times in
+* the ::QHsmProf. Valid values: 2U..33U; default 16U
+*
+* @details
+* This macro can be defined in the QEP port file (qep_port.h) or on the
+* command line. The bucket 0 counts the dispatch times of 0, the bucket
+* `b` counts the times from 2^(b-1) to 2^b - 1, and the last bucket counts
+* all the longer times.
+*/
+#ifndef QHSM_PROF_BUCKETS
+#define QHSM_PROF_BUCKETS 16U
+#endif /* ndef QHSM_PROF_BUCKETS */
 /*$enddecl${QEP-config} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
 
+#if defined(Q_SPY) || defined(QHSM_PROFILER)
+/*! QM_ENTRY() and QM_EXIT() record the state in QHsm::temp (for the QS
+* software tracing and for the ::QHsmProf)
+*/
+#define QM_STATE_REC_
+#endif
+
 /*==========================================================================*/
 /*$declare${QEP} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
 
@@ -149,6 +215,26 @@ typedef uint8_t QSignal;
 typedef uint16_t QSignal;
 #endif /*  (Q_SIGNAL_SIZE == 4U) */
 
+/*${QEP::QEvtRefCtr} .......................................................*/
+/*! ::QEvtRefCtr represents the reference counter of a dynamic event
+*
+* @details
+* The size of the counter is configured by the macro #Q_EVT_REF_CTR_SIZE.
+*/
+#if (Q_EVT_REF_CTR_SIZE == 1U)
+typedef uint8_t QEvtRefCtr;
+#endif /*  (Q_EVT_REF_CTR_SIZE == 1U) */
+
+/*${QEP::QEvtRefCtr} .......................................................*/
+#if (Q_EVT_REF_CTR_SIZE == 2U)
+typedef uint16_t QEvtRefCtr;
+#endif /*  (Q_EVT_REF_CTR_SIZE == 2U) */
+
+/*${QEP::QEvtRefCtr} .......................................................*/
+#if (Q_EVT_REF_CTR_SIZE == 4U)
+typedef uint32_t QEvtRefCtr;
+#endif /*  (Q_EVT_REF_CTR_SIZE == 4U) */
+
 /*${QEP::QEvt} .............................................................*/
 /*! @brief Event class
 * @class QEvt
@@ -190,7 +276,21 @@ typedef struct {
     *
     * @tr{RQP003}
     */
-    uint8_t volatile refCtr_;
+    QEvtRefCtr volatile refCtr_;
+
+    /*! Moved-event flag (see QActive_postMove_())
+    * @private @memberof QEvt
+    *
+    * @details
+    * The flag is set when a new dynamic event is posted with
+    * QACTIVE_POST_MOVE() and cleared when the event is allocated. The flag
+    * exists only when the ownership transfer is enabled by the macro
+    * #QF_POST_MOVE, which must be defined the same way for the QP framework
+    * and the application.
+    */
+#ifdef QF_POST_MOVE
+    uint8_t moved_;
+#endif /* def QF_POST_MOVE */
 } QEvt;
 
 /* public: */
@@ -288,6 +388,91 @@ typedef struct QMTranActTable {
     QActionHandler const act[1]; /*!< array of actions */
 } QMTranActTable;
 
+/*${QEP::QTsmAction} .......................................................*/
+/*! Pointer to an action function of the ::QTsm state machine */
+typedef void (* QTsmAction )(void * const me, QEvt const * const e);
+
+/*${QEP::QTsmGuard} ........................................................*/
+/*! Pointer to a guard function of the ::QTsm state machine */
+typedef bool (* QTsmGuard )(void * const me, QEvt const * const e);
+
+/*${QEP::QTsmState} ........................................................*/
+/*! @brief State object for the ::QTsm class (Table-driven State Machine).
+*
+* @details
+* This class groups together the constant attributes of a ::QTsm state:
+* the entry and exit actions and the indices of the superstate and of the
+* initial transition in the ::QTsmTable.
+*
+* @note
+* The entry action is never NULL and also serves as the unique identifier
+* of the state (e.g., in the QS software tracing). A state without an entry
+* action in the model gets an empty one, which is left out from the entry
+* paths of the transitions. The state at index 0 in the ::QTsmTable is the
+* top state, whose initial transition is the top-most initial transition.
+*
+* @attention
+* The ::QTsmState class is only intended for the QTsm table generator and
+* should not be used in hand-crafted code.
+*/
+typedef struct QTsmState {
+    QTsmAction const entry; /*!< entry action (also identifies the state) */
+    QTsmAction const exit;  /*!< exit action (NULL if none) */
+    uint8_t const super;    /*!< index of the superstate */
+    uint8_t const init;     /*!< index of the initial transition (0 if none) */
+} QTsmState;
+
+/*${QEP::QTsmTran} .........................................................*/
+/*! @brief Transition object for the ::QTsm class (Table-driven State Machine).
+*
+* @details
+* Every transition has the precomputed "stop" state, up to which (but not
+* including) the current state configuration is exited, and the entry path
+* from the "stop" state down to the target, so the dispatching of an event
+* involves no discovery of the state hierarchy at all.
+*
+* A transition with a guard is followed by the transition to try next when
+* the guard evaluates to 'false', which is either the next branch of the
+* same choice or the transition inherited from the superstate.
+*
+* @attention
+* The ::QTsmTran class is only intended for the QTsm table generator and
+* should not be used in hand-crafted code.
+*/
+typedef struct QTsmTran {
+    QTsmGuard const guard;   /*!< guard condition (NULL if none) */
+    QTsmAction const action; /*!< transition action (NULL if none) */
+    uint16_t const path;     /*!< offset of the entry path in the paths[] */
+    uint8_t const nEntry;    /*!< number of the entry actions on the path */
+    uint8_t const source;    /*!< index of the source state */
+    uint8_t const target;    /*!< index of the target (0 for internal tran.) */
+    uint8_t const stop;      /*!< index of the first state not exited */
+    uint8_t const next;      /*!< transition tried when the guard fails */
+} QTsmTran;
+
+/*${QEP::QTsmTable} ........................................................*/
+/*! @brief Constant tables of the ::QTsm state machine.
+*
+* @details
+* The dispatch[] table holds one row of `nSigs` transition indices for
+* every state (including the top state at index 0), where the column is
+* the event signal minus #Q_USER_SIG. The rows already include the
+* transitions inherited from the superstates, so that the dispatching of
+* an event to the current state is a single table lookup. The index 0
+* means that the signal is not handled (ignored) in the given state.
+*
+* @attention
+* The ::QTsmTable class is only intended for the QTsm table generator and
+* should not be used in hand-crafted code.
+*/
+typedef struct QTsmTable {
+    QTsmState const *states;  /*!< states, where states[0] is the top state */
+    QTsmTran const *trans;    /*!< transitions, where trans[0] is not used */
+    uint8_t const *paths;     /*!< entry paths (outermost state first) */
+    uint8_t const *dispatch;  /*!< transition per [state][sig - Q_USER_SIG] */
+    uint16_t nSigs;           /*!< number of the signals in every row */
+} QTsmTable;
+
 /*${QEP::QHsmAttr} .........................................................*/
 /*! @brief Attribute of for the ::QHsm class (Hierarchical State Machine).
 *
@@ -301,6 +486,8 @@ union QHsmAttr {
     QXThreadHandler thr;         /*!< @private pointer to an thread-handler */
     QMTranActTable const *tatbl; /*!< @private transition-action table */
     struct QMState const *obj;   /*!< @private pointer to QMState object */
+    struct QTsmState const *tst; /*!< @private pointer to QTsmState object */
+    struct QTsmTable const *tbl; /*!< @private pointer to QTsmTable object */
 };
 
 /*${QEP::QHSM_MAX_NEST_DEPTH_} .............................................*/
@@ -320,6 +507,441 @@ enum QReservedSig {
     Q_USER_SIG       /*!< offset for the user signals (QP Application) */
 };
 
+/*${QEP::QHsmTranPath} .....................................................*/
+/*! @brief Transition path stored in the ::QHsmTranCache
+*
+* @details
+* The states exited and entered by a transition in a ::QHsm, which are
+* identified by the current state, the source and the target of the
+* transition. The current state is NULL for a nested initial transition.
+* Only the states below the least common ancestor (LCA) of the source and
+* the target are stored, up to #QHSM_MAX_NEST_DEPTH_ exits and entries.
+*/
+typedef struct {
+    QStateHandler cur; /*!< current state (NULL for initial transition) */
+    QStateHandler src; /*!< source of the transition */
+    QStateHandler tgt; /*!< target of the transition (NULL if entry unused) */
+    uint8_t nExit;     /*!< number of the states to exit */
+    uint8_t nEntry;    /*!< number of the states to enter */
+    QStateHandler exit[QHSM_MAX_NEST_DEPTH_];  /*!< states in exit order */
+    QStateHandler entry[QHSM_MAX_NEST_DEPTH_]; /*!< entry path (reversed) */
+} QHsmTranPath;
+
+/*${QEP::QHsmTranCache} ....................................................*/
+/*! @brief Transition-path cache for the ::QHsm state machines
+* @class QHsmTranCache
+*
+* @details
+* The QHsm event processor discovers the superstates on the path of every
+* transition by calling the state handlers with the reserved empty signal.
+* In deep state hierarchies, these discovery calls can take more time than
+* the exit and entry actions themselves. QHsmTranCache stores the exit and
+* entry sequences of a transition the first time the transition is taken,
+* so that the subsequent transitions only replay the cached path. The
+* exit, entry and initial actions and the QS trace records are the same
+* with or without the cache.
+*
+* The cache is a hash table with linear probing, which is keyed by the
+* current state, the source and the target of the transition. One cache
+* is typically shared by all instances of a given state machine class
+* (see QHsm_setTranCache()). The storage should provide more entries than
+* the number of the different transitions in that class, because a path is
+* evicted when the probed entries are all taken. A transition that exits
+* or enters more than #QHSM_MAX_NEST_DEPTH_ states below the LCA is not
+* cached and is taken the normal way every time. The cache is available
+* only when the macro #QHSM_TRAN_CACHE is defined.
+*
+* @note
+* The cached paths rely on the superstate of every state being fixed,
+* which means that the Q_SUPER() return must be unconditional.
+*
+* @note
+* The cache is not protected by any critical section. Therefore, a cache
+* must be shared only among state machines that cannot preempt each other,
+* such as the state machines of one active object, or all active objects
+* in the cooperative QV kernel.
+*
+* @usage
+* @code
+* static QHsmTranPath l_tranPathSto[32]; // must be a power of 2
+* static QHsmTranCache l_tranCache; // shared by all instances of MyHsm
+* . . .
+* QHsmTranCache_init(&l_tranCache, l_tranPathSto, Q_DIM(l_tranPathSto));
+* . . .
+* void MyHsm_ctor(MyHsm * const me) {
+*     QHsm_ctor(&me->super, Q_STATE_CAST(&MyHsm_initial));
+*     QHsm_setTranCache(&me->super, &l_tranCache);
+* }
+* @endcode
+*/
+typedef struct {
+/* private: */
+
+    /*! Storage for the cached transition paths
+    * @private @memberof QHsmTranCache
+    */
+    QHsmTranPath * sto;
+
+    /*! Number of the entries in the storage minus one
+    * @private @memberof QHsmTranCache
+    */
+    uint16_t mask;
+
+/* public: */
+
+    /*! Number of the transition paths discovered and stored
+    * @public @memberof QHsmTranCache
+    */
+    uint32_t nMiss;
+} QHsmTranCache;
+
+/* public: */
+
+/*! Initializes the transition-path cache
+* @public @memberof QHsmTranCache
+*
+* @param[in,out] me   pointer (see @ref oop)
+* @param[in]     sto  storage for the cached transition paths
+* @param[in]     size number of the ::QHsmTranPath entries in @p sto,
+*                     which must be a power of 2 (up to 0x10000)
+*
+* @note Must be called before the cache is attached to any state machine.
+*/
+#ifdef QHSM_TRAN_CACHE
+void QHsmTranCache_init(QHsmTranCache * const me,
+    QHsmTranPath * const sto,
+    uint_fast32_t const size);
+#endif /* def QHSM_TRAN_CACHE */
+
+/*${QEP::QHsmStateSigs} ....................................................*/
+/*! @brief Signals handled by a state, as registered in the ::QHsmSigMap
+*
+* @details
+* The list of the signals is terminated with 0 and can be in any order.
+* A state must list every user signal that it handles in any way,
+* including the signals handled only when a guard condition is true.
+* The NULL list means that the state might handle any signal.
+*/
+typedef struct {
+    QStateHandler state; /*!< the state-handler function */
+    QSignal const *sigs; /*!< signals handled by the state (0-terminated) */
+} QHsmStateSigs;
+
+/*${QEP::QHsmSigMap} .......................................................*/
+/*! @brief Signal routing map for the ::QHsm state machines
+* @class QHsmSigMap
+*
+* @details
+* The QHsm event processor passes every event that a state does not handle
+* to the superstate, and so on up the state hierarchy, by calling all the
+* state handlers on the way. In large state handlers and deep state
+* hierarchies, most of these calls only return Q_RET_SUPER. QHsmSigMap
+* compiles the signals registered for every state (see ::QHsmStateSigs)
+* into a dense [state][signal] route table, which gives the innermost state
+* (the state itself or its superstate) that handles the signal.
+* QHsm_dispatch_() then calls directly the state handler from the table and
+* skips the states that ignore the signal. The actions and the QS trace
+* records are the same with or without the map.
+*
+* The current state is looked up in a small hash table of the registered
+* state handlers. The events with the signals beyond the route table and
+* the events in the states not registered in the map are processed
+* hierarchically, as without the map. The route table is built once in
+* QHsmSigMap_init() and one map is typically shared by all instances of a
+* given state machine class (see QHsm_setSigMap()). The map is available
+* only when the macro #QHSM_SIG_MAP is defined.
+*
+* @note
+* The route table relies on the superstate of every state being fixed,
+* which means that the Q_SUPER() return must be unconditional.
+*
+* @usage
+* @code
+* static QSignal const l_s1_sigs[]  = { A_SIG, B_SIG, 0U };
+* static QSignal const l_s11_sigs[] = { B_SIG, C_SIG, 0U };
+* static QHsmStateSigs const l_states[] = {
+*     { Q_STATE_CAST(&MyHsm_s1),  l_s1_sigs  },
+*     { Q_STATE_CAST(&MyHsm_s11), l_s11_sigs }
+* };
+* static uint8_t l_route[Q_DIM(l_states)][MAX_SIG - Q_USER_SIG];
+* static QHsmSigMap l_sigMap; // shared by all instances of MyHsm
+* . . .
+* void MyHsm_ctor(MyHsm * const me) {
+*     QHsm_ctor(&me->super, Q_STATE_CAST(&MyHsm_initial));
+*     if (l_sigMap.states == (QHsmStateSigs const *)0) { // not built yet?
+*         QHsmSigMap_init(&l_sigMap, l_states, Q_DIM(l_states),
+*                         &l_route[0][0], MAX_SIG - Q_USER_SIG);
+*     }
+*     QHsm_setSigMap(&me->super, &l_sigMap);
+* }
+* @endcode
+*/
+typedef struct {
+/* private: */
+
+    /*! The registered states (rows of the route table)
+    * @private @memberof QHsmSigMap
+    */
+    QHsmStateSigs const * states;
+
+    /*! Route table [state][signal - Q_USER_SIG] of the handling states
+    * @private @memberof QHsmSigMap
+    */
+    uint8_t * route;
+
+    /*! Number of the signals in one row of the route table
+    * @private @memberof QHsmSigMap
+    */
+    uint16_t nSigs;
+
+    /*! Hash table of the states (index of the state plus one, 0 if unused)
+    * @private @memberof QHsmSigMap
+    */
+    uint8_t hash[QHSM_SIG_MAP_HASH];
+} QHsmSigMap;
+
+/* public: */
+
+/*! Initializes the signal routing map and builds the route table
+* @public @memberof QHsmSigMap
+*
+* @details
+* Discovers the superstates of the registered states and stores in the
+* route table the innermost state that handles every signal in every
+* state. The state handlers are called only with the reserved empty
+* signal (superstate queries).
+*
+* @param[in,out] me      pointer (see @ref oop)
+* @param[in]     states  the states with the signals they handle, which
+*                        must include all the superstates of every state
+*                        (up to, but not including, QHsm_top())
+* @param[in]     nStates number of the @p states (up to
+*                        QHSM_SIG_MAP_HASH/2)
+* @param[in]     route   storage for the route table of the
+*                        @p nStates x @p nSigs entries
+* @param[in]     nSigs   number of the routed signals, starting with
+*                        #Q_USER_SIG
+*
+* @note Must be called before the map is attached to any state machine.
+*/
+#ifdef QHSM_SIG_MAP
+void QHsmSigMap_init(QHsmSigMap * const me,
+    QHsmStateSigs const * const states,
+    uint_fast8_t const nStates,
+    uint8_t * const route,
+    uint_fast16_t const nSigs);
+#endif /* def QHSM_SIG_MAP */
+
+/* private: */
+
+/*! Finds the state to process a given signal in a given state
+* @private @memberof QHsmSigMap
+*
+* @param[in] me  pointer (see @ref oop)
+* @param[in] s   the state, in which the signal is processed
+* @param[in] sig the signal
+*
+* @returns
+* the innermost state handler (@p s or its superstate) that handles the
+* signal, QHsm_top() if no state handles it, or @p s if the state or the
+* signal are not in the map.
+*/
+#ifdef QHSM_SIG_MAP
+QStateHandler QHsmSigMap_route_(QHsmSigMap const * const me,
+    QStateHandler const s,
+    QSignal const sig);
+#endif /* def QHSM_SIG_MAP */
+
+/*${QEP::QHsmProfCtr} ......................................................*/
+/*! Time-stamp counter of the ::QHsmProf (CPU cycles, ns, or any other
+* unit provided by QHsmProf_onGetTime())
+*/
+typedef uint32_t QHsmProfCtr;
+
+/*${QEP::QHsmProfEntry} ....................................................*/
+/*! @brief Statistics of one (state, signal) pair in the ::QHsmProf
+*
+* @details
+* For the user signals, the entry describes the events dispatched in the
+* given current state. The dispatch times include all the state handlers
+* and the exit, entry and initial actions of the transition triggered by
+* the event. For the reserved signals #Q_ENTRY_SIG, #Q_EXIT_SIG and
+* #Q_INIT_SIG, the entry only counts the executed entry actions, exit
+* actions and initial transitions of the given state.
+*/
+typedef struct {
+    QStateHandler state; /*!< the (current) state (QMsm: its stateHandler) */
+    QSignal sig;         /*!< the signal */
+    uint32_t count;      /*!< number of the events or executed actions */
+    uint64_t total;      /*!< total dispatch time */
+    QHsmProfCtr min;     /*!< shortest dispatch time */
+    QHsmProfCtr max;     /*!< longest dispatch time */
+    uint32_t hist[QHSM_PROF_BUCKETS]; /*!< histogram of the log2 times */
+} QHsmProfEntry;
+
+/*${QEP::QHsmProf} .........................................................*/
+/*! @brief In-process dispatch profiler for the ::QHsm and ::QMsm
+* state machines
+* @class QHsmProf
+*
+* @details
+* QHsmProf measures how long the dispatching of every event takes and
+* accumulates the measurements per current state and signal (see
+* ::QHsmProfEntry), including the histograms of the dispatch times. It
+* also counts the exit, entry and initial actions executed in every state.
+* The profiler does not need the QS software tracing and produces no
+* output by itself. Instead, the application exports the summary table on
+* demand with QHsmProf_export().
+*
+* The time stamps are provided by the application in the callback
+* QHsmProf_onGetTime(). The profiler is a hash table with linear probing
+* in the storage provided by the application. The events in the (state,
+* signal) pairs that do not fit in the storage are only counted in
+* QHsmProf::lost. One profiler can be shared by several state machines
+* (see QHsm_setProf()). The profiler is available only when the macro
+* #QHSM_PROFILER is defined (for the whole application, because it also
+* changes the QM_ENTRY()/QM_EXIT() macros used in the ::QMsm state
+* machines).
+*
+* @note
+* The profiler is not protected by any critical section. Therefore, a
+* profiler must be shared only among state machines that cannot preempt
+* each other, and QHsmProf_export() must be called in the same thread or
+* active object as the profiled state machines.
+*
+* @usage
+* @code
+* static QHsmProfEntry l_profSto[64]; // must be a power of 2
+* static QHsmProf l_prof;
+* . . .
+* QHsmProf_init(&l_prof, l_profSto, Q_DIM(l_profSto));
+* QHsm_setProf(&l_myHsm.super, &l_prof);
+* . . .
+* QHsmProfEntry summary[64];
+* uint_fast16_t n = QHsmProf_export(&l_prof, summary, Q_DIM(summary));
+* @endcode
+*/
+typedef struct {
+/* private: */
+
+    /*! Storage for the entries
+    * @private @memberof QHsmProf
+    */
+    QHsmProfEntry * sto;
+
+    /*! Number of the entries in the storage minus one
+    * @private @memberof QHsmProf
+    */
+    uint16_t mask;
+
+/* public: */
+
+    /*! Number of the entries in use
+    * @public @memberof QHsmProf
+    */
+    uint16_t used;
+
+    /*! Number of the events and actions not recorded for lack of entries
+    * @public @memberof QHsmProf
+    */
+    uint32_t lost;
+} QHsmProf;
+
+/* public: */
+
+/*! Initializes the profiler and clears all its entries
+* @public @memberof QHsmProf
+*
+* @param[in,out] me   pointer (see @ref oop)
+* @param[in]     sto  storage for the entries
+* @param[in]     size number of the ::QHsmProfEntry entries in @p sto,
+*                     which must be a power of 2 (up to 0x10000)
+*
+* @note Can be called again to restart the profiling.
+*/
+#ifdef QHSM_PROFILER
+void QHsmProf_init(QHsmProf * const me,
+    QHsmProfEntry * const sto,
+    uint_fast32_t const size);
+#endif /* def QHSM_PROFILER */
+
+/*! Exports the summary table of the profiler
+* @public @memberof QHsmProf
+*
+* @details
+* Copies the entries in use to the provided table, sorted by the total
+* dispatch time in descending order (the action counters last).
+*
+* @param[in]  me  pointer (see @ref oop)
+* @param[out] dst the summary table
+* @param[in]  max the maximum number of the entries in @p dst
+*
+* @returns the number of the entries copied to @p dst
+*/
+#ifdef QHSM_PROFILER
+uint_fast16_t QHsmProf_export(QHsmProf const * const me,
+    QHsmProfEntry * const dst,
+    uint_fast16_t const max);
+#endif /* def QHSM_PROFILER */
+
+/*! Callback to obtain the current time stamp for the profiler
+* @static @public @memberof QHsmProf
+*
+* @details
+* Provided by the application, for example with a free-running CPU cycle
+* counter (such as DWT->CYCCNT on ARM Cortex-M) or clock_gettime() in ns.
+* The time stamps can wrap around, as long as a single dispatch takes less
+* than the full range of ::QHsmProfCtr.
+*/
+#ifdef QHSM_PROFILER
+QHsmProfCtr QHsmProf_onGetTime(void);
+#endif /* def QHSM_PROFILER */
+
+/* private: */
+
+/*! Finds (or allocates) the entry of a (state, signal) pair
+* @private @memberof QHsmProf
+*
+* @param[in,out] me    pointer (see @ref oop)
+* @param[in]     state the state
+* @param[in]     sig   the signal
+*
+* @returns the entry or NULL if the storage is full
+*/
+#ifdef QHSM_PROFILER
+QHsmProfEntry * QHsmProf_find_(QHsmProf * const me,
+    QStateHandler const state,
+    QSignal const sig);
+#endif /* def QHSM_PROFILER */
+
+/*! Records one dispatched event
+* @private @memberof QHsmProf
+*
+* @param[in,out] me    pointer (see @ref oop)
+* @param[in]     state the current state, in which the event was dispatched
+* @param[in]     sig   the signal of the event
+* @param[in]     dt    the dispatch time
+*/
+#ifdef QHSM_PROFILER
+void QHsmProf_dispatch_(QHsmProf * const me,
+    QStateHandler const state,
+    QSignal const sig,
+    QHsmProfCtr const dt);
+#endif /* def QHSM_PROFILER */
+
+/*! Counts one executed exit, entry or initial action
+* @private @memberof QHsmProf
+*
+* @param[in,out] me    pointer (see @ref oop)
+* @param[in]     state the state of the action
+* @param[in]     sig   #Q_ENTRY_SIG, #Q_EXIT_SIG or #Q_INIT_SIG
+*/
+#ifdef QHSM_PROFILER
+void QHsmProf_action_(QHsmProf * const me,
+    QStateHandler const state,
+    QSignal const sig);
+#endif /* def QHSM_PROFILER */
+
 /*${QEP::QHsm} .............................................................*/
 /*! @brief Hierarchical State Machine class
 * @class QHsm
@@ -369,6 +991,27 @@ typedef struct {
     * @private @memberof QHsm
     */
     union QHsmAttr temp;
+
+    /*! Transition-path cache (see ::QHsmTranCache)
+    * @private @memberof QHsm
+    */
+#ifdef QHSM_TRAN_CACHE
+    QHsmTranCache * tcache;
+#endif /* def QHSM_TRAN_CACHE */
+
+    /*! Signal routing map (see ::QHsmSigMap)
+    * @private @memberof QHsm
+    */
+#ifdef QHSM_SIG_MAP
+    QHsmSigMap const * smap;
+#endif /* def QHSM_SIG_MAP */
+
+    /*! Dispatch profiler (see ::QHsmProf)
+    * @private @memberof QHsm
+    */
+#ifdef QHSM_PROFILER
+    QHsmProf * prof;
+#endif /* def QHSM_PROFILER */
 } QHsm;
 
 /* public: */
@@ -435,6 +1078,63 @@ QStateHandler QHsm_state(QHsm * const me);
 QStateHandler QHsm_childState(QHsm * const me,
     QStateHandler const parent);
 
+/*! Attaches the transition-path cache to a ::QHsm
+* @public @memberof QHsm
+*
+* @details
+* Makes the state machine replay the exit and entry sequences of the
+* transitions cached in the given ::QHsmTranCache, instead of discovering
+* them with the superstate queries on every transition.
+*
+* @param[in,out] me    pointer (see @ref oop)
+* @param[in]     cache pointer to the initialized transition-path cache
+*                      or NULL to stop using the cache
+*
+* @note
+* Typically called in the constructor of the derived state machine, after
+* QHsm_ctor(). Must not be called in the middle of a transition.
+*/
+#ifdef QHSM_TRAN_CACHE
+void QHsm_setTranCache(QHsm * const me,
+    QHsmTranCache * const cache);
+#endif /* def QHSM_TRAN_CACHE */
+
+/*! Attaches the signal routing map to a ::QHsm
+* @public @memberof QHsm
+*
+* @details
+* Makes the state machine pass every event directly to the innermost
+* state that handles its signal, as given by the route table of the
+* ::QHsmSigMap, instead of to every state up the state hierarchy.
+*
+* @param[in,out] me  pointer (see @ref oop)
+* @param[in]     map pointer to the initialized signal routing map
+*                    or NULL to stop using the map
+*
+* @note
+* Typically called in the constructor of the derived state machine, after
+* QHsm_ctor(). Must not be called in the middle of a transition.
+*/
+#ifdef QHSM_SIG_MAP
+void QHsm_setSigMap(QHsm * const me,
+    QHsmSigMap const * const map);
+#endif /* def QHSM_SIG_MAP */
+
+/*! Attaches the dispatch profiler to a ::QHsm or ::QMsm
+* @public @memberof QHsm
+*
+* @param[in,out] me   pointer (see @ref oop)
+* @param[in]     prof pointer to the initialized profiler or NULL to stop
+*                     profiling the state machine
+*
+* @note
+* Can be called at any time, but not in the middle of a transition.
+*/
+#ifdef QHSM_PROFILER
+void QHsm_setProf(QHsm * const me,
+    QHsmProf * const prof);
+#endif /* def QHSM_PROFILER */
+
 /* protected: */
 
 /*! Protected "constructor" of ::QHsm
@@ -552,6 +1252,32 @@ int_fast8_t QHsm_tran_(QHsm * const me,
     QStateHandler path[QHSM_MAX_NEST_DEPTH_],
     uint_fast8_t const qs_id);
 
+/*! Helper function to execute the exits of a transition and to obtain
+* its entry path from the transition-path cache
+* @private @memberof QHsm
+*
+* @details
+* Looks up the transition in the ::QHsmTranCache attached to the state
+* machine and discovers and stores the transition path upon a cache miss.
+* Then executes the exit actions from the current state up to the LCA
+* and copies the entry path into the @p path parameter, exactly like
+* the exit loop in QHsm_dispatch_() followed by QHsm_tran_().
+*
+* @param[in,out] path array of pointers to state-handler functions, where
+*                     path[0] is the target, path[1] the current state
+*                     (NULL for a nested initial transition) and path[2]
+*                     the source of the transition
+* @param[in]     qs_id QS-id of this state machine (for QS local filter)
+*
+* @returns
+* the depth of the entry path stored in the @p path parameter.
+*/
+#ifdef QHSM_TRAN_CACHE
+int_fast8_t QHsm_tranPath_(QHsm * const me,
+    QStateHandler path[QHSM_MAX_NEST_DEPTH_],
+    uint_fast8_t const qs_id);
+#endif /* def QHSM_TRAN_CACHE */
+
 /*${QEP::QHsmVtable} .......................................................*/
 /*! @brief Virtual table for the ::QHsm class.
 *
@@ -803,6 +1529,405 @@ QState QMsm_enterHistory_(
     QHsm * const me,
     QMState const *const hist,
     uint_fast8_t const qs_id);
+
+/*${QEP::QTsm} .............................................................*/
+/*! @brief Table-driven state machine implementation strategy
+* @class QTsm
+* @extends QHsm
+*
+* @details
+* QTsm (Table-driven State Machine) is the third state machine
+* implementation strategy, next to ::QHsm and ::QMsm. The state hierarchy,
+* the dispatching of every signal in every state (with the inherited
+* transitions already flattened) and the exit/entry paths of all
+* transitions are compile-time constant tables (see ::QTsmTable), which
+* are generated from the same state machine model as the ::QHsm code.
+* Dispatching an event is then a single table lookup followed by the calls
+* to the actions, without any discovery of the state hierarchy at run time.
+*
+* The behavior, including the QS software tracing, is the same as for the
+* ::QHsm generated from the same model. However, history transitions are
+* not supported.
+*
+* @note
+* QTsm adds no attributes to the ::QHsm base class. The current state is
+* kept in the QHsm::state attribute and the pointer to the ::QTsmTable in
+* the QHsm::temp attribute. Therefore, a state machine is turned into a
+* QTsm just by calling QTsm_ctor() instead of QHsm_ctor() (or
+* QTActive_ctor() instead of QActive_ctor() for active objects).
+*
+* @usage
+* The following example illustrates the constructor of a state machine
+* with the ::QTsmTable generated by the QTsm table generator
+* (see examples/workstation/qtsmtst):
+* @code{c}
+* void QHsmTst_ctor(void) {
+*     QHsmTst *me = &l_sm;
+*     QTsm_ctor(&me->super, &QHsmTst_table);
+* }
+* @endcode
+*/
+typedef struct {
+/* protected: */
+    QHsm super;
+} QTsm;
+
+/* protected: */
+
+/*! Constructor of ::QTsm
+* @protected @memberof QTsm
+*
+* @details
+* Performs the first step of QTsm initialization by assigning the top
+* state to the currently active state and by hooking the ::QTsmTable
+* to the state machine.
+*
+* @param[in,out] me    pointer (see @ref oop)
+* @param[in]     table the constant tables of the state machine
+*
+* @note
+* Must be called only ONCE before QHSM_INIT().
+*
+* @note
+* Just like QMsm_ctor(), QTsm_ctor() does not call QHsm_ctor(), to avoid
+* pulling in the code for QHsm_init_() and QHsm_dispatch_().
+*/
+void QTsm_ctor(
+    QHsm * const me,
+    QTsmTable const * const table);
+
+/* public: */
+
+/*! Implementation of the top-most initial tran. in ::QTsm.
+* @private @memberof QTsm
+*
+* @details
+* Executes the top-most initial transition in a TSM.
+*
+* @param[in,out] me  pointer (see @ref oop)
+* @param[in]     e   pointer to an extra parameter (might be NULL)
+* @param[in]     qs_id QS-id of this state machine (for QS local filter)
+*
+* @note
+* This function should be called only via the virtual table (see
+* QHSM_INIT()) and should NOT be called directly in the applications.
+*/
+void QTsm_init_(
+    QHsm * const me,
+    void const * const e,
+    uint_fast8_t const qs_id);
+
+/* private: */
+
+/*! Implementation of dispatching events to a ::QTsm
+* @private @memberof QTsm
+*
+* @details
+* Dispatches an event for processing to a table-driven state machine.
+* The processing of an event represents one run-to-completion (RTC) step.
+*
+* @param[in,out] me pointer (see @ref oop)
+* @param[in]     e  pointer to the event to be dispatched to the TSM
+* @param[in]     qs_id QS-id of this state machine (for QS local filter)
+*
+* @note
+* This function should be called only via the virtual table (see
+* QHSM_DISPATCH()) and should NOT be called directly in the applications.
+*/
+void QTsm_dispatch_(
+    QHsm * const me,
+    QEvt const * const e,
+    uint_fast8_t const qs_id);
+
+/* public: */
+
+/*! Implementation of getting the state handler in a ::QTsm subclass
+* @public @memberof QTsm
+*
+* @details
+* The state is identified by its entry action (see ::QTsmState).
+*/
+#ifdef Q_SPY
+QStateHandler QTsm_getStateHandler_(QHsm * const me);
+#endif /* def Q_SPY */
+
+/* private: */
+
+/*! Enter the target of a transition and drill into its initial transitions
+* @private @memberof QTsm
+*
+* @details
+* Static helper function to execute the entry path of the given transition
+* followed by the initial transitions nested in the target state.
+*
+* @param[in,out] me    pointer (see @ref oop)
+* @param[in]     tran  pointer to the transition
+* @param[in]     qs_id QS-id of this state machine (for QS local filter)
+*
+* @returns
+* the new current (leaf) state of the state machine.
+*/
+QTsmState const * QTsm_enter_(
+    QHsm * const me,
+    QTsmTran const * tran,
+    uint_fast8_t const qs_id);
+
+/*${QEP::QHsmFarm} .........................................................*/
+/*! @brief Container of many instances of one ::QHsm state machine class
+* @class QHsmFarm
+*
+* @details
+* QHsmFarm holds a large number of small state machines of one class
+* (e.g., one per network session), which are managed by a single active
+* object. The instances are stored in one contiguous array and their
+* current states are mirrored in a separate, dense array of one-byte
+* group numbers (see #QHSM_FARM_STATES). An event can be dispatched to one
+* instance, to a given subset of the instances, or broadcast to all of
+* them. For a subset or a broadcast, the instances are first sorted by
+* their groups by scanning only the dense array. All the instances in one
+* group are then dispatched back to back, so the same state handlers run
+* over the whole group while they are hot in the caches and in the branch
+* predictors of the CPU. An instance changes its group only when the
+* dispatch changed its state.
+*
+* With the signal routing maps (#QHSM_SIG_MAP), each group is also
+* processed as a batch: the signal is routed in the common state of the
+* group only once (see ::QHsmSigMap) and when no state in its hierarchy
+* handles the signal, the whole group is skipped without calling any
+* state handler. All the instances must then share the same map, set by
+* QHsm_setSigMap() before QHsmFarm_init(). The skipped instances produce
+* the same QS trace records as QHsm_dispatch_() for an ignored event
+* (#QS_QEP_DISPATCH and #QS_QEP_IGNORED), but no ::QHsmProf samples.
+*
+* Every instance still runs its own state handlers. The grouping orders
+* the calls by the state and skips the groups that ignore the event, but
+* no state handler processes a whole group in one call.
+*
+* The instances are dispatched with QHsm_dispatch_() called directly
+* (without the virtual call through the QHsm::vptr). Therefore, all the
+* instances must be constructed with QHsm_ctor() and must not be ::QMsm
+* or ::QTsm state machines.
+*
+* @note
+* The order of dispatching the instances in a subset or a broadcast is
+* the order of the groups of the current states and not the order of the
+* instances. The state machines in a farm must not depend on the order of
+* processing the same event by the other instances.
+*
+* @usage
+* @code
+* static Session l_sessions[N_SESSIONS];
+* static uint8_t l_sessionGrps[N_SESSIONS];
+* static uint16_t l_sessionOrder[N_SESSIONS];
+* static QHsmFarm l_farm;
+* . . .
+* for (uint_fast16_t i = 0U; i < N_SESSIONS; ++i) {
+*     Session_ctor(&l_sessions[i]); // calls QHsm_ctor()
+* }
+* QHsmFarm_ctor(&l_farm, l_sessions, sizeof(Session), N_SESSIONS,
+*               l_sessionGrps, l_sessionOrder);
+* QHsmFarm_init(&l_farm, (void *)0, 0U);
+* . . .
+* QHsmFarm_broadcast(&l_farm, &tickEvt, 0U);
+* @endcode
+*/
+typedef struct {
+/* private: */
+
+    /*! Storage of the instances (the first instance)
+    * @private @memberof QHsmFarm
+    */
+    uint8_t * sto;
+
+    /*! Group of the current state of every instance
+    * @private @memberof QHsmFarm
+    */
+    uint8_t * grp;
+
+    /*! Indices of the dispatched instances grouped by the current state
+    * @private @memberof QHsmFarm
+    */
+    uint16_t * order;
+
+    /*! Size of one instance in bytes
+    * @private @memberof QHsmFarm
+    */
+    uint16_t stride;
+
+    /*! Number of the instances
+    * @private @memberof QHsmFarm
+    */
+    uint16_t n;
+
+    /*! Number of the groups in use (not counting the last group)
+    * @private @memberof QHsmFarm
+    */
+    uint8_t nGrp;
+
+    /*! Current state of the instances in every group
+    * @private @memberof QHsmFarm
+    */
+    QStateHandler grpState[QHSM_FARM_STATES];
+
+    /*! Number of the instances in every group
+    * @private @memberof QHsmFarm
+    */
+    uint16_t grpCnt[QHSM_FARM_STATES];
+
+    /*! Signal routing map shared by all the instances (see ::QHsmSigMap)
+    * @private @memberof QHsmFarm
+    */
+#ifdef QHSM_SIG_MAP
+    QHsmSigMap const * smap;
+#endif /* def QHSM_SIG_MAP */
+} QHsmFarm;
+
+/* public: */
+
+/*! Constructor of ::QHsmFarm
+* @public @memberof QHsmFarm
+*
+* @param[in,out] me       pointer (see @ref oop)
+* @param[in]     sto      array of the constructed instances (derived
+*                         from ::QHsm)
+* @param[in]     stride   size of one instance in bytes
+* @param[in]     n        number of the instances (up to 0xFFFF)
+* @param[in]     grpSto   storage for the @p n group numbers
+* @param[in]     orderSto scratch storage for @p n instance indices
+*/
+void QHsmFarm_ctor(QHsmFarm * const me,
+    void * const sto,
+    uint_fast16_t const stride,
+    uint_fast16_t const n,
+    uint8_t * const grpSto,
+    uint16_t * const orderSto);
+
+/*! Executes the top-most initial transitions of all the instances
+* @public @memberof QHsmFarm
+*
+* @param[in,out] me    pointer (see @ref oop)
+* @param[in]     par   pointer to an extra parameter (might be NULL)
+* @param[in]     qs_id QS-id of the instances (for QS local filter)
+*
+* @note Must be called only ONCE after QHsmFarm_ctor().
+*
+* @attention
+* With #QHSM_SIG_MAP, all the instances must have the same signal routing
+* map (or none), which this function asserts.
+*/
+void QHsmFarm_init(QHsmFarm * const me,
+    void const * const par,
+    uint_fast8_t const qs_id);
+
+/*! Dispatches an event to one instance in the ::QHsmFarm
+* @public @memberof QHsmFarm
+*
+* @param[in,out] me    pointer (see @ref oop)
+* @param[in]     e     pointer to the event to be dispatched
+* @param[in]     i     index of the instance
+* @param[in]     qs_id QS-id of the instances (for QS local filter)
+*/
+void QHsmFarm_dispatch(QHsmFarm * const me,
+    QEvt const * const e,
+    uint_fast16_t const i,
+    uint_fast8_t const qs_id);
+
+/*! Dispatches an event to a subset of the instances in the ::QHsmFarm
+* @public @memberof QHsmFarm
+*
+* @details
+* Sorts the given instances by the groups of their current states and
+* dispatches the event to the instances group by group.
+*
+* @param[in,out] me    pointer (see @ref oop)
+* @param[in]     e     pointer to the event to be dispatched
+* @param[in]     set   indices of the instances to dispatch the event to
+* @param[in]     nSet  number of the indices in @p set (up to the number
+*                      of the instances)
+* @param[in]     qs_id QS-id of the instances (for QS local filter)
+*/
+void QHsmFarm_dispatchSet(QHsmFarm * const me,
+    QEvt const * const e,
+    uint16_t const * const set,
+    uint_fast16_t const nSet,
+    uint_fast8_t const qs_id);
+
+/*! Dispatches an event to all the instances in the ::QHsmFarm
+* @public @memberof QHsmFarm
+*
+* @details
+* Sorts all the instances by the groups of their current states and
+* dispatches the event to the instances group by group.
+*
+* @param[in,out] me    pointer (see @ref oop)
+* @param[in]     e     pointer to the event to be dispatched
+* @param[in]     qs_id QS-id of the instances (for QS local filter)
+*/
+void QHsmFarm_broadcast(QHsmFarm * const me,
+    QEvt const * const e,
+    uint_fast8_t const qs_id);
+
+/*! Obtain an instance in the ::QHsmFarm
+* @public @memberof QHsmFarm
+*
+* @param[in] me pointer (see @ref oop)
+* @param[in] i  index of the instance
+*
+* @returns pointer to the instance @p i
+*/
+QHsm * QHsmFarm_inst(QHsmFarm * const me,
+    uint_fast16_t const i);
+
+/*! Obtain the current state of an instance in the ::QHsmFarm
+* @public @memberof QHsmFarm
+*
+* @param[in] me pointer (see @ref oop)
+* @param[in] i  index of the instance
+*
+* @returns the current state of the instance @p i
+*/
+QStateHandler QHsmFarm_state(QHsmFarm * const me,
+    uint_fast16_t const i);
+
+/* private: */
+
+/*! Finds (or allocates) the group of the given state
+* @private @memberof QHsmFarm
+*
+* @param[in,out] me    pointer (see @ref oop)
+* @param[in]     state the current state of an instance
+*
+* @returns the group number
+*/
+uint_fast8_t QHsmFarm_group_(QHsmFarm * const me,
+    QStateHandler const state);
+
+/*! Moves an instance to the group of its current state
+* @private @memberof QHsmFarm
+*
+* @details
+* The old group of the instance is freed when it becomes empty.
+*
+* @param[in,out] me    pointer (see @ref oop)
+* @param[in]     i     index of the instance
+*/
+void QHsmFarm_regroup_(QHsmFarm * const me,
+    uint_fast16_t const i);
+
+/*! Sorts the instances by their groups and dispatches an event
+* @private @memberof QHsmFarm
+*
+* @param[in,out] me    pointer (see @ref oop)
+* @param[in]     e     pointer to the event to be dispatched
+* @param[in]     set   indices of the instances or NULL for all instances
+* @param[in]     nSet  number of the instances to dispatch the event to
+* @param[in]     qs_id QS-id of the instances (for QS local filter)
+*/
+void QHsmFarm_dispatchGroups_(QHsmFarm * const me,
+    QEvt const * const e,
+    uint16_t const * const set,
+    uint_fast16_t const nSet,
+    uint_fast8_t const qs_id);
 /*$enddecl${QEP} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
 
 /*==========================================================================*/
@@ -1011,41 +2136,49 @@ QState QMsm_enterHistory_(
 #define Q_UINT2PTR_CAST(type_, uint_) ((type_ *)(uint_))
 
 /*${QEP-macros::QEVT_INITIALIZER} ..........................................*/
+#ifndef QF_POST_MOVE
 /*! Initializer of static constant QEvt instances
 *
 * @details
 * This macro encapsulates the ugly casting of enumerated signals
-* to QSignal and constants for QEvt.poolID and QEvt.refCtr_.
+* to QSignal and constants for QEvt.poolID and QEvt.refCtr_
+* (and QEvt.moved_ with #QF_POST_MOVE).
 */
 #define QEVT_INITIALIZER(sig_) { (QSignal)(sig_), 0U, 0U }
+#endif /* ndef QF_POST_MOVE */
+
+/*${QEP-macros::QEVT_INITIALIZER} ..........................................*/
+#ifdef QF_POST_MOVE
+#define QEVT_INITIALIZER(sig_) { (QSignal)(sig_), 0U, 0U, 0U }
+#endif /* def QF_POST_MOVE */
 
 /*${QEP-macros::QM_ENTRY} ..................................................*/
-#ifdef Q_SPY
+#ifdef QM_STATE_REC_
 /*! Macro to call in a QM action-handler when it executes
 * an entry action. Applicable only to ::QMsm subclasses.
 */
 #define QM_ENTRY(state_) \
     ((Q_HSM_UPCAST(me))->temp.obj = (state_), Q_RET_ENTRY)
-#endif /* def Q_SPY */
+#endif /* def QM_STATE_REC_ */
 
 /*${QEP-macros::QM_ENTRY} ..................................................*/
-#ifndef Q_SPY
+#ifndef QM_STATE_REC_
 #define QM_ENTRY(dummy) (Q_RET_ENTRY)
-#endif /* ndef Q_SPY */
+#endif /* ndef QM_STATE_REC_ */
 
 /*${QEP-macros::QM_EXIT} ...................................................*/
-#ifdef Q_SPY
+#ifdef QM_STATE_REC_
 /*! Macro to call in a QM action-handler when it executes
 * an exit action. Applicable only to ::QMsm subclasses.
 */
 #define QM_EXIT(state_) \
     ((Q_HSM_UPCAST(me))->temp.obj = (state_), Q_RET_EXIT)
-#endif /* def Q_SPY */
+#endif /* def QM_STATE_REC_ */
 
 /*${QEP-macros::QM_EXIT} ...................................................*/
-#ifndef Q_SPY
+#ifndef QM_STATE_REC_
 #define QM_EXIT(dummy) (Q_RET_EXIT)
-#endif /* ndef Q_SPY */
+#endif /* ndef QM_STATE_REC_ */
 
 /*${QEP-macros::QM_SM_EXIT} ................................................*/
 /*! Macro to call in a QM submachine exit-handler.
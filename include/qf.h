@@ -47,16 +47,26 @@
 
 /*${QF-config::QF_MAX_ACTIVE} ..............................................*/
 /*! Maximum number of active objects (configurable value in qf_port.h)
-* Valid values: [1U..64U]; default 32U
+* Valid values: [1U..1024U]; default 32U
+*
+* @note
+* More than 64U active objects are supported only by the QF ports with
+* the priority-set of more than two words (see ::QPSet), such as the
+* POSIX ports, and not with the QS software tracing.
 */
 #ifndef QF_MAX_ACTIVE
 #define QF_MAX_ACTIVE 32U
 #endif /* ndef QF_MAX_ACTIVE */
 
 /*${QF-config::QF_MAX_ACTIVE exceeds the maximu~} ..........................*/
-#if (QF_MAX_ACTIVE > 64U)
-#error QF_MAX_ACTIVE exceeds the maximum of 64U;
-#endif /*  (QF_MAX_ACTIVE > 64U) */
+#if (QF_MAX_ACTIVE > 1024U)
+#error QF_MAX_ACTIVE exceeds the maximum of 1024U;
+#endif /*  (QF_MAX_ACTIVE > 1024U) */
+
+/*${QF-config::QF_MAX_ACTIVE exceeds the maximu~} ..........................*/
+#if (QF_MAX_ACTIVE > 64U) && (defined Q_SPY)
+#error QF_MAX_ACTIVE exceeds the maximum of 64U with Q_SPY;
+#endif /*  (QF_MAX_ACTIVE > 64U) && (defined Q_SPY) */
 
 /*${QF-config::QF_MAX_TICK_RATE} ...........................................*/
 /*! Maximum number of clock rates (configurable value in qf_port.h)
@@ -73,20 +83,24 @@
 
 /*${QF-config::QF_MAX_EPOOL} ...............................................*/
 /*! Maximum number of event pools (configurable value in qf_port.h)
-* Valid values: [0U..15U]; default 3U
+* Valid values: [0U..63U]; default 3U
 *
 * @note
 * #QF_MAX_EPOOL set to zero means that dynamic events are NOT configured
 * and should not be used in the application.
+*
+* @note
+* The QS local filter IDs of the event pools above 15 overlap the IDs of
+* the event queues (::QS_EQ_ID) and of the application (::QS_AP_ID).
 */
 #ifndef QF_MAX_EPOOL
 #define QF_MAX_EPOOL 3U
 #endif /* ndef QF_MAX_EPOOL */
 
 /*${QF-config::QF_MAX_EPOOL exceeds the maximum~} ..........................*/
-#if (QF_MAX_EPOOL > 15U)
-#error QF_MAX_EPOOL exceeds the maximum of 15U;
-#endif /*  (QF_MAX_EPOOL > 15U) */
+#if (QF_MAX_EPOOL > 63U)
+#error QF_MAX_EPOOL exceeds the maximum of 63U;
+#endif /*  (QF_MAX_EPOOL > 63U) */
 
 /*${QF-config::QF_TIMEEVT_CTR_SIZE} ........................................*/
 /*! Size of the QTimeEvt counter (configurable value in qf_port.h)
@@ -101,6 +115,29 @@
 #error QF_TIMEEVT_CTR_SIZE defined incorrectly, expected 1U, 2U, or 4U;
 #endif /*  (QF_TIMEEVT_CTR_SIZE != 1U) && (QF_TIMEEVT_CTR_SIZE != 2U) && (QF_TIMEEVT_CTR_SIZE != 4U) */
 
+/*${QF-config::QF_TIMEEVT_WHEEL_BITS} ......................................*/
+/*! log2 of the number of slots in every level of the hierarchical timing
+* wheel (configurable value in qf_port.h), used only with #QF_TIMEEVT_WHEEL
+* Valid values: 1U..8U; default 6U (64 slots per level)
+*/
+#ifndef QF_TIMEEVT_WHEEL_BITS
+#define QF_TIMEEVT_WHEEL_BITS 6U
+#endif /* ndef QF_TIMEEVT_WHEEL_BITS */
+
+/*${QF-config::QF_TIMEEVT_WHEEL_BITS defined in~} ..........................*/
+#if (QF_TIMEEVT_WHEEL_BITS < 1U) || (QF_TIMEEVT_WHEEL_BITS > 8U)
+#error QF_TIMEEVT_WHEEL_BITS defined incorrectly, expected 1U..8U;
+#endif /*  (QF_TIMEEVT_WHEEL_BITS < 1U) || (QF_TIMEEVT_WHEEL_BITS > 8U) */
+
+/*${QF-config::QF_MAX_HRTIMER} .............................................*/
+/*! Maximum number of armed high-resolution time events ::QHrTimeEvt
+* (configurable value in qf_port.h)
+* Valid values: 0U..0xFFFFU; default 0U (no high-resolution time events)
+*/
+#ifndef QF_MAX_HRTIMER
+#define QF_MAX_HRTIMER 0U
+#endif /* ndef QF_MAX_HRTIMER */
+
 /*${QF-config::QF_EVENT_SIZ_SIZE} ..........................................*/
 /*! Size of the event-size (configurable value in qf_port.h)
 * Valid values: 1U, 2U, or 4U; default 2U
@@ -207,8 +244,19 @@ uint_fast8_t QF_LOG2(QPSetBits x);
 * When QP runs on top of 3rd-party kernels/RTOSes or general-purpose
 * operating systems, sthe second priority can have different meaning,
 * depending on the specific RTOS/GPOS used.
+*
+* @note
+* When #QF_MAX_ACTIVE exceeds 255U, each of the two priorities takes
+* 16 bits of the ::QPrioSpec data type.
 */
+#if (QF_MAX_ACTIVE <= 255U)
 typedef uint_fast16_t QPrioSpec;
+#endif /*  (QF_MAX_ACTIVE <= 255U) */
+
+/*${QF-types::QPrioSpec} ...................................................*/
+#if (255U < QF_MAX_ACTIVE)
+typedef uint_fast32_t QPrioSpec;
+#endif /*  (255U < QF_MAX_ACTIVE) */
 
 /*${QF-types::QSchedStatus} ................................................*/
 /*! The scheduler lock status used in some real-time kernels */
@@ -222,7 +270,13 @@ typedef uint_fast16_t QSchedStatus;
 * The priority set represents the set of active objects that are ready to
 * run and need to be considered by the scheduling algorithm. The set is
 * capable of storing up to #QF_MAX_ACTIVE priority levels, which can be
-* configured in the rage 1..64, inclusive.
+* configured in the rage 1..1024, inclusive.
+*
+* @note
+* For more than 64 elements, the priority set is a two-level bitmap of
+* 32-bit words with the summary word, which has a bit for each non-empty
+* word of the set. This keeps QPSet_findMax() O(1), with just two
+* QF_LOG2() operations (preferably hardware-accelerated, see #QF_LOG2).
 */
 typedef struct {
 /* public: */
@@ -233,9 +287,19 @@ typedef struct {
 #endif /*  (QF_MAX_ACTIVE <= 32) */
 
     /*! bitmasks with a bit for each element */
-#if (32 < QF_MAX_ACTIVE)
+#if (32 < QF_MAX_ACTIVE) && (QF_MAX_ACTIVE <= 64U)
     QPSetBits volatile bits[2];
-#endif /*  (32 < QF_MAX_ACTIVE) */
+#endif /*  (32 < QF_MAX_ACTIVE) && (QF_MAX_ACTIVE <= 64U) */
+
+    /*! summary bitmask with a bit for each non-empty bitmask in bits[] */
+#if (64U < QF_MAX_ACTIVE)
+    QPSetBits volatile summary;
+#endif /*  (64U < QF_MAX_ACTIVE) */
+
+    /*! bitmasks with a bit for each element (leaves of the summary) */
+#if (64U < QF_MAX_ACTIVE)
+    QPSetBits volatile bits[(QF_MAX_ACTIVE + 31U) / 32U];
+#endif /*  (64U < QF_MAX_ACTIVE) */
 } QPSet;
 
 /* public: */
@@ -244,9 +308,14 @@ typedef struct {
 static inline void QPSet_setEmpty(QPSet * const me) {
     #if (QF_MAX_ACTIVE <= 32)
         me->bits = 0U;
-    #else
+    #elif (QF_MAX_ACTIVE <= 64U)
         me->bits[0] = 0U;
         me->bits[1] = 0U;
+    #else
+        me->summary = 0U;
+        for (uint_fast8_t i = 0U; i < Q_DIM(me->bits); ++i) {
+            me->bits[i] = 0U;
+        }
     #endif
 }
 
@@ -254,8 +323,10 @@ static inline void QPSet_setEmpty(QPSet * const me) {
 static inline bool QPSet_isEmpty(QPSet const * const me) {
     #if (QF_MAX_ACTIVE <= 32)
         return (me->bits == 0U);
-    #else
+    #elif (QF_MAX_ACTIVE <= 64U)
         return (me->bits[0] == 0U) ? (me->bits[1] == 0U) : false;
+    #else
+        return (me->summary == 0U);
     #endif
 }
 
@@ -263,65 +334,85 @@ static inline bool QPSet_isEmpty(QPSet const * const me) {
 static inline bool QPSet_notEmpty(QPSet const * const me) {
     #if (QF_MAX_ACTIVE <= 32)
         return (me->bits != 0U);
-    #else
+    #elif (QF_MAX_ACTIVE <= 64U)
         return (me->bits[0] != 0U) ? true : (me->bits[1] != 0U);
+    #else
+        return (me->summary != 0U);
     #endif
 }
 
 /*! Return 'true' if the priority set has the element n. */
 static inline bool QPSet_hasElement(QPSet const * const me,
-    uint_fast8_t const n)
+    uint_fast16_t const n)
 {
     #if (QF_MAX_ACTIVE <= 32U)
         return (me->bits & (1U << (n - 1U))) != 0U;
-    #else
+    #elif (QF_MAX_ACTIVE <= 64U)
         return (n <= 32U)
         ? ((me->bits[0] & ((uint32_t)1U << (n - 1U))) != 0U)
         : ((me->bits[1] & ((uint32_t)1U << (n - 33U))) != 0U);
+    #else
+        return (me->bits[(n - 1U) >> 5U]
+                & ((uint32_t)1U << ((n - 1U) & 31U))) != 0U;
     #endif
 }
 
 /*! insert element `n` into the set (n = 1..::QF_MAX_ACTIVE) */
 static inline void QPSet_insert(QPSet * const me,
-    uint_fast8_t const n)
+    uint_fast16_t const n)
 {
     #if (QF_MAX_ACTIVE <= 32U)
         me->bits = (me->bits | (1U << (n - 1U)));
-    #else
+    #elif (QF_MAX_ACTIVE <= 64U)
         if (n <= 32U) {
             me->bits[0] = (me->bits[0] | ((uint32_t)1U << (n - 1U)));
         }
         else {
             me->bits[1] = (me->bits[1] | ((uint32_t)1U << (n - 33U)));
         }
+    #else
+        uint_fast16_t const w = (n - 1U) >> 5U; /* the word of n */
+        me->bits[w] = (me->bits[w] | ((uint32_t)1U << ((n - 1U) & 31U)));
+        me->summary = (me->summary | ((uint32_t)1U << w));
     #endif
 }
 
 /*! Remove element `n` from the set (n = 1U..::QF_MAX_ACTIVE) */
 static inline void QPSet_remove(QPSet * const me,
-    uint_fast8_t const n)
+    uint_fast16_t const n)
 {
     #if (QF_MAX_ACTIVE <= 32U)
         me->bits = (me->bits &
             (QPSetBits)(~((QPSetBits)1U << (n - 1U))));
-    #else
+    #elif (QF_MAX_ACTIVE <= 64U)
         if (n <= 32U) {
             (me->bits[0] = (me->bits[0] & ~((uint32_t)1U << (n - 1U))));
         }
         else {
             (me->bits[1] = (me->bits[1] & ~((uint32_t)1U << (n - 33U))));
         }
+    #else
+        uint_fast16_t const w = (n - 1U) >> 5U; /* the word of n */
+        me->bits[w] = (me->bits[w] & ~((uint32_t)1U << ((n - 1U) & 31U)));
+        if (me->bits[w] == 0U) { /* the word became empty? */
+            me->summary = (me->summary & ~((uint32_t)1U << w));
+        }
     #endif
 }
 
 /*! Find the maximum element in the set, returns zero if the set is empty */
-static inline uint_fast8_t QPSet_findMax(QPSet const * const me) {
+static inline uint_fast16_t QPSet_findMax(QPSet const * const me) {
     #if (QF_MAX_ACTIVE <= 32)
         return QF_LOG2(me->bits);
-    #else
+    #elif (QF_MAX_ACTIVE <= 64U)
         return (me->bits[1] != 0U)
             ? (QF_LOG2(me->bits[1]) + 32U)
             : (QF_LOG2(me->bits[0]));
+    #else
+        uint_fast16_t const s = QF_LOG2(me->summary);
+        return (s != 0U)
+            ? ((uint_fast16_t)((s - 1U) << 5U) + QF_LOG2(me->bits[s - 1U]))
+            : 0U;
     #endif
 }
 
@@ -334,6 +425,25 @@ static inline uint_fast8_t QPSet_findMax(QPSet const * const me) {
 * bit corresponds to the unique QF-priority of an AO (see ::QPrioSpec).
 */
 typedef QPSet QSubscrList;
+
+/*${QF-types::QSubscrEntry} ................................................*/
+/*! @brief Entry of the sparse subscriber table
+* @class QSubscrEntry
+*
+* @details
+* The sparse subscriber table (see QActive_psInitSparse()) is a hash table
+* of these entries, which holds the subscriber lists only for the signals
+* that have been subscribed to.
+*/
+typedef struct {
+/* public: */
+
+    /*! the AOs subscribed to the signal */
+    QSubscrList subscr;
+
+    /*! the signal of the entry (0 for an unused entry) */
+    QSignal sig;
+} QSubscrEntry;
 /*$enddecl${QF-types} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
 /*$declare${QF::QActive} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
 
@@ -421,13 +531,33 @@ typedef struct QActive {
     * @private @memberof QActive
     * @sa ::QPrioSpec
     */
+#if (QF_MAX_ACTIVE <= 255U)
     uint8_t prio;
+#endif /*  (QF_MAX_ACTIVE <= 255U) */
 
     /*! preemption-threshold [1..#QF_MAX_ACTIVE] of this AO.
     * @private @memberof QActive
     * @sa ::QPrioSpec
     */
+#if (QF_MAX_ACTIVE <= 255U)
     uint8_t pthre;
+#endif /*  (QF_MAX_ACTIVE <= 255U) */
+
+    /*! QF-priority [1..#QF_MAX_ACTIVE] of this AO.
+    * @private @memberof QActive
+    * @sa ::QPrioSpec
+    */
+#if (255U < QF_MAX_ACTIVE)
+    uint16_t prio;
+#endif /*  (255U < QF_MAX_ACTIVE) */
+
+    /*! preemption-threshold [1..#QF_MAX_ACTIVE] of this AO.
+    * @private @memberof QActive
+    * @sa ::QPrioSpec
+    */
+#if (255U < QF_MAX_ACTIVE)
+    uint16_t pthre;
+#endif /*  (255U < QF_MAX_ACTIVE) */
 
 /* private: */
 } QActive;
@@ -550,6 +680,47 @@ bool QActive_post_(QActive * const me,
 void QActive_postLIFO_(QActive * const me,
     QEvt const * const e);
 
+/*! Posts a new dynamic event `e` directly to the event queue of the active
+* object, transferring the ownership of the event to the recipient.
+* @private @memberof QActive
+*
+* @details
+* A dynamic event that has just been allocated with Q_NEW() is referenced
+* only by its creator. When the creator posts such event to a single
+* recipient and gives up the event, the recipient becomes the sole owner
+* of the event. The ownership transfer is enabled by defining the macro
+* #QF_POST_MOVE (for the QP framework and the application alike), which
+* adds the moved-event flag to ::QEvt. QActive_postMove_() then marks the
+* event as moved and the post sets the only reference of the recipient
+* with a plain store (instead of the atomic read-modify-write, see
+* #QF_EVT_REF_ATOMIC). With #QF_EVT_REF_ATOMIC, QF_gc() then recycles the
+* event without any read-modify-write of the reference counter. Without
+* #QF_POST_MOVE, QActive_postMove_() is an ordinary post of a new event.
+*
+* A moved event has exactly one consumer. The recipient can defer and
+* recall the event, but the event cannot be posted (FIFO) or published
+* again, and no new references to it can be created with Q_NEW_REF().
+* With #QF_POST_MOVE, these attempts assert (also for an alias of the
+* event still used by the sender), unless assertions are disabled
+* (#Q_NASSERT).
+*
+* @param[in] e      pointer to the new dynamic event to be posted
+* @param[in] sender pointer to a sender object (used in QS only)
+*
+* @attention
+* This function asserts internally if the posting fails.
+*
+* @note
+* This function should be called only through the macro
+* QACTIVE_POST_MOVE().
+*
+* @sa
+* QActive_post_()
+*/
+void QActive_postMove_(QActive * const me,
+    QEvt const * const e,
+    void const * const sender);
+
 /*! Get an event from the event queue of an active object
 * @private @memberof QActive
 *
@@ -571,6 +742,39 @@ void QActive_postLIFO_(QActive * const me,
 */
 QEvt const * QActive_get_(QActive * const me);
 
+/*! Get a batch of events from the event queue of an active object
+* @private @memberof QActive
+*
+* @details
+* This function is used instead of QActive_get_() by the QF ports, whose
+* event loop defines the macro #QF_ACTQ_BATCH. It waits for an event just
+* like QActive_get_(), but then removes up to @p max queued events in a
+* single critical section of the queue, so that the event loop can
+* dispatch and garbage-collect them without touching the queue again.
+* Every removed event produces the same QS_QF_ACTIVE_GET or
+* QS_QF_ACTIVE_GET_LAST trace record and the same update of the number
+* of free entries as if it was removed by QActive_get_().
+*
+* @param[in]     me   current instance pointer (see @ref oop)
+* @param[in,out] evts buffer for the removed events (at least @p max)
+* @param[in]     max  maximum number of events to remove (> 0)
+*
+* @returns
+* The number of the removed events (1..@p max), in the order they
+* would be returned by QActive_get_().
+*
+* @note
+* The removed events are no longer in the queue while the batch is
+* dispatched. Consequently, an event posted with QActive_postLIFO_()
+* (e.g., recalled by QActive_recall()) during the batch is dispatched only
+* after the remaining events of the batch.
+*/
+#ifdef QF_ACTQ_BATCH
+uint_fast16_t QActive_getBatch_(QActive * const me,
+    QEvt const * * const evts,
+    uint_fast16_t const max);
+#endif /* def QF_ACTQ_BATCH */
+
 /* public: */
 
 /*! Subscribes for delivery of signal `sig` to the active object
@@ -671,6 +875,76 @@ void QActive_psInit(
     QSubscrList * const subscrSto,
     enum_t const maxSignal);
 
+/*! Sparse publish-subscribe initialization
+* @static @public @memberof QActive
+*
+* @details
+* Alternative to QActive_psInit() for applications, which use only a small
+* fraction of a large signal space (e.g., signals allocated in widely
+* separated ranges per subsystem). Instead of the dense array of
+* subscriber lists indexed by the signal, the subscriber lists are kept in
+* the hash table with @p nEntries entries, which is sized for the number
+* of different signals subscribed to, rather than for @p maxSignal. The
+* expected cost of QActive_publish_() remains O(1).
+*
+* @param[in] subscrSto storage for the hash table entries
+* @param[in] nEntries  number of the entries, which must be a power of 2
+*                      (preferably at least twice the number of different
+*                      subscribed signals)
+* @param[in] maxSignal the maximum published signal (exclusive)
+*
+* @note
+* The entry of a signal is taken by the first subscription to the signal
+* and is never released. QF asserts when the table is full.
+*
+* @usage
+* @code{c}
+* static QSubscrEntry subscrSto[256];
+* . . .
+* QActive_psInitSparse(subscrSto, Q_DIM(subscrSto), MAX_PUB_SIG);
+* @endcode
+*/
+void QActive_psInitSparse(
+    QSubscrEntry * const subscrSto,
+    uint_fast16_t const nEntries,
+    enum_t const maxSignal);
+
+/*! Reverse subscription index initialization (optional)
+* @static @public @memberof QActive
+*
+* @details
+* Provides the storage for the reverse subscription index, which keeps
+* for every active object the bitmap of all signals it subscribes to.
+* With the index, QActive_unsubscribeAll() (and therefore also
+* QActive_stop()) costs time proportional to the actual subscriptions of
+* the active object rather than to the number of published signals.
+* Without the index, QActive_unsubscribeAll() visits every signal in the
+* range [::Q_USER_SIG..maxSignal) in a separate critical section.
+*
+* @param[in] idxSto storage for the index
+* @param[in] idxLen length of @p idxSto (number of ::QPSetBits elements),
+*                   which must be at least QF_PS_INDEX_LEN(maxSignal),
+*                   or QF_PS_INDEX_LEN(nEntries) for the sparse table
+*
+* @note
+* This function must be called after QActive_psInit() or
+* QActive_psInitSparse(). It can be called
+* after some active objects have already subscribed, because the index
+* is rebuilt from the current subscriber lists.
+*
+* @usage
+* @code{c}
+* static QSubscrList subscrSto[MAX_PUB_SIG];
+* static QPSetBits subscrIdxSto[QF_PS_INDEX_LEN(MAX_PUB_SIG)];
+* . . .
+* QActive_psInit(subscrSto, Q_DIM(subscrSto));
+* QActive_psIndexInit(subscrIdxSto, Q_DIM(subscrIdxSto));
+* @endcode
+*/
+void QActive_psIndexInit(
+    QPSetBits * const idxSto,
+    uint_fast32_t const idxLen);
+
 /* private: */
 
 /*! Publish event to all subscribers of a given signal `e->sig`
@@ -969,6 +1243,47 @@ void QMActive_ctor(QMActive * const me,
 */
 typedef QActiveVtable QMActiveVtable;
 /*$enddecl${QF::QMActiveVtable} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+/*$declare${QF::QTActive} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
+
+/*${QF::QTActive} ..........................................................*/
+/*! @brief Active object class (based on QTsm implementation strategy)
+* @class QTActive
+* @extends QActive
+*
+* @details
+* ::QTActive represents an active object that uses the ::QTsm style
+* (table-driven) state machine implementation strategy. Just like ::QTsm,
+* ::QTActive adds no attributes to the ::QActive base class, so an active
+* object derived from ::QActive is turned into a ::QTActive just by calling
+* QTActive_ctor() instead of QActive_ctor() in its constructor.
+*
+* @sa QTsm
+*/
+typedef struct {
+/* protected: */
+    QActive super;
+} QTActive;
+
+/* protected: */
+
+/*! Constructor of ::QTActive class.
+* @protected @memberof QTActive
+*
+* @details
+* Performs the first step of active object initialization by assigning
+* the virtual pointer and the ::QTsmTable of the state machine.
+*
+* @param[in,out] me     pointer (see @ref oop)
+* @param[in]     table  the constant tables of the state machine
+*
+* @note  Must be called only ONCE before QHSM_INIT().
+*
+* @sa QTsm_ctor()
+*/
+void QTActive_ctor(
+    QActive * const me,
+    QTsmTable const * const table);
+/*$enddecl${QF::QTActive} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
 /*$declare${QF::QTimeEvt} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
 
 /*${QF::QTimeEvt} ..........................................................*/
@@ -999,6 +1314,14 @@ typedef QActiveVtable QMActiveVtable;
 * every invocation of the QTIMEEVT_TICK_X() macro. Only armed (timing out)
 * time events are in the list, so only armed time events consume CPU cycles.
 *
+* When the macro #QF_TIMEEVT_WHEEL is defined (e.g., in qf_port.h or on
+* the command line), the armed time events are kept instead in a
+* hierarchical timing wheel--one wheel for every supported ticking rate.
+* Arming, disarming and rearming a time event then takes constant time,
+* and a clock tick processes only the time events that expire in this
+* tick (plus the time events moved down the wheel every 2^#QF_TIMEEVT_WHEEL_BITS
+* ticks). This pays off with hundreds or thousands of armed time events.
+*
 * @sa ::QTimeEvt for the description of the data members
 *
 * @tr{AQP215}
@@ -1050,6 +1373,31 @@ typedef struct QTimeEvt {
     */
     QTimeEvtCtr interval;
 
+    /*! link to the pointer that points to this time event
+    * @private @memberof QTimeEvt
+    *
+    * @details
+    * Used only with the timing-wheel backend (see #QF_TIMEEVT_WHEEL) to
+    * unlink the time event from its wheel slot in constant time.
+    */
+#ifdef QF_TIMEEVT_WHEEL
+    struct QTimeEvt * volatile *prev;
+#endif /* def QF_TIMEEVT_WHEEL */
+
+    /*! The tick of expiration of the time event
+    * @private @memberof QTimeEvt
+    *
+    * @details
+    * Used only with the timing-wheel backend (see #QF_TIMEEVT_WHEEL),
+    * where the time event is not decremented in every clock tick.
+    * Instead, the internal counter @p ctr only indicates whether the time
+    * event is armed, and the time event expires when the tick counter
+    * of its tick rate reaches @p expiry.
+    */
+#ifdef QF_TIMEEVT_WHEEL
+    QTimeEvtCtr expiry;
+#endif /* def QF_TIMEEVT_WHEEL */
+
 /* public: */
 } QTimeEvt;
 
@@ -1257,9 +1605,144 @@ void QTimeEvt_tick1_(
 */
 bool QTimeEvt_noActive(uint_fast8_t const tickRate);
 
+/*! Returns the number of clock ticks until the nearest armed time event
+* at a given tick rate expires.
+* @static @public @memberof QTimeEvt
+*
+* @details
+* Returns the nearest expiration at the given clock tick rate, which is
+* maintained by QTimeEvt_tick_() and by arming the time events, so the
+* call does not scan the armed time events. QF ports with the "tickless"
+* clock tick use this to sleep until the nearest expiration instead of
+* waking up at every clock tick.
+*
+* @param[in]  tickRate  system clock tick rate to find out about.
+*
+* @returns
+* the number of clock ticks until the nearest time event expires
+* or 0 if no time events are armed at the given tick rate. After a time
+* event has been disarmed (or re-armed for later), the returned number
+* can be lower until the next clock tick at this rate.
+*
+* @note
+* The function takes the time-event critical section internally.
+*/
+QTimeEvtCtr QTimeEvt_ticksToNext(uint_fast8_t const tickRate);
+
 /*! heads of linked lists of time events, one for every clock tick rate */
 extern QTimeEvt QTimeEvt_timeEvtHead_[QF_MAX_TICK_RATE];
 /*$enddecl${QF::QTimeEvt} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+/*$declare${QF::QHrTimeEvt} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
+
+/*${QF::QHrTimeEvt} ........................................................*/
+/*! @brief High-resolution one-shot Time Event class
+* @class QHrTimeEvt
+* @extends QEvt
+*
+* @details
+* High-resolution time events are one-shot time events armed with a
+* deadline in nanoseconds of the monotonic clock of the QF port, rather
+* than in clock ticks. They do not depend on the system clock tick, so a
+* sub-millisecond timeout does not require a fast tick rate. When the
+* deadline passes, the QF port posts the time event directly to the
+* recipient active object, just like a regular ::QTimeEvt.
+*
+* The armed high-resolution time events are kept in a binary heap sorted
+* by the deadline, with room for up to #QF_MAX_HRTIMER time events. The QF
+* port is notified about the earliest deadline through the macro
+* QF_HRTIMER_SET_() and calls QHrTimeEvt_expire_() when it passes.
+*
+* @note
+* High-resolution time events are available only in the QF ports that
+* define #QF_MAX_HRTIMER greater than zero and provide the current time
+* with QF_hrTimeNow(). Like ::QTimeEvt instances, ::QHrTimeEvt instances
+* can NOT be allocated dynamically from event pools.
+*/
+typedef struct QHrTimeEvt {
+/* protected: */
+    QEvt super;
+
+/* private: */
+
+    /*! The active object that receives the time event
+    * @private @memberof QHrTimeEvt
+    */
+    void * volatile act;
+
+    /*! Absolute deadline of the time event [ns]
+    * @private @memberof QHrTimeEvt
+    */
+    uint64_t deadline;
+
+    /*! Position of the time event in the heap plus one (0 when disarmed)
+    * @private @memberof QHrTimeEvt
+    */
+    uint_fast16_t volatile heapIdx;
+} QHrTimeEvt;
+
+/* public: */
+
+/*! The "constructor" to initialize a high-resolution Time Event.
+* @public @memberof QHrTimeEvt
+*
+* @param[in,out] me   pointer (see @ref oop)
+* @param[in]     act  pointer to the active object associated with this
+*                     time event. The time event will post itself to this AO.
+* @param[in]     sig  signal to associate with this time event.
+*/
+void QHrTimeEvt_ctor(QHrTimeEvt * const me,
+    QActive * const act,
+    enum_t const sig);
+
+/*! Arm a high-resolution time event for an absolute deadline.
+* @public @memberof QHrTimeEvt
+*
+* @param[in,out] me       pointer (see @ref oop)
+* @param[in]     deadline absolute deadline [ns] of the monotonic clock
+*                         returned by QF_hrTimeNow(). A deadline in the
+*                         past expires right away.
+*
+* @attention
+* Arming an already armed time event is __not__ allowed and is considered
+* a programming error.
+*/
+void QHrTimeEvt_armAt(QHrTimeEvt * const me,
+    uint64_t const deadline);
+
+/*! Arm a high-resolution time event for a delay from now.
+* @public @memberof QHrTimeEvt
+*
+* @param[in,out] me     pointer (see @ref oop)
+* @param[in]     delay  the delay [ns] from the current time
+*/
+void QHrTimeEvt_armIn(QHrTimeEvt * const me,
+    uint64_t const delay);
+
+/*! Disarm a high-resolution time event.
+* @public @memberof QHrTimeEvt
+*
+* @returns
+* 'true' if the time event was truly disarmed, that is, it was running.
+* The return of 'false' means that the time event was not truly disarmed,
+* because it was not running or has already been posted to its AO.
+*/
+bool QHrTimeEvt_disarm(QHrTimeEvt * const me);
+
+/*! Post all high-resolution time events that expired by @p now
+* (used by the QF port).
+* @static @private @memberof QHrTimeEvt
+*
+* @param[in]  now     the current time [ns]
+* @param[in]  sender  pointer to a sender object (used in QS only)
+*
+* @note
+* Before returning, the function passes the next deadline (or 0 if no time
+* events are armed) to the QF port with QF_HRTIMER_SET_().
+*/
+void QHrTimeEvt_expire_(
+    uint64_t const now,
+    void const * const sender);
+/*$enddecl${QF::QHrTimeEvt} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
 /*$declare${QF::QTicker} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
 
 /*${QF::QTicker} ...........................................................*/
@@ -1431,7 +1914,7 @@ static inline void QF_psInit(
 * the minimum of free ever present in the given event queue of an active
 * object with priority @p prio, since the active object was started.
 */
-uint_fast16_t QF_getQueueMin(uint_fast8_t const prio);
+uint_fast16_t QF_getQueueMin(uint_fast16_t const prio);
 
 /*${QF::QF-base::onStartup} ................................................*/
 /*! Startup QF callback.
@@ -1479,9 +1962,10 @@ void QF_onCleanup(void);
 *
 * @attention
 * You might initialize many event pools by making many consecutive calls
-* to the QF_poolInit() function. However, for the simplicity of the internal
-* implementation, you must initialize event pools in the **ascending order**
-* of the event size.
+* to the QF_poolInit() function, in any order of the event size. Every call
+* rebuilds the internal size-class index of the pools, which lets Q_NEW()
+* find the smallest pool that fits the requested event size in constant
+* time, regardless of the number of pools.
 *
 * Many RTOSes provide fixed block-size heaps, a.k.a. memory pools that can
 * be adapted for QF event pools. In case such support is missing, QF provides
@@ -1590,6 +2074,14 @@ QEvt * QF_newX_(
 * queues are processed outside of QF and the automatic garbage collection
 * is **NOT** performed for these events. In this case you need to call
 * QF_gc() explicitly.
+*
+* @note
+* When the macro #QF_EVT_REF_ATOMIC is defined (e.g., on the command line
+* -DQF_EVT_REF_ATOMIC, implied by #QF_OBJ_CRIT), the reference counters of
+* the events are updated with the lock-free C11 atomic operations
+* (<stdatomic.h>) and QF_gc() as well as QF_newRef_() don't enter the QF
+* critical section. The size of the counter is configured by
+* #Q_EVT_REF_CTR_SIZE.
 */
 void QF_gc(QEvt const * const e);
 
@@ -1640,8 +2132,41 @@ void QF_deleteRef_(void const * const evtRef);
 #define QF_NO_MARGIN ((uint_fast16_t)0xFFFFU)
 
 /*${QF-macros::Q_PRIO} .....................................................*/
+#if (QF_MAX_ACTIVE <= 255U)
 /*! Create a ::QPrioSpec object to specify priorty of an AO or a thread */
 #define Q_PRIO(prio_, pthre_) ((QPrioSpec)((prio_) | ((pthre_) << 8U)))
+#endif /*  (QF_MAX_ACTIVE <= 255U) */
+
+/*${QF-macros::Q_PRIO} .....................................................*/
+#if (255U < QF_MAX_ACTIVE)
+/*! Create a ::QPrioSpec object to specify priorty of an AO or a thread
+* (case of more than 255 priorities)
+*/
+#define Q_PRIO(prio_, pthre_) \
+    ((QPrioSpec)((QPrioSpec)(prio_) | ((QPrioSpec)(pthre_) << 16U)))
+#endif /*  (255U < QF_MAX_ACTIVE) */
+
+/*${QF-macros::QF_PS_INDEX_WORDS_} .........................................*/
+/*! Number of ::QPSetBits words needed for a bitmap of `n_` bits */
+#define QF_PS_INDEX_WORDS_(n_) \
+    (((uint_fast32_t)(n_) + (8U * sizeof(QPSetBits)) - 1U) \
+     / (8U * sizeof(QPSetBits)))
+
+/*${QF-macros::QF_PS_INDEX_LEN} ............................................*/
+/*! Length of the reverse subscription index storage (number of ::QPSetBits
+* elements) for signals up to `maxSignal_`
+*
+* @details
+* Every active object takes the bitmap of `maxSignal_` bits (one bit per
+* signal) and the summary bitmap with one bit per word of that bitmap.
+* For the sparse subscriber table, `maxSignal_` is the number of entries
+* of the table (see QActive_psInitSparse()).
+*
+* @sa QActive_psIndexInit()
+*/
+#define QF_PS_INDEX_LEN(maxSignal_) \
+    (QF_MAX_ACTIVE * (QF_PS_INDEX_WORDS_(maxSignal_) \
+        + QF_PS_INDEX_WORDS_(QF_PS_INDEX_WORDS_(maxSignal_))))
 
 /*${QF-macros::Q_NEW} ......................................................*/
 #ifndef Q_EVT_CTOR
@@ -1887,6 +2412,45 @@ void QF_deleteRef_(void const * const evtRef);
      (e_), (margin_), (void *)0))
 #endif /* ndef Q_SPY */
 
+/*${QF-macros::QACTIVE_POST_MOVE} ..........................................*/
+#ifdef Q_SPY
+/*! Post a new dynamic event to an active object and give up the event
+*
+* @details
+* This macro calls QActive_postMove_(), which asserts if the event is not
+* a new dynamic event (allocated with Q_NEW() and not posted or published
+* yet) and if the queue overflows and cannot accept the event. Afterwards,
+* the macro sets the event pointer @p e_ to NULL, so that the sender cannot
+* access the event it no longer owns.
+*
+* @param[in,out] me_ pointer (see @ref oop)
+* @param[in,out] e_  pointer variable (lvalue) to the event to post
+* @param[in] sender_ pointer to the sender object.
+*
+* @usage
+* @code
+* MyEvt *pe = Q_NEW(MyEvt, MY_SIG);
+* pe->data = ...;
+* QACTIVE_POST_MOVE(AO_Consumer, pe, me);
+* // pe is NULL at this point
+* @endcode
+*
+* @sa QActive_postMove_(), QACTIVE_POST()
+*/
+#define QACTIVE_POST_MOVE(me_, e_, sender_) do { \
+    QActive_postMove_((QActive *)(me_), (QEvt const *)(e_), (sender_)); \
+    (e_) = (void *)0; \
+} while (false)
+#endif /* def Q_SPY */
+
+/*${QF-macros::QACTIVE_POST_MOVE} ..........................................*/
+#ifndef Q_SPY
+#define QACTIVE_POST_MOVE(me_, e_, dummy) do { \
+    QActive_postMove_((QActive *)(me_), (QEvt const *)(e_), (void *)0); \
+    (e_) = (void *)0; \
+} while (false)
+#endif /* ndef Q_SPY */
+
 /*${QF-macros::QACTIVE_POST_LIFO} ..........................................*/
 /*! Virtual call to post an event to an active object using the
 * Last-In-First-Out (LIFO) policy.
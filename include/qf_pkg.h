@@ -80,6 +80,53 @@ extern QPSet QF_readySet_;
 void QF_bzero(
     void * const start,
     uint_fast16_t const len);
+
+/*${QF::QF-pkg::subscrFind_} ...............................................*/
+/*! Find the subscriber list of a given signal (internal)
+* @static @private @memberof QF
+*
+* @details
+* Finds the subscriber list in the dense (QActive_psInit()) or the sparse
+* (QActive_psInitSparse()) subscriber table. This function is used by the
+* QF ports, which provide their own publishing (e.g., from ISRs) and must
+* be called in a critical section.
+*
+* @param[in] sig the published signal
+*
+* @returns pointer to the subscriber list or NULL when the signal was never
+* subscribed to in the sparse subscriber table
+*/
+QSubscrList * QF_subscrFind_(enum_t const sig);
+
+/*${QF::QF-pkg::multicast_} ................................................*/
+/*! Post an event to all active objects in a set (batched multicast)
+* @static @private @memberof QF
+*
+* @details
+* This function is used by QActive_publish_() when the macro
+* #QF_PUBLISH_BATCH is defined. For all subscribers with the native
+* QActive_post_(), the reference counter of a dynamic event is incremented
+* only once (by the number of such subscribers), the event is inserted into
+* the queues with a minimum of locking, and the recipients whose queues
+* were empty are signaled only after the whole fan-out. Other subscribers
+* (e.g., extended threads) receive the event through QACTIVE_POST().
+* The function is provided for the native QF active object queues and by
+* the QF ports with their own queues (e.g., the POSIX port with the
+* lock-free queues).
+*
+* @param[in] subscrList the set of the subscribers' priorities
+* @param[in] e          pointer to the event to post
+* @param[in] sender     pointer to a sender object (used in QS only)
+*
+* @attention
+* This function asserts internally if any of the queues overflows.
+*/
+#ifdef QF_PUBLISH_BATCH
+void QF_multicast_(
+    QPSet const * const subscrList,
+    QEvt const * const e,
+    void const * const sender);
+#endif /* def QF_PUBLISH_BATCH */
 /*$enddecl${QF::QF-pkg} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
 
 /*==========================================================================*/
@@ -154,6 +201,123 @@ void QF_bzero(
 
 #endif /* Q_NASSERT */
 
+/*==========================================================================*/
+/* Decoding of the ::QPrioSpec (see also Q_PRIO()) */
+#if (QF_MAX_ACTIVE <= 255U)
+    /*! Internal macro for the QF-priority of the ::QPrioSpec @p spec_ */
+    #define QF_PRIO_SPEC_PRIO_(spec_)  ((uint8_t)((spec_) & 0xFFU))
+
+    /*! Internal macro for the preemption-threshold of the ::QPrioSpec
+    * @p spec_ */
+    #define QF_PRIO_SPEC_PTHRE_(spec_) ((uint8_t)((spec_) >> 8U))
+#else
+    #define QF_PRIO_SPEC_PRIO_(spec_)  ((uint16_t)((spec_) & 0xFFFFU))
+    #define QF_PRIO_SPEC_PTHRE_(spec_) ((uint16_t)((spec_) >> 16U))
+#endif
+
+/*==========================================================================*/
+/* QF object-level critical sections */
+#ifdef QF_OBJ_CRIT
+    #if (!defined QF_ACTQ_CRIT_ENTRY) || (!defined QF_MPOOL_CRIT_ENTRY) \
+        || (!defined QF_TIMEEVT_CRIT_ENTRY)
+        #error "QF_OBJ_CRIT is not supported in this QF port"
+    #endif
+
+    /*! Internal macro for entering the critical section of the event queue
+    * of the active object @p me_ */
+    /**
+    * @details
+    * When the QF port defines #QF_OBJ_CRIT, every active-object queue,
+    * every memory pool and every list of time events (one per tick rate)
+    * is protected by its own critical section provided by the port.
+    * Otherwise, all of them are protected by the single QF critical
+    * section.
+    * @sa QF_ACTQ_CRIT_ENTRY()
+    */
+    #define QF_ACTQ_CRIT_E_(me_)      QF_ACTQ_CRIT_ENTRY(me_)
+
+    /*! Internal macro for exiting the critical section of the event queue
+    * of the active object @p me_ */
+    #define QF_ACTQ_CRIT_X_(me_)      QF_ACTQ_CRIT_EXIT(me_)
+
+    /*! Internal macro for entering the critical section of the memory
+    * pool @p me_ */
+    #define QF_MPOOL_CRIT_E_(me_)     QF_MPOOL_CRIT_ENTRY(me_)
+
+    /*! Internal macro for exiting the critical section of the memory
+    * pool @p me_ */
+    #define QF_MPOOL_CRIT_X_(me_)     QF_MPOOL_CRIT_EXIT(me_)
+
+    /*! Internal macro for entering the critical section of the time
+    * events armed at the tick rate @p rate_ */
+    #define QF_TIMEEVT_CRIT_E_(rate_) QF_TIMEEVT_CRIT_ENTRY(rate_)
+
+    /*! Internal macro for exiting the critical section of the time
+    * events armed at the tick rate @p rate_ */
+    #define QF_TIMEEVT_CRIT_X_(rate_) QF_TIMEEVT_CRIT_EXIT(rate_)
+#else
+    #define QF_ACTQ_CRIT_E_(me_)      QF_CRIT_E_()
+    #define QF_ACTQ_CRIT_X_(me_)      QF_CRIT_X_()
+    #define QF_MPOOL_CRIT_E_(me_)     QF_CRIT_E_()
+    #define QF_MPOOL_CRIT_X_(me_)     QF_CRIT_X_()
+    #define QF_TIMEEVT_CRIT_E_(rate_) QF_CRIT_E_()
+    #define QF_TIMEEVT_CRIT_X_(rate_) QF_CRIT_X_()
+#endif /* QF_OBJ_CRIT */
+
+/* Assertions inside the object-level critical sections */
+#ifdef Q_NASSERT /* Q_NASSERT defined--assertion checking disabled */
+
+    #define Q_ASSERT_ACTQ_CRIT_(me_, id_, test_)      ((void)0)
+    #define Q_ERROR_ACTQ_CRIT_(me_, id_)              ((void)0)
+    #define Q_ASSERT_MPOOL_CRIT_(me_, id_, test_)     ((void)0)
+    #define Q_ASSERT_TIMEEVT_CRIT_(rate_, id_, test_) ((void)0)
+
+#else  /* Q_NASSERT not defined--assertion checking enabled */
+
+    #define Q_ASSERT_ACTQ_CRIT_(me_, id_, test_) do {     \
+        if ((test_)) {} else {                            \
+            QF_ACTQ_CRIT_X_(me_);                         \
+            Q_onAssert(&Q_this_module_[0], (int_t)(id_)); \
+        }                                                 \
+    } while (false)
+
+    #define Q_ERROR_ACTQ_CRIT_(me_, id_) do {             \
+        QF_ACTQ_CRIT_X_(me_);                             \
+        Q_onAssert(&Q_this_module_[0], (int_t)(id_));     \
+    } while (false)
+
+    #define Q_ASSERT_MPOOL_CRIT_(me_, id_, test_) do {    \
+        if ((test_)) {} else {                            \
+            QF_MPOOL_CRIT_X_(me_);                        \
+            Q_onAssert(&Q_this_module_[0], (int_t)(id_)); \
+        }                                                 \
+    } while (false)
+
+    #define Q_ASSERT_TIMEEVT_CRIT_(rate_, id_, test_) do { \
+        if ((test_)) {} else {                             \
+            QF_TIMEEVT_CRIT_X_(rate_);                     \
+            Q_onAssert(&Q_this_module_[0], (int_t)(id_));  \
+        }                                                  \
+    } while (false)
+
+#endif /* Q_NASSERT */
+
+/*==========================================================================*/
+/* Hooks for QF ports with the "tickless" clock tick, in which the ticker
+* sleeps until the nearest expiration of a time event (see
+* QTimeEvt_ticksToNext()). The port defines both macros (e.g., when
+* QF_TICKLESS is defined), which are called outside of any critical section.
+*/
+#ifndef QF_TICKLESS_SYNC_
+    /*! Internal hook invoked before arming a time event at the tick rate
+    * @p rate_, which brings the clock ticks up to date with the time */
+    #define QF_TICKLESS_SYNC_(rate_)          ((void)0)
+
+    /*! Internal hook invoked after arming a time event at the tick rate
+    * @p rate_ to expire in @p nTicks_, which wakes up the ticker if needed */
+    #define QF_TICKLESS_WAKE_(rate_, nTicks_) ((void)0)
+#endif /* QF_TICKLESS_SYNC_ */
+
 /*==========================================================================*/
 
 /* The following bitmasks are for the fields of the @c refCtr_ attribute
@@ -178,12 +342,114 @@ typedef struct QFreeBlock {
 */
 #define QF_CONST_CAST_(type_, ptr_)  ((type_)(ptr_))
 
+#ifdef QF_POST_MOVE
+/*! can a new reference to the event @p e_ be created?
+*
+* @details
+* A moved event (see QActive_postMove_()) is referenced only by its
+* recipient, so no other reference to it can be created after the first
+* post. The check is used in assertions, so it costs nothing with
+* #Q_NASSERT.
+*/
+#define QF_EVT_NOT_MOVED_(e_) \
+    (((e_)->moved_ == 0U) || (QF_EVT_REF_CTR_GET_(e_) == 0U))
+#else
+#define QF_EVT_NOT_MOVED_(e_) (true)
+#endif /* def QF_POST_MOVE */
+
+/* With object-level critical sections the references to the same event
+* are created and deleted under *different* critical sections, so the
+* reference counter must be updated atomically.
+*/
+#if (defined QF_OBJ_CRIT) && (!defined QF_EVT_REF_ATOMIC)
+    #define QF_EVT_REF_ATOMIC
+#endif
+
+#ifdef QF_EVT_REF_ATOMIC
+/* The reference counter of an event is updated atomically (lock-free),
+* which allows QF_gc() and QF_newRef_() to update it without entering
+* the QF critical section. The decrement returns the new value, so that
+* only one of the concurrent garbage collectors sees the last reference.
+* The counter is accessed as a C11 atomic object (<stdatomic.h>), which
+* must be lock-free and of the same size as ::QEvtRefCtr.
+*/
+#ifdef __STDC_NO_ATOMICS__
+    #error "QF_EVT_REF_ATOMIC requires the C11 atomics (<stdatomic.h>)"
+#endif
+#include <stdatomic.h>
+
+#if (Q_EVT_REF_CTR_SIZE == 1U) && (ATOMIC_CHAR_LOCK_FREE != 2)
+    #error "QF_EVT_REF_ATOMIC requires lock-free atomic 1-byte counters"
+#elif (Q_EVT_REF_CTR_SIZE == 2U) && (ATOMIC_SHORT_LOCK_FREE != 2)
+    #error "QF_EVT_REF_ATOMIC requires lock-free atomic 2-byte counters"
+#elif (Q_EVT_REF_CTR_SIZE == 4U) && (ATOMIC_INT_LOCK_FREE != 2) \
+      && (ATOMIC_LONG_LOCK_FREE != 2)
+    #error "QF_EVT_REF_ATOMIC requires lock-free atomic 4-byte counters"
+#endif
+_Static_assert(sizeof(_Atomic QEvtRefCtr) == sizeof(QEvtRefCtr),
+               "the atomic QEvtRefCtr must have the size of QEvtRefCtr");
+
+/*! the reference counter of the event @p e_ as a C11 atomic object */
+#define QF_EVT_REF_CTR_OBJ_(e_) \
+    ((_Atomic QEvtRefCtr volatile *)&QF_CONST_CAST_(QEvt*, e_)->refCtr_)
+
+/*! atomically increment the refCtr of an event @p e
+* @returns the incremented refCtr
+*/
+static inline QEvtRefCtr QF_evtRefCtrInc_(QEvt const * const e) {
+    QEvtRefCtr refCtr;
+#ifdef QF_POST_MOVE
+    /* A moved event is accessible only to its sender until it is posted,
+    * so its only reference is set by a plain store (see QActive_postMove_())
+    */
+    if ((e->moved_ != 0U)
+        && (atomic_load_explicit(QF_EVT_REF_CTR_OBJ_(e),
+                                 memory_order_relaxed) == 0U))
+    {
+        atomic_store_explicit(QF_EVT_REF_CTR_OBJ_(e), (QEvtRefCtr)1U,
+                              memory_order_relaxed);
+        refCtr = 1U;
+    }
+    else
+#endif /* def QF_POST_MOVE */
+    {
+        refCtr = (QEvtRefCtr)(atomic_fetch_add_explicit(
+                     QF_EVT_REF_CTR_OBJ_(e), 1U, memory_order_relaxed) + 1U);
+    }
+    return refCtr;
+}
+
+/*! atomically decrement the refCtr of an event @p e
+* @returns the decremented refCtr
+*/
+static inline QEvtRefCtr QF_evtRefCtrDec_(QEvt const * const e) {
+    return (QEvtRefCtr)(atomic_fetch_sub_explicit(
+               QF_EVT_REF_CTR_OBJ_(e), 1U, memory_order_acq_rel) - 1U);
+}
+
+#define QF_EVT_REF_CTR_INC_(e_) (QF_evtRefCtrInc_(e_))
+#define QF_EVT_REF_CTR_DEC_(e_) (QF_evtRefCtrDec_(e_))
+#define QF_EVT_REF_CTR_GET_(e_) \
+    (atomic_load_explicit(QF_EVT_REF_CTR_OBJ_(e_), memory_order_acquire))
+#define QF_EVT_REF_CTR_ADD_(e_, n_) \
+    ((void)atomic_fetch_add_explicit(QF_EVT_REF_CTR_OBJ_(e_), \
+                                     (QEvtRefCtr)(n_), memory_order_relaxed))
+#else
+
 /*! increment the refCtr of an event @p e_ casting const away */
 #define QF_EVT_REF_CTR_INC_(e_) (++QF_CONST_CAST_(QEvt*, e_)->refCtr_)
 
 /*! decrement the refCtr of an event @p e_ casting const away */
 #define QF_EVT_REF_CTR_DEC_(e_) (--QF_CONST_CAST_(QEvt*, e_)->refCtr_)
 
+/*! get the refCtr of an event @p e_ */
+#define QF_EVT_REF_CTR_GET_(e_) ((e_)->refCtr_)
+
+/*! add @p n_ references to the refCtr of an event @p e_ */
+#define QF_EVT_REF_CTR_ADD_(e_, n_) \
+    ((void)(QF_CONST_CAST_(QEvt*, e_)->refCtr_ += (QEvtRefCtr)(n_)))
+#endif /* QF_EVT_REF_ATOMIC */
+
 /**
 * @details
 * This macro is specifically and exclusively used for checking the range
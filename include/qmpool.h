@@ -123,6 +123,15 @@
 * @note
 * The native QF event pool is configured by defining the macro
 * #QF_EPOOL_TYPE_ as ::QMPool in the specific QF port header file.
+*
+* @note
+* When the macro #QF_MPOOL_LOCKFREE is defined (e.g., in the QF port or on
+* the command line), the free blocks are kept in a lock-free stack with an
+* ABA-safe tagged head, so that QMPool_get() and QMPool_put() do not use
+* any critical section. This is intended for the QF ports, where a critical
+* section is an OS mutex (e.g., POSIX). The option requires the lock-free
+* C11 atomics (<stdatomic.h>) with 64-bit compare-and-swap and the pool
+* storage smaller than 4GB.
 */
 typedef struct {
 /* private: */
@@ -166,6 +175,30 @@ typedef struct {
     * @sa QF_getPoolMin().
     */
     QMPoolCtr nMin;
+
+    /*! OS-dependent critical section of this memory pool
+    * @private @memberof QMPool
+    *
+    * @details
+    * Used only in QF ports with object-level critical sections
+    * (see #QF_OBJ_CRIT), where each memory pool is protected separately.
+    */
+#ifdef QF_MPOOL_CRIT_TYPE
+    QF_MPOOL_CRIT_TYPE crit;
+#endif /* def QF_MPOOL_CRIT_TYPE */
+
+    /*! tagged head of the lock-free list of free blocks
+    * @private @memberof QMPool
+    *
+    * @details
+    * Used only with the lock-free free list (see #QF_MPOOL_LOCKFREE).
+    * The lower 32 bits hold the offset of the first free block from
+    * @p start plus one (0 for the empty list) and the upper 32 bits hold
+    * the generation tag incremented with every change of the head.
+    */
+#ifdef QF_MPOOL_LOCKFREE
+    uint64_t volatile top;
+#endif /* def QF_MPOOL_LOCKFREE */
 } QMPool;
 
 /* public: */
@@ -276,6 +309,55 @@ void * QMPool_get(QMPool * const me,
 void QMPool_put(QMPool * const me,
     void * const b,
     uint_fast8_t const qs_id);
+
+/*! Obtains a batch of memory blocks from a memory pool
+* (used by the QF ports).
+* @private @memberof QMPool
+*
+* @details
+* The function removes up to @p n blocks from the pool in a single
+* critical section. It is intended for QF ports that cache free blocks
+* outside the pool (e.g., in per-thread caches), where the blocks are
+* moved to and from the shared pool in batches.
+*
+* @param[in,out] me      pointer (see @ref oop)
+* @param[out]    blocks  array to receive the blocks (room for @p n)
+* @param[in]     n       the maximum number of blocks to obtain
+* @param[in]     qs_id   QS-id of this memory pool (for QS tracing)
+*
+* @returns
+* The number of blocks stored in @p blocks, which is less than @p n
+* when the pool does not have that many free blocks left.
+*
+* @note
+* The number of free blocks and the minimum number of free blocks of
+* the pool are updated for the whole batch, which produces a single
+* QS_QF_MPOOL_GET trace record.
+*/
+uint_fast16_t QMPool_getBatch_(QMPool * const me,
+    void * * const blocks,
+    uint_fast16_t const n,
+    uint_fast8_t const qs_id);
+
+/*! Recycles a batch of memory blocks back to a memory pool
+* (used by the QF ports).
+* @private @memberof QMPool
+*
+* @param[in,out] me      pointer (see @ref oop)
+* @param[in]     blocks  array of the blocks to recycle
+* @param[in]     n       the number of blocks in @p blocks
+* @param[in]     qs_id   QS-id of this memory pool (for QS tracing)
+*
+* @attention
+* All recycled blocks must be allocated from the **same** memory pool
+* to which they are returned.
+*
+* @sa QMPool_getBatch_()
+*/
+void QMPool_putBatch_(QMPool * const me,
+    void * const * const blocks,
+    uint_fast16_t const n,
+    uint_fast8_t const qs_id);
 /*$enddecl${QF::QMPool} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
 
 #endif  /* QMPOOL_H */
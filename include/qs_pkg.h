@@ -111,6 +111,8 @@ enum QSpyRxRecords {
         QS_CRIT_X_(); \
     }
 
+#ifndef QF_OBJ_CRIT
+
 /*! Internal macro to begin a predefined QS record without
 * entering critical section.
 *
@@ -130,6 +132,27 @@ enum QSpyRxRecords {
 */
 #define QS_END_NOCRIT_PRE_()    QS_endRec_(); }
 
+#else /* object-level critical sections */
+
+#ifndef QS_CRIT_ENTRY
+    #error "QF_OBJ_CRIT requires a separate QS critical section QS_CRIT_ENTRY"
+#endif
+
+/* With object-level critical sections (see #QF_OBJ_CRIT) the "NOCRIT"
+* records are produced under different critical sections of QF objects,
+* which don't protect the QS buffer. Such records must therefore enter
+* the separate QS critical section, which is always nested inside
+* the QF object critical section.
+*/
+#define QS_BEGIN_NOCRIT_PRE_(rec_, qs_id_)              \
+    if (QS_GLB_CHECK_(rec_) && QS_LOC_CHECK_(qs_id_)) { \
+        QS_CRIT_ENTRY(dummy);                           \
+        QS_beginRec_((uint_fast8_t)(rec_));
+
+#define QS_END_NOCRIT_PRE_()    QS_endRec_(); QS_CRIT_EXIT(dummy); }
+
+#endif /* QF_OBJ_CRIT */
+
 /*! Internal QS macro to output a predefined uint8_t data element */
 #define QS_U8_PRE_(data_)       (QS_u8_raw_((uint8_t)(data_)))
 
@@ -51,6 +51,10 @@ Q_DEFINE_THIS_MODULE("qf_port")
     #error "FreeRTOS configMAX_PRIORITIES must not be less than QF_MAX_ACTIVE"
 #endif
 
+#ifdef QF_TIMEEVT_WHEEL
+    #error "QTimeEvt_tickFromISR_() does not support QF_TIMEEVT_WHEEL"
+#endif
+
 /* Global objects ----------------------------------------------------------*/
 PRIVILEGED_DATA portMUX_TYPE QF_esp32mux = portMUX_INITIALIZER_UNLOCKED;
 
@@ -374,7 +378,14 @@ void IRAM_ATTR QActive_publishFromISR_(QEvt const * const e,
     }
 
     /* make a local, modifiable copy of the subscriber list */
-    QPSet subscrList = QActive_subscrList_[e->sig];
+    QPSet subscrList;
+    QSubscrList const * const list = QF_subscrFind_((enum_t)e->sig);
+    if (list != (QSubscrList *)0) {
+        subscrList = *list;
+    }
+    else { /* the signal was never subscribed in the sparse table */
+        QPSet_setEmpty(&subscrList);
+    }
     portEXIT_CRITICAL_ISR(&QF_esp32mux);
 
     if (QPSet_notEmpty(&subscrList)) { /* any subscribers? */
@@ -535,6 +546,9 @@ QEvt IRAM_ATTR *QF_newXFromISR_(uint_fast16_t const evtSize,
         e->sig = (QSignal)sig;   /* set signal for this event */
         e->poolId_ = (uint8_t)(idx + 1U); /* store the pool ID */
         e->refCtr_ = 0U; /* set the reference counter to 0 */
+#ifdef QF_POST_MOVE
+        e->moved_ = 0U;  /* not moved yet (see QActive_postMove_()) */
+#endif
 
 #ifdef Q_SPY
         portENTER_CRITICAL_ISR(&QF_esp32mux);
@@ -50,6 +50,10 @@ Q_DEFINE_THIS_MODULE("qf_port")
     #error "FreeRTOS configMAX_PRIORITIES must not be less than QF_MAX_ACTIVE"
 #endif
 
+#ifdef QF_TIMEEVT_WHEEL
+    #error "QTimeEvt_tickFromISR_() does not support QF_TIMEEVT_WHEEL"
+#endif
+
 /* Local objects -----------------------------------------------------------*/
 static void task_function(void *pvParameters); /* FreeRTOS task signature */
 
@@ -377,7 +381,14 @@ void QActive_publishFromISR_(QEvt const * const e,
     }
 
     /* make a local, modifiable copy of the subscriber list */
-    QPSet subscrList = QActive_subscrList_[e->sig];
+    QPSet subscrList;
+    QSubscrList const * const list = QF_subscrFind_((enum_t)e->sig);
+    if (list != (QSubscrList *)0) {
+        subscrList = *list;
+    }
+    else { /* the signal was never subscribed in the sparse table */
+        QPSet_setEmpty(&subscrList);
+    }
     portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
 
     if (QPSet_notEmpty(&subscrList)) { /* any subscribers? */
@@ -538,6 +549,9 @@ QEvt *QF_newXFromISR_(uint_fast16_t const evtSize,
         e->sig = (QSignal)sig;   /* set signal for this event */
         e->poolId_ = (uint8_t)(idx + 1U); /* store the pool ID */
         e->refCtr_ = 0U; /* set the reference counter to 0 */
+#ifdef QF_POST_MOVE
+        e->moved_ = 0U;  /* not moved yet (see QActive_postMove_()) */
+#endif
 
 #ifdef Q_SPY
         UBaseType_t uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
@@ -33,6 +33,10 @@
 
 /* expose features from the 2008 POSIX standard (IEEE Standard 1003.1-2008) */
 #define _POSIX_C_SOURCE 200809L
+#if (defined QF_QV_SHARDS) && (defined __linux__)
+    /* for pinning the shards to the CPU cores, see NOTE09 */
+    #define _GNU_SOURCE
+#endif
 
 #define QP_IMPL           /* this is QP implementation */
 #include "qf_port.h"      /* QF port */
@@ -55,11 +59,20 @@
 #include <termios.h>
 #include <unistd.h>
 #include <signal.h>
+#include <time.h>         /* for clock_gettime() and clock_nanosleep() */
+#include <errno.h>        /* for EINTR */
+#ifdef __linux__
+    #include <sys/timerfd.h>  /* for timerfd_create() and timerfd_settime() */
+#endif
 
 Q_DEFINE_THIS_MODULE("qf_port")
 
 /* Global objects ==========================================================*/
+#ifndef QF_QV_SHARDS
 pthread_cond_t QV_condVar_; /* Cond.var. to signal events */
+#else
+pthread_mutex_t QF_timeEvtMutex_[QF_MAX_TICK_RATE]; /* see NOTE09 */
+#endif
 
 /* Local objects ===========================================================*/
 static pthread_mutex_t l_pThreadMutex; /* POSIX mutex for critical sections */
@@ -67,10 +80,57 @@ static bool l_isRunning;
 static struct termios l_tsav; /* structure with saved terminal attributes */
 static struct timespec l_tick;
 static int_t l_tickPrio;
+static QF_TickStats l_tickStats; /* see NOTE06 */
+static uint64_t l_tickLatSum;    /* sum of the tick latencies [ns] */
+#ifdef QF_TICKLESS
+/* the "tickless" ticker, see NOTE07 */
+static pthread_mutex_t l_tickerMutex    = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  l_tickerSyncCond = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t  l_tickerWakeCond; /* on CLOCK_MONOTONIC */
+static pthread_t       l_tickerThread;
+static struct timespec l_tickerNext; /* deadline of the next clock tick */
+static uint32_t l_tickerPlan;  /* clock ticks of the planned sleep */
+static bool l_tickerLong;      /* sleeping (or behind) over more ticks */
+static bool l_tickerSleeping;  /* waiting for l_tickerWakeCond */
+static bool l_tickerWake;      /* wake-up of the ticker requested */
+#endif
+#if (QF_MAX_HRTIMER > 0U)
+/* the thread servicing the high-resolution time events, see NOTE08 */
+static pthread_t l_hrTimerThread;
+#ifdef __linux__
+static int l_hrTimerFd = -1;  /* timerfd armed for the earliest deadline */
+#else
+static pthread_cond_t l_hrTimerCond; /* on CLOCK_MONOTONIC */
+static uint64_t l_hrTimerDeadline;   /* the earliest deadline (0 for none) */
+#endif
+#endif
+#ifdef QF_QV_SHARDS
+/* the QV event loop on one CPU core, see NOTE09 */
+typedef struct {
+    pthread_mutex_t mutex; /* protects readySet and isWaiting */
+    pthread_cond_t cond;   /* signaled when an AO of the shard becomes ready */
+    QPSet readySet;        /* the AOs of the shard ready to run */
+    bool isWaiting;        /* the event loop waits for the cond */
+    pthread_t thread;      /* p-thread of the event loop */
+} QF_QVShard;
+
+static QF_QVShard l_shard[QF_QV_SHARDS];
+#endif
 enum { NANOSLEEP_NSEC_PER_SEC = 1000000000 }; /* see NOTE05 */
 
 static void *ticker_thread(void *arg);
 static void sigIntHandler(int dummy);
+#ifndef QF_TICKLESS
+static void tickerSleep(struct timespec * const next);
+#else
+static void tickerLoop(int64_t const delay);
+#endif
+#if (QF_MAX_HRTIMER > 0U)
+static void hrTimerStart(void);
+#endif
+#ifdef QF_QV_SHARDS
+static void shardsRun(void);
+#endif
 
 /* QF functions ============================================================*/
 void QF_init(void) {
@@ -82,11 +142,44 @@ void QF_init(void) {
     /* init the global mutex with the default non-recursive initializer */
     pthread_mutex_init(&l_pThreadMutex, NULL);
 
+#ifndef QF_QV_SHARDS
     /* init the global condition variable with the default initializer */
     pthread_cond_init(&QV_condVar_, NULL);
+#else
+    /* init the mutexes of the time events and of the shards, see NOTE09 */
+    for (uint_fast8_t tickRate = 0U; tickRate < QF_MAX_TICK_RATE; ++tickRate) {
+        pthread_mutex_init(&QF_timeEvtMutex_[tickRate], NULL);
+    }
+    for (uint_fast8_t n = 0U; n < QF_QV_SHARDS; ++n) {
+        pthread_mutex_init(&l_shard[n].mutex, NULL);
+        pthread_cond_init(&l_shard[n].cond, NULL);
+    }
+#endif
 
     l_tick.tv_sec = 0;
     l_tick.tv_nsec = NANOSLEEP_NSEC_PER_SEC/100L; /* default clock tick */
+
+#ifdef QF_TICKLESS
+    /* the ticker sleeps until absolute deadlines on CLOCK_MONOTONIC */
+    pthread_condattr_t condAttr;
+    pthread_condattr_init(&condAttr);
+    pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+    pthread_cond_init(&l_tickerWakeCond, &condAttr);
+    pthread_condattr_destroy(&condAttr);
+#endif
+#if (QF_MAX_HRTIMER > 0U)
+#ifdef __linux__
+    /* the high-resolution time events expire on a timerfd */
+    l_hrTimerFd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    Q_ASSERT_ID(330, l_hrTimerFd >= 0);
+#else
+    pthread_condattr_t hrCondAttr;
+    pthread_condattr_init(&hrCondAttr);
+    pthread_condattr_setclock(&hrCondAttr, CLOCK_MONOTONIC);
+    pthread_cond_init(&l_hrTimerCond, &hrCondAttr);
+    pthread_condattr_destroy(&hrCondAttr);
+#endif
+#endif
     l_tickPrio = sched_get_priority_min(SCHED_FIFO); /* default tick prio */
 
     /* install the SIGINT (Ctrl-C) signal handler */
@@ -151,7 +244,11 @@ int_t QF_run(void) {
 
         pthread_attr_destroy(&attr);
     }
+#if (QF_MAX_HRTIMER > 0U)
+    hrTimerStart(); /* service the high-resolution time events */
+#endif
 
+#ifndef QF_QV_SHARDS
     /* the combined event-loop and background-loop of the QV kernel */
     QF_CRIT_E_();
 
@@ -162,7 +259,7 @@ int_t QF_run(void) {
     while (l_isRunning) {
         /* find the maximum priority AO ready to run */
         if (QPSet_notEmpty(&QF_readySet_)) {
-            uint_fast8_t p = QPSet_findMax(&QF_readySet_);
+            uint_fast16_t p = QPSet_findMax(&QF_readySet_);
             QActive *a = QActive_registry_[p];
             QF_CRIT_X_();
 
@@ -199,10 +296,23 @@ int_t QF_run(void) {
         }
     }
     QF_CRIT_X_();
+#else
+    QF_CRIT_E_();
+
+    /* produce the QS_QF_RUN trace record */
+    QS_BEGIN_NOCRIT_PRE_(QS_QF_RUN, 0U)
+    QS_END_NOCRIT_PRE_()
+
+    QF_CRIT_X_();
+
+    shardsRun(); /* the QV event loops on several CPU cores, see NOTE09 */
+#endif /* QF_QV_SHARDS */
     QF_onCleanup();  /* cleanup callback */
     QS_EXIT();       /* cleanup the QSPY connection */
 
+#ifndef QF_QV_SHARDS
     pthread_cond_destroy(&QV_condVar_); /* cleanup the condition variable */
+#endif
     pthread_mutex_destroy(&l_pThreadMutex); /* cleanup the global mutex */
 
     return 0; /* return success */
@@ -218,14 +328,45 @@ void QF_setTickRate(uint32_t ticksPerSec, int_t tickPrio) {
     l_tickPrio = tickPrio;
 }
 /*..........................................................................*/
+void QF_getTickStats(QF_TickStats * const stats) {
+    QF_CRIT_STAT_
+    QF_CRIT_E_();
+    *stats = l_tickStats;
+    stats->avgLat = (l_tickStats.nTicks != 0U)
+                    ? (uint32_t)(l_tickLatSum / l_tickStats.nTicks)
+                    : 0U;
+    QF_CRIT_X_();
+}
+/*..........................................................................*/
 void QF_stop(void) {
-    uint_fast8_t p;
     l_isRunning = false; /* terminate the main event-loop thread */
+#ifdef QF_TICKLESS
+    /* wake up the ticker sleeping until the next time event expiration */
+    pthread_mutex_lock(&l_tickerMutex);
+    l_tickerWake = true;
+    pthread_cond_signal(&l_tickerWakeCond);
+    pthread_mutex_unlock(&l_tickerMutex);
+#endif
+#if (QF_MAX_HRTIMER > 0U)
+    /* wake up the high-resolution time event thread */
+    pthread_mutex_lock(&l_pThreadMutex);
+    QF_hrTimerSet_(1U); /* the deadline long past */
+    pthread_mutex_unlock(&l_pThreadMutex);
+#endif
 
+#ifndef QF_QV_SHARDS
     /* unblock the event-loop so it can terminate */
-    p = 1U;
+    uint_fast16_t p = 1U;
     QPSet_insert(&QF_readySet_, p);
     pthread_cond_signal(&QV_condVar_);
+#else
+    /* unblock the event-loops of all shards so they can terminate */
+    for (uint_fast8_t n = 0U; n < QF_QV_SHARDS; ++n) {
+        pthread_mutex_lock(&l_shard[n].mutex);
+        pthread_cond_signal(&l_shard[n].cond);
+        pthread_mutex_unlock(&l_shard[n].mutex);
+    }
+#endif
 }
 
 /*..........................................................................*/
@@ -269,8 +410,14 @@ void QActive_start_(QActive * const me, QPrioSpec const prioSpec,
     Q_REQUIRE_ID(600, (stkSto == (void *)0));
     QEQueue_init(&me->eQueue, qSto, qLen);
 
-    me->prio  = (uint8_t)(prioSpec & 0xFFU); /* QF-priority of the AO */
-    me->pthre = (uint8_t)(prioSpec >> 8U);   /* preemption-threshold */
+    me->prio  = QF_PRIO_SPEC_PRIO_(prioSpec);  /* QF-priority of the AO */
+    me->pthre = QF_PRIO_SPEC_PTHRE_(prioSpec); /* preemption-threshold */
+#ifdef QF_QV_SHARDS
+    pthread_mutex_init(&me->osObject.mutex, NULL);
+    if (me->osObject.shard == 0U) { /* shard not set by QActive_setAttr()? */
+        me->osObject.shard = (uint8_t)(((me->prio - 1U) % QF_QV_SHARDS) + 1U);
+    }
+#endif
     QActive_register_(me); /* register this AO */
 
     /* the top-most initial tran. (virtual) */
@@ -285,30 +432,443 @@ void QActive_stop(QActive * const me) {
     QActive_unsubscribeAll(me); /* unsubscribe from all events */
 
     /* make sure the AO is no longer in "ready set" */
+#ifndef QF_QV_SHARDS
     QF_CRIT_E_();
     QPSet_remove(&QF_readySet_, me->prio);
     QF_CRIT_X_();
+#else
+    QF_QVShard * const sh = &l_shard[me->osObject.shard - 1U];
+    pthread_mutex_lock(&sh->mutex);
+    QPSet_remove(&sh->readySet, me->prio);
+    pthread_mutex_unlock(&sh->mutex);
+#endif
 
     QActive_unregister_(me); /* un-register this active object */
 }
 #endif
 /*..........................................................................*/
 void QActive_setAttr(QActive *const me, uint32_t attr1, void const *attr2) {
+#ifndef QF_QV_SHARDS
     (void)me;    /* unused parameter */
     (void)attr1; /* unused parameter */
     (void)attr2; /* unused parameter */
     Q_ERROR_ID(900); /* this function should not be called in this QP port */
+#else
+    /* the shard must be selected before QACTIVE_START(), see NOTE3 in
+    * qf_port.h
+    */
+    Q_REQUIRE_ID(900, (me->prio == 0U)
+                      && (attr1 == (uint32_t)QV_SHARD_ATTR)
+                      && (attr2 != (void *)0)
+                      && (*(uint8_t const *)attr2 < QF_QV_SHARDS));
+    me->osObject.shard = (uint8_t)(*(uint8_t const *)attr2 + 1U);
+#endif
+}
+
+#ifdef QF_QV_SHARDS
+/****************************************************************************/
+/* the QV event loops on several CPU cores, see NOTE09 */
+void QF_shardSignal_(QActive const * const act) {
+    /* the AO must be started (called inside the AO's queue crit. section) */
+    Q_ASSERT_ID(410, act->osObject.shard != 0U);
+
+    QF_QVShard * const sh = &l_shard[act->osObject.shard - 1U];
+    pthread_mutex_lock(&sh->mutex);
+    QPSet_insert(&sh->readySet, act->prio);
+    if (sh->isWaiting) { /* wake up only the shard of this AO */
+        pthread_cond_signal(&sh->cond);
+    }
+    pthread_mutex_unlock(&sh->mutex);
+}
+/*..........................................................................*/
+/* pin the calling thread to the CPU core of the given shard */
+static void shardPin(uint_fast8_t const n) {
+#ifdef __linux__
+    long const nCpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (nCpus > 0) {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET((int)((long)n % nCpus), &cpuSet);
+        (void)pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+    }
+
+    char name[16];
+    snprintf(name, sizeof(name), "qv%u", (unsigned)n);
+    pthread_setname_np(pthread_self(), name);
+#else
+    (void)n; /* unused parameter */
+#endif
+}
+/*..........................................................................*/
+/* the combined event-loop and background-loop of one shard */
+static void shardLoop(QF_QVShard * const sh) {
+    pthread_mutex_lock(&sh->mutex);
+    while (l_isRunning) {
+        /* find the maximum priority AO of this shard ready to run */
+        if (QPSet_notEmpty(&sh->readySet)) {
+            uint_fast16_t const p = QPSet_findMax(&sh->readySet);
+            QActive * const a = QActive_registry_[p];
+            pthread_mutex_unlock(&sh->mutex);
+
+            /* the active object 'a' must still be registered in QF
+            * (e.g., it must not be stopped)
+            */
+            Q_ASSERT_ID(320, a != (QActive *)0);
+
+            /* perform the run-to-completion (RTC) step, as in QF_run() */
+            QEvt const *e = QActive_get_(a);
+            QHSM_DISPATCH(&a->super, e, a->prio);
+            QF_gc(e);
+
+            /* the AO's queue before the shard, as in QF_shardSignal_() */
+            QF_ACTQ_CRIT_E_(a);
+            pthread_mutex_lock(&sh->mutex);
+            if (a->eQueue.frontEvt == (QEvt *)0) { /* empty queue? */
+                QPSet_remove(&sh->readySet, p);
+            }
+            QF_ACTQ_CRIT_X_(a);
+        }
+        else {
+            /* efficiently wait until an AO of this shard becomes ready */
+            sh->isWaiting = true;
+            while (QPSet_isEmpty(&sh->readySet) && l_isRunning) {
+                pthread_cond_wait(&sh->cond, &sh->mutex);
+            }
+            sh->isWaiting = false;
+        }
+    }
+    pthread_mutex_unlock(&sh->mutex);
+}
+/*..........................................................................*/
+static void *shardThread(void *arg) { /* for pthread_create() */
+    QF_QVShard * const sh = (QF_QVShard *)arg;
+    shardPin((uint_fast8_t)(sh - &l_shard[0]));
+    shardLoop(sh);
+    return (void *)0; /* return success */
+}
+/*..........................................................................*/
+static void shardsRun(void) {
+    /* the shards 1..QF_QV_SHARDS-1 run in their own p-threads */
+    for (uint_fast8_t n = 1U; n < QF_QV_SHARDS; ++n) {
+        int const err = pthread_create(&l_shard[n].thread, NULL,
+                                       &shardThread, &l_shard[n]);
+        Q_ASSERT_ID(350, err == 0); /* the shard thread must be created */
+    }
+
+    /* the shard 0 runs in the calling thread */
+    l_shard[0].thread = pthread_self();
+    (void)shardThread(&l_shard[0]);
+
+    for (uint_fast8_t n = 1U; n < QF_QV_SHARDS; ++n) {
+        pthread_join(l_shard[n].thread, NULL);
+    }
+    for (uint_fast8_t n = 0U; n < QF_QV_SHARDS; ++n) {
+        pthread_cond_destroy(&l_shard[n].cond);
+        pthread_mutex_destroy(&l_shard[n].mutex);
+    }
 }
+#endif /* QF_QV_SHARDS */
 
 /****************************************************************************/
 static void *ticker_thread(void *arg) { /* for pthread_create() */
     (void)arg; /* unused parameter */
+
+#ifndef QF_TICKLESS
+    /* the absolute deadline of the next clock tick, see NOTE06 */
+    struct timespec next;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+
     while (l_isRunning) { /* the clock tick loop... */
-        nanosleep(&l_tick, NULL); /* sleep for the number of ticks, NOTE05 */
+        tickerSleep(&next); /* sleep until the next tick deadline */
         QF_onClockTick(); /* clock tick callback (must call QTIMEEVT_TICK_X()) */
     }
+#else
+    tickerLoop((int64_t)l_tick.tv_nsec); /* the first tick after one period */
+#endif
     return (void *)0; /* return success */
 }
+/*..........................................................................*/
+/* time difference (a - b) [ns] */
+static int64_t timespecDiff(struct timespec const * const a,
+                            struct timespec const * const b)
+{
+    return ((int64_t)(a->tv_sec - b->tv_sec) * NANOSLEEP_NSEC_PER_SEC)
+           + (int64_t)(a->tv_nsec - b->tv_nsec);
+}
+/*..........................................................................*/
+static void timespecAdd(struct timespec * const t, int64_t const nsec) {
+    int64_t const ns = (int64_t)t->tv_nsec + nsec;
+    t->tv_sec  += (time_t)(ns / NANOSLEEP_NSEC_PER_SEC);
+    t->tv_nsec  = (long)(ns % NANOSLEEP_NSEC_PER_SEC);
+}
+/*..........................................................................*/
+/* update the statistics of the clock tick deadlines, see NOTE06 */
+static void tickerStat(uint32_t const overruns, int64_t lat) {
+    QF_CRIT_STAT_
+
+    if (lat < 0) { /* woken up before the deadline (e.g., by a signal)? */
+        lat = 0;
+    }
+    else if (lat > (int64_t)UINT32_MAX) {
+        lat = (int64_t)UINT32_MAX;
+    }
+    else {
+        /* latency within the range */
+    }
+
+    QF_CRIT_E_();
+    if ((l_tickStats.nTicks == 0U)
+        || ((uint32_t)lat < l_tickStats.minLat))
+    {
+        l_tickStats.minLat = (uint32_t)lat;
+    }
+    if ((uint32_t)lat > l_tickStats.maxLat) {
+        l_tickStats.maxLat = (uint32_t)lat;
+    }
+    ++l_tickStats.nTicks;
+    l_tickStats.nOverruns += overruns;
+    l_tickLatSum += (uint64_t)lat;
+    QF_CRIT_X_();
+}
+
+#ifndef QF_TICKLESS
+/*..........................................................................*/
+/* sleep until the absolute deadline of the next tick, see NOTE06 */
+static void tickerSleep(struct timespec * const next) {
+    int64_t const period = (int64_t)l_tick.tv_nsec;
+    struct timespec now;
+    uint32_t overruns = 0U;
+
+    timespecAdd(next, period);
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    int64_t const late = timespecDiff(&now, next);
+    if (late >= 0) { /* the deadline already passed? */
+#ifdef QF_TICK_CATCH_UP
+        overruns = 1U; /* the missed tick follows without sleeping */
+#else
+        /* skip all missed ticks, but keep the phase of the deadlines */
+        overruns = (uint32_t)((late / period) + 1);
+        timespecAdd(next, (int64_t)overruns * period);
+#endif
+    }
+
+#ifdef TIMER_ABSTIME
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, next, NULL)
+           == EINTR)
+    {
+        /* interrupted by a signal, sleep again */
+    }
+#else /* no clock_nanosleep(), sleep for the time left to the deadline */
+    int64_t const left = timespecDiff(next, &now);
+    if (left > 0) {
+        struct timespec rel = { 0, 0 };
+        timespecAdd(&rel, left);
+        nanosleep(&rel, NULL);
+    }
+#endif
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    tickerStat(overruns, timespecDiff(&now, next));
+}
+
+#else /* QF_TICKLESS */
+/*..........................................................................*/
+/* the number of clock ticks the ticker can sleep (0 for no limit) */
+static uint32_t tickerPlan(void) {
+    /* the other tick rates are derived from the rate 0 in the application,
+    * so the ticker keeps ticking while any of them is in use, see NOTE07
+    */
+    for (uint_fast8_t tickRate = 1U; tickRate < QF_MAX_TICK_RATE;
+         ++tickRate)
+    {
+        if (QTimeEvt_ticksToNext(tickRate) != 0U) {
+            return 1U;
+        }
+    }
+    return (uint32_t)QTimeEvt_ticksToNext(0U);
+}
+/*..........................................................................*/
+/* the "tickless" ticker loop, see NOTE07 */
+static void tickerLoop(int64_t const delay) {
+    int64_t const period = (int64_t)l_tick.tv_nsec;
+    struct timespec now;
+
+    pthread_mutex_lock(&l_tickerMutex);
+    l_tickerThread = pthread_self();
+    clock_gettime(CLOCK_MONOTONIC, &l_tickerNext);
+    timespecAdd(&l_tickerNext, delay); /* the first clock tick */
+    while (l_isRunning) {
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        if (timespecDiff(&now, &l_tickerNext) >= 0) { /* tick due? */
+            pthread_mutex_unlock(&l_tickerMutex);
+            QF_onClockTick(); /* callback (must call QTIMEEVT_TICK_X()) */
+            pthread_mutex_lock(&l_tickerMutex);
+
+            timespecAdd(&l_tickerNext, period);
+            pthread_cond_broadcast(&l_tickerSyncCond); /* one more tick */
+            continue;
+        }
+
+        /* all due ticks delivered */
+        if (l_tickerLong) {
+            l_tickerLong = false;
+            pthread_cond_broadcast(&l_tickerSyncCond);
+        }
+
+        /* any time event armed while planning wakes up the ticker */
+        l_tickerWake = false;
+        l_tickerPlan = UINT32_MAX;
+        pthread_mutex_unlock(&l_tickerMutex);
+        uint32_t const nTicks = tickerPlan();
+        pthread_mutex_lock(&l_tickerMutex);
+
+        if ((!l_tickerWake) && l_isRunning) {
+            l_tickerPlan = (nTicks != 0U) ? nTicks : UINT32_MAX;
+            l_tickerLong = (l_tickerPlan > 1U);
+            l_tickerSleeping = true;
+            if (nTicks != 0U) { /* sleep until the nearest expiration */
+                struct timespec deadline = l_tickerNext;
+                timespecAdd(&deadline, (int64_t)(nTicks - 1U) * period);
+                int err = 0;
+                while ((!l_tickerWake) && (err != ETIMEDOUT)) {
+                    err = pthread_cond_timedwait(&l_tickerWakeCond,
+                                                 &l_tickerMutex, &deadline);
+                }
+                if (err == ETIMEDOUT) {
+                    clock_gettime(CLOCK_MONOTONIC, &now);
+                    tickerStat(0U, timespecDiff(&now, &deadline));
+                }
+            }
+            else { /* no time events armed, sleep until woken up */
+                while (!l_tickerWake) {
+                    pthread_cond_wait(&l_tickerWakeCond, &l_tickerMutex);
+                }
+            }
+            l_tickerSleeping = false;
+        }
+    }
+    l_tickerLong = false;
+    pthread_cond_broadcast(&l_tickerSyncCond);
+    pthread_mutex_unlock(&l_tickerMutex);
+}
+/*..........................................................................*/
+/* deliver the clock ticks skipped by the ticker before arming a time event */
+void QF_ticklessSync_(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    pthread_mutex_lock(&l_tickerMutex);
+    if (!pthread_equal(pthread_self(), l_tickerThread)) {
+        while (l_tickerLong && (timespecDiff(&now, &l_tickerNext) >= 0)) {
+            if (l_tickerSleeping) {
+                l_tickerWake = true;
+                pthread_cond_signal(&l_tickerWakeCond);
+            }
+            pthread_cond_wait(&l_tickerSyncCond, &l_tickerMutex);
+        }
+    }
+    pthread_mutex_unlock(&l_tickerMutex);
+}
+/*..........................................................................*/
+/* wake up the ticker when a time event expires sooner than planned */
+void QF_ticklessWake_(uint_fast8_t const tickRate, QTimeEvtCtr const nTicks) {
+    pthread_mutex_lock(&l_tickerMutex);
+    if ((tickRate != 0U)
+        ? (l_tickerPlan > 1U)
+        : ((uint32_t)nTicks < l_tickerPlan))
+    {
+        l_tickerWake = true;
+        if (l_tickerSleeping) {
+            pthread_cond_signal(&l_tickerWakeCond);
+        }
+    }
+    pthread_mutex_unlock(&l_tickerMutex);
+}
+#endif /* QF_TICKLESS */
+
+#if (QF_MAX_HRTIMER > 0U)
+/****************************************************************************/
+/* high-resolution time events, see NOTE08 */
+uint64_t QF_hrTimeNow(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * (uint64_t)NANOSLEEP_NSEC_PER_SEC)
+           + (uint64_t)now.tv_nsec;
+}
+/*..........................................................................*/
+/* set the earliest deadline (called inside the QF critical section) */
+void QF_hrTimerSet_(uint64_t const deadline) {
+#ifdef __linux__
+    struct itimerspec its;
+    memset(&its, 0, sizeof(its)); /* one-shot; all zeros disarm the timer */
+    its.it_value.tv_sec  = (time_t)(deadline / NANOSLEEP_NSEC_PER_SEC);
+    its.it_value.tv_nsec = (long)(deadline % NANOSLEEP_NSEC_PER_SEC);
+    timerfd_settime(l_hrTimerFd, TFD_TIMER_ABSTIME, &its, NULL);
+#else
+    l_hrTimerDeadline = deadline;
+    pthread_cond_signal(&l_hrTimerCond);
+#endif
+}
+/*..........................................................................*/
+static void *hrTimerThread(void *arg) { /* for pthread_create() */
+    (void)arg; /* unused parameter */
+#ifdef __linux__
+    while (l_isRunning) {
+        uint64_t nExp;
+        /* block until the earliest deadline passes */
+        if (read(l_hrTimerFd, &nExp, sizeof(nExp)) > 0) {
+            QHrTimeEvt_expire_(QF_hrTimeNow(), &l_hrTimerThread);
+        }
+    }
+#else
+    pthread_mutex_lock(&l_pThreadMutex);
+    while (l_isRunning) {
+        uint64_t const deadline = l_hrTimerDeadline;
+        if (deadline == 0U) { /* no time events armed? */
+            pthread_cond_wait(&l_hrTimerCond, &l_pThreadMutex);
+        }
+        else if (QF_hrTimeNow() < deadline) {
+            struct timespec ts;
+            ts.tv_sec  = (time_t)(deadline / NANOSLEEP_NSEC_PER_SEC);
+            ts.tv_nsec = (long)(deadline % NANOSLEEP_NSEC_PER_SEC);
+            pthread_cond_timedwait(&l_hrTimerCond, &l_pThreadMutex, &ts);
+        }
+        else {
+            l_hrTimerDeadline = 0U; /* set again in QHrTimeEvt_expire_() */
+            pthread_mutex_unlock(&l_pThreadMutex);
+            QHrTimeEvt_expire_(QF_hrTimeNow(), &l_hrTimerThread);
+            pthread_mutex_lock(&l_pThreadMutex);
+        }
+    }
+    pthread_mutex_unlock(&l_pThreadMutex);
+#endif
+    return (void *)0; /* return success */
+}
+/*..........................................................................*/
+static void hrTimerStart(void) {
+    pthread_attr_t attr;
+    struct sched_param param;
+
+    /* the same real-time priority as the clock tick, see NOTE08 */
+    pthread_attr_init(&attr);
+    pthread_attr_setschedpolicy (&attr, SCHED_FIFO);
+    pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+    pthread_attr_setdetachstate (&attr, PTHREAD_CREATE_DETACHED);
+    param.sched_priority = l_tickPrio;
+    pthread_attr_setschedparam(&attr, &param);
+
+    int err = pthread_create(&l_hrTimerThread, &attr, &hrTimerThread, 0);
+    if (err != 0) { /* no privileges for SCHED_FIFO? */
+        pthread_attr_setschedpolicy(&attr, SCHED_OTHER);
+        param.sched_priority = 0;
+        pthread_attr_setschedparam(&attr, &param);
+        err = pthread_create(&l_hrTimerThread, &attr, &hrTimerThread, 0);
+    }
+    Q_ASSERT_ID(340, err == 0); /* the thread must be created */
+    pthread_attr_destroy(&attr);
+}
+#endif /* (QF_MAX_HRTIMER > 0U) */
+
 /*..........................................................................*/
 static void sigIntHandler(int dummy) {
     (void)dummy; /* unused parameter */
@@ -357,5 +917,62 @@ static void sigIntHandler(int dummy) {
 * In some (older) Linux kernels, the POSIX nanosleep() system call might
 * deliver only 2*actual-system-tick granularity. To compensate for this,
 * you would need to reduce the constant NANOSLEEP_NSEC_PER_SEC by factor 2.
+*
+* NOTE06:
+* The ticker thread sleeps until absolute deadlines spaced exactly one tick
+* period apart (clock_nanosleep() with TIMER_ABSTIME on CLOCK_MONOTONIC), so
+* the time spent in QF_onClockTick() does not stretch the tick period and
+* the tick rate does not drift. When a deadline has already passed before
+* the ticker goes to sleep, the missed ticks are counted as overruns and by
+* default skipped, keeping the phase of the following deadlines. Defining
+* QF_TICK_CATCH_UP delivers the missed ticks back-to-back instead. The
+* latency of every wake-up past its deadline is recorded as well. The
+* cumulative statistics are available from QF_getTickStats(), which the
+* application can report, for example, in its own QS user record.
+*
+* NOTE07:
+* When the macro QF_TICKLESS is defined (e.g., -DQF_TICKLESS), the ticker thread
+* does not wake up at every clock tick. Instead, it sleeps until the tick
+* at which the nearest time event expires (QTimeEvt_ticksToNext()) or
+* indefinitely when no time events are armed. The clock ticks skipped in the
+* meantime are delivered back-to-back by calling QF_onClockTick() when the
+* ticker wakes up, so the tick counts stay identical to the periodic clock
+* tick. Arming a time event that expires sooner than planned wakes up the
+* ticker (QF_ticklessWake_()). Before a time event is armed, the ticks whose
+* deadlines have already passed are delivered first (QF_ticklessSync_()), so
+* the time event expires at the same clock tick as with the periodic tick.
+* Time events armed at the tick rates other than 0 keep the ticker ticking
+* periodically, because QF_onClockTick() derives these rates from the rate 0.
+* Consequently, QF_onClockTick() should only call QTIMEEVT_TICK_X() (and not
+* poll for inputs, for example). In this mode, QF_getTickStats() covers
+* the timed wake-ups of the ticker.
+*
+* NOTE08:
+* The high-resolution time events (QHrTimeEvt, up to QF_MAX_HRTIMER armed
+* at a time) are kept by QF in a heap sorted by the deadline in nanoseconds
+* of CLOCK_MONOTONIC (QF_hrTimeNow()). QF calls QF_hrTimerSet_() with the
+* earliest deadline whenever it changes. On Linux, this deadline is set as
+* the absolute expiration time of a timerfd, which the dedicated time event
+* thread reads (blocks on). Elsewhere, this thread waits for the deadline on
+* a condition variable on CLOCK_MONOTONIC. Either way, the expired time
+* events are posted by QHrTimeEvt_expire_() independently from the clock
+* tick, so their resolution is limited only by the OS timer slack and the
+* wake-up latency of the thread. The thread runs at the same priority as the
+* ticker (see QF_setTickRate()).
+*
+* NOTE09:
+* With QF_QV_SHARDS (see NOTE3 in qf_port.h), QF_run() runs the shard 0 in
+* the calling thread and creates one p-thread for every other shard. On
+* Linux, the shard n is pinned to the CPU core (n % number of online cores)
+* and its thread is named "qv<n>". Every shard is protected by its own
+* mutex, which is always acquired after the mutex of an AO's event queue:
+* posting an event inserts the recipient into the ready set of its shard
+* (QF_shardSignal_()) while holding the mutex of the recipient's queue, and
+* the event loop of the shard removes the AO from the ready set only after
+* it checks the AO's queue is empty under the same two mutexes. This way an
+* AO can never be left with events but not ready. The event loop of a shard
+* waits on its own condition variable, which is signaled only when the loop
+* is actually waiting. The ticker thread and the high-resolution time event
+* thread are created before the shards and are not pinned.
 */
 
@@ -34,15 +34,22 @@
 
 /* POSIX-QV event queue and thread types */
 #define QF_EQUEUE_TYPE  QEQueue
-/* QF_OS_OBJECT_TYPE not used in this port */
+/* QF_OS_OBJECT_TYPE used only with QF_QV_SHARDS, see NOTE3 */
 /* QF_THREAD_TYPE    not used in this port */
 
-/* The maximum number of active objects in the application */
+/* The maximum number of active objects in the application, see NOTE2 */
+#ifndef QF_MAX_ACTIVE
 #define QF_MAX_ACTIVE        64U
+#endif
 
 /* The number of system clock tick rates */
 #define QF_MAX_TICK_RATE     2U
 
+/* The maximum number of armed high-resolution time events */
+#ifndef QF_MAX_HRTIMER
+#define QF_MAX_HRTIMER       64U
+#endif
+
 /* Activate the QF QActive_stop() API */
 #define QF_ACTIVE_STOP       1
 
@@ -58,11 +65,48 @@
 #define QF_CRIT_ENTRY(dummy) QF_enterCriticalSection_()
 #define QF_CRIT_EXIT(dummy)  QF_leaveCriticalSection_()
 
-/* QF_LOG2 not defined -- use the internal LOG2() implementation */
+/* QF_LOG2 with the count-leading-zeros builtin of the compiler, see NOTE2 */
+#ifdef __GNUC__
+#define QF_LOG2(n_) ((uint_fast8_t)(((n_) != 0U) \
+    ? (32U - (uint_fast8_t)__builtin_clz((unsigned)(n_))) : 0U))
+#endif
+
+/* QV event loops on several CPU cores (optional), see NOTE3 */
+#ifdef QF_QV_SHARDS
+
+    #if (QF_QV_SHARDS < 2U) || (QF_QV_SHARDS > 64U)
+        #error "QF_QV_SHARDS defined incorrectly, expected 2U..64U"
+    #endif
+
+    #include <pthread.h> /* POSIX-thread API */
+
+    /* the event loops run concurrently, see NOTE3 */
+    #define QF_OBJ_CRIT
+
+    #define QF_OS_OBJECT_TYPE  QF_ActiveOSObject
+
+    /* separate mutex in every memory pool */
+    #define QF_MPOOL_CRIT_TYPE pthread_mutex_t
+
+#endif /* QF_QV_SHARDS */
 
 #include "qep_port.h"  /* QEP port */
 #include "qequeue.h"   /* POSIX-QV needs event-queue */
 #include "qmpool.h"    /* POSIX-QV needs memory-pool */
+
+#ifdef QF_QV_SHARDS
+/* QActive "OS-object" in the sharded QV, see NOTE3 */
+typedef struct {
+    pthread_mutex_t mutex; /* protects the AO's event queue */
+    uint8_t shard;         /* shard of the AO + 1 (0 for the default) */
+} QF_ActiveOSObject;
+
+/* attributes of the AOs for QActive_setAttr(), see NOTE3 */
+enum QF_ActiveShardAttrs {
+    QV_SHARD_ATTR /* attr2: uint8_t const * (shard 0..QF_QV_SHARDS-1) */
+};
+#endif /* QF_QV_SHARDS */
+
 #include "qf.h"        /* QF platform-independent public interface */
 
 void QF_enterCriticalSection_(void);
@@ -73,7 +117,29 @@ void QF_leaveCriticalSection_(void);
 */
 void QF_setTickRate(uint32_t ticksPerSec, int_t tickPrio);
 
-/* clock tick callback (NOTE not called when "ticker thread" is not running) */
+/* statistics of the clock tick deadlines, see NOTE06 in qf_port.c */
+typedef struct {
+    uint32_t nTicks;    /* number of clock ticks */
+    uint32_t nOverruns; /* number of missed tick deadlines */
+    uint32_t minLat;    /* minimum wake-up latency past the deadline [ns] */
+    uint32_t maxLat;    /* maximum wake-up latency past the deadline [ns] */
+    uint32_t avgLat;    /* average wake-up latency past the deadline [ns] */
+} QF_TickStats;
+
+/* obtain the cumulative statistics of the clock tick deadlines */
+void QF_getTickStats(QF_TickStats * const stats);
+
+#if (QF_MAX_HRTIMER > 0U)
+/* current CLOCK_MONOTONIC time [ns] for QHrTimeEvt, see NOTE08 in qf_port.c */
+uint64_t QF_hrTimeNow(void);
+#endif
+
+/* clock tick callback (NOTE not called when "ticker thread" is not running)
+* NOTE: with QF_TICKLESS, QF_onClockTick() must only call QTIMEEVT_TICK_X()
+* (for any tick rates), because the skipped ticks are delivered back-to-back
+* when the ticker wakes up. Polling inputs or other periodic work must be
+* done elsewhere (e.g., in a time event handler), see NOTE07 in qf_port.c.
+*/
 void QF_onClockTick(void); /* clock tick callback (provided in the app) */
 
 /* abstractions for console access... */
@@ -95,11 +161,41 @@ int QF_consoleWaitForKey(void);
     #define QACTIVE_EQUEUE_WAIT_(me_) \
         Q_ASSERT((me_)->eQueue.frontEvt != (QEvt *)0)
 
+#ifndef QF_QV_SHARDS
+
     #define QACTIVE_EQUEUE_SIGNAL_(me_) do { \
         QPSet_insert(&QF_readySet_, (me_)->prio); \
         pthread_cond_signal(&QV_condVar_); \
     } while (false)
 
+#else /* QV event loops on several CPU cores, see NOTE3 */
+
+    /* critical section of the AO's event queue */
+    #define QF_ACTQ_CRIT_ENTRY(me_) \
+        pthread_mutex_lock(&(me_)->osObject.mutex)
+    #define QF_ACTQ_CRIT_EXIT(me_) \
+        pthread_mutex_unlock(&(me_)->osObject.mutex)
+
+    /* critical section of the memory pool */
+    #define QF_MPOOL_CRIT_INIT(me_)  pthread_mutex_init(&(me_)->crit, NULL)
+    #define QF_MPOOL_CRIT_ENTRY(me_) pthread_mutex_lock(&(me_)->crit)
+    #define QF_MPOOL_CRIT_EXIT(me_)  pthread_mutex_unlock(&(me_)->crit)
+
+    /* critical section of the time events at a given tick rate */
+    #define QF_TIMEEVT_CRIT_ENTRY(rate_) \
+        pthread_mutex_lock(&QF_timeEvtMutex_[(rate_)])
+    #define QF_TIMEEVT_CRIT_EXIT(rate_) \
+        pthread_mutex_unlock(&QF_timeEvtMutex_[(rate_)])
+
+    /* make the AO ready in its shard and wake up only that shard */
+    #define QACTIVE_EQUEUE_SIGNAL_(me_) QF_shardSignal_((me_))
+    void QF_shardSignal_(QActive const * const act);
+
+    /* mutexes for the time events at each tick rate */
+    extern pthread_mutex_t QF_timeEvtMutex_[QF_MAX_TICK_RATE];
+
+#endif /* QF_QV_SHARDS */
+
     /* native QF event pool operations */
     #define QF_EPOOL_TYPE_            QMPool
     #define QF_EPOOL_INIT_(p_, poolSto_, poolSize_, evtSize_) \
@@ -112,7 +208,25 @@ int QF_consoleWaitForKey(void);
 
     #include <pthread.h> /* POSIX-thread API */
 
+#ifndef QF_QV_SHARDS
     extern pthread_cond_t QV_condVar_; /* Cond.var. to signal events */
+#endif
+
+#ifdef QF_TICKLESS
+    /* "tickless" clock tick hooks, see NOTE07 in qf_port.c */
+    #define QF_TICKLESS_SYNC_(rate_) QF_ticklessSync_()
+    #define QF_TICKLESS_WAKE_(rate_, nTicks_) \
+        QF_ticklessWake_((rate_), (nTicks_))
+    void QF_ticklessSync_(void);
+    void QF_ticklessWake_(uint_fast8_t const tickRate,
+                          QTimeEvtCtr const nTicks);
+#endif
+
+#if (QF_MAX_HRTIMER > 0U)
+    /* high-resolution time event hook, see NOTE08 in qf_port.c */
+    #define QF_HRTIMER_SET_(deadline_) QF_hrTimerSet_((deadline_))
+    void QF_hrTimerSet_(uint64_t const deadline);
+#endif
 
 #endif /* QP_IMPL */
 
@@ -145,6 +259,33 @@ int QF_consoleWaitForKey(void);
 * also subject to priority inversions. However, the p-thread mutex
 * implementation, such as POSIX threads, should support the priority-
 * inheritance protocol.
+*
+* NOTE2:
+* The application can define QF_MAX_ACTIVE up to 1024U (e.g.,
+* -DQF_MAX_ACTIVE=512U). Beyond 64U, the ready set is a two-level bitmap
+* with the summary word (see ::QPSet), and QF_LOG2() uses the CLZ builtin
+* of the compiler, so that finding the highest-priority ready AO in the
+* event loop remains O(1). QS software tracing is not available with more
+* than 64 active objects.
+*
+* NOTE3:
+* When the macro QF_QV_SHARDS is defined (e.g., -DQF_QV_SHARDS=4U), QF_run()
+* runs that many QV event loops ("shards"), each in its own p-thread pinned
+* to its own CPU core (Linux only). Every AO is statically assigned to one
+* shard, by default to the shard (prio - 1) % QF_QV_SHARDS, or to the shard
+* selected with QActive_setAttr(me, QV_SHARD_ATTR, &shard) before
+* QACTIVE_START(). Every shard has its own ready set and condition variable,
+* so posting an event wakes up only the shard of the recipient. Within a
+* shard the AOs are scheduled exactly like in the single QV event loop (the
+* highest-priority ready AO runs to completion first), but the AOs of
+* different shards run in parallel and must not share data without
+* synchronization. Because the shards run concurrently, this option implies
+* the object-level critical sections (QF_OBJ_CRIT): every AO event queue,
+* every event pool and the time events at every tick rate have their own
+* mutex, the QS tracing uses its own mutex (see qs_port.h) and the event
+* reference counters are updated atomically. The single QF critical section
+* still protects the rest of the framework, such as the publish-subscribe
+* lists. QActive_stop() must be called by the AO itself.
 */
 
 #endif /* QF_PORT_H */
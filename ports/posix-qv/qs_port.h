@@ -57,6 +57,16 @@ void QS_rx_input(void);  /* handle the QS-RX input */
 #include "qf_port.h" /* use QS with QF */
 #endif
 
+#ifdef QF_OBJ_CRIT
+/* separate QS critical section for the QF object-level critical sections,
+* see NOTE3 in qf_port.h
+*/
+#define QS_CRIT_ENTRY(dummy) pthread_mutex_lock(&QS_pThreadMutex_)
+#define QS_CRIT_EXIT(dummy)  pthread_mutex_unlock(&QS_pThreadMutex_)
+
+extern pthread_mutex_t QS_pThreadMutex_; /* mutex for QS critical section */
+#endif /* QF_OBJ_CRIT */
+
 #include "qs.h"      /* QS platform-independent public interface */
 
 #endif /* QS_PORT_H  */
@@ -0,0 +1,616 @@
+/*============================================================================
+* QP/C Real-Time Embedded Framework (RTEF)
+* Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+*
+* SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+*
+* This software is dual-licensed under the terms of the open source GNU
+* General Public License version 3 (or any later version), or alternatively,
+* under the terms of one of the closed source Quantum Leaps commercial
+* licenses.
+*
+* The terms of the open source GNU General Public License version 3
+* can be found at: <www.gnu.org/licenses/gpl-3.0>
+*
+* The terms of the closed source Quantum Leaps commercial licenses
+* can be found at: <www.state-machine.com/licensing>
+*
+* Redistributions in source code must retain this top-level comment block.
+* Plagiarizing this software to sidestep the license obligations is illegal.
+*
+* Contact information:
+* <www.state-machine.com>
+* <info@state-machine.com>
+============================================================================*/
+/*!
+* @date Last updated on: 2022-10-18
+* @version Last updated for: @ref qpc_7_1_1
+*
+* @file
+* @brief QF/C port to POSIX API (M:N work-stealing executor)
+* @ingroup ports
+*/
+
+/* expose features from the 2008 POSIX standard (IEEE Standard 1003.1-2008) */
+#define _POSIX_C_SOURCE 200809L
+
+#define QP_IMPL           /* this is QP implementation */
+#include "qf_port.h"      /* QF port */
+#include "qf_pkg.h"
+#include "qassert.h"
+#ifdef Q_SPY              /* QS software tracing enabled? */
+    #include "qs_port.h"  /* QS port */
+    #include "qs_pkg.h"   /* QS package-scope internal interface */
+#else
+    #include "qs_dummy.h" /* disable the QS software tracing */
+#endif /* Q_SPY */
+
+#include <limits.h>       /* for PTHREAD_STACK_MIN */
+#include <sys/mman.h>     /* for mlockall() */
+#include <sys/select.h>
+#include <sys/ioctl.h>
+#include <string.h>       /* for memcpy() and memset() */
+#include <stdlib.h>
+#include <stdio.h>
+#include <termios.h>
+#include <unistd.h>       /* for sysconf() */
+#include <signal.h>
+#include <sched.h>        /* for sched_yield() */
+#include <time.h>         /* for clock_gettime() and clock_nanosleep() */
+#include <errno.h>        /* for EINTR */
+
+Q_DEFINE_THIS_MODULE("qf_port")
+
+#if (QF_WS_MAX_WORKERS < 1U) || (QF_WS_MAX_WORKERS > 0xFFFFU)
+    #error "QF_WS_MAX_WORKERS defined incorrectly, expected 1U..65535U"
+#endif
+
+/* scheduling states of an AO, see NOTE2 in qf_port.h */
+enum {
+    QF_WS_IDLE,      /* the event queue is empty */
+    QF_WS_SCHEDULED, /* in a run queue or executed by a worker */
+    QF_WS_STOPPED    /* stopped, unregistered after the current RTC step */
+};
+
+/* the length of every run queue (power of 2 not less than QF_MAX_ACTIVE),
+* so that a run queue cannot overflow, see NOTE01
+*/
+#if (QF_MAX_ACTIVE <= 64U)
+    #define QF_WS_RING   64U
+#elif (QF_MAX_ACTIVE <= 128U)
+    #define QF_WS_RING   128U
+#elif (QF_MAX_ACTIVE <= 256U)
+    #define QF_WS_RING   256U
+#elif (QF_MAX_ACTIVE <= 512U)
+    #define QF_WS_RING   512U
+#else
+    #define QF_WS_RING   1024U
+#endif
+#define QF_WS_CACHE_LINE 64U
+
+/* a worker thread of the executor with its own run queue, see NOTE01 */
+typedef struct {
+    uint32_t volatile head; /* next AO taken by the owner or by a thief */
+    uint8_t pad1[QF_WS_CACHE_LINE - sizeof(uint32_t)];
+    uint32_t volatile tail; /* next free entry (written only by the owner) */
+    uint8_t pad2[QF_WS_CACHE_LINE - sizeof(uint32_t)];
+    QActive * volatile ring[QF_WS_RING]; /* the run queue */
+    QF_WorkerStats stats;   /* written only by the owner */
+    uint32_t seed;          /* random seed for choosing the victims */
+    pthread_t thread;
+} QF_Worker;
+
+/* Global objects ==========================================================*/
+pthread_mutex_t QF_pThreadMutex_; /* mutex for QF critical section */
+pthread_mutex_t QF_timeEvtMutex_[QF_MAX_TICK_RATE];
+
+/* Local objects ===========================================================*/
+static bool volatile l_isRunning;
+static struct termios l_tsav; /* structure with saved terminal attributes */
+static struct timespec l_tick;
+static int_t l_tickPrio;
+enum { NANOSLEEP_NSEC_PER_SEC = 1000000000 }; /* see NOTE03 */
+
+static QF_Worker l_worker[QF_WS_MAX_WORKERS];
+static uint_fast16_t l_nWorkers;
+static __thread QF_Worker *l_self; /* the worker of the calling thread */
+
+/* the injection queue for the AOs scheduled outside the workers, see NOTE02 */
+static pthread_mutex_t l_wsMutex; /* protects the injection queue */
+static pthread_cond_t  l_wsCond;  /* signaled when the work is available */
+static QActive *l_inject[QF_WS_RING];
+static uint32_t l_injectHead;
+static uint32_t l_injectTail;
+static uint32_t volatile l_injectCount; /* read outside of l_wsMutex */
+static uint32_t volatile l_nParked;     /* number of the parked workers */
+
+static void sigIntHandler(int dummy);
+static void tickerSleep(struct timespec * const next);
+
+/* QF functions ============================================================*/
+void QF_init(void) {
+    struct sigaction sig_act;
+
+    /* lock memory so we're never swapped out to disk */
+    /*mlockall(MCL_CURRENT | MCL_FUTURE);  uncomment when supported */
+
+    /* init the global mutex with the default non-recursive initializer */
+    pthread_mutex_init(&QF_pThreadMutex_, NULL);
+
+    /* init the time event mutexes for all tick rates */
+    for (uint_fast8_t tickRate = 0U; tickRate < QF_MAX_TICK_RATE;
+         ++tickRate)
+    {
+        pthread_mutex_init(&QF_timeEvtMutex_[tickRate], NULL);
+    }
+
+    /* init the executor */
+    pthread_mutex_init(&l_wsMutex, NULL);
+    pthread_cond_init(&l_wsCond, NULL);
+    l_nWorkers = 0U; /* one worker per CPU core unless QF_setWorkers() */
+
+    l_tick.tv_sec = 0;
+    l_tick.tv_nsec = NANOSLEEP_NSEC_PER_SEC/100L; /* default clock tick */
+
+    l_tickPrio = sched_get_priority_min(SCHED_FIFO); /* default tick prio */
+
+    /* install the SIGINT (Ctrl-C) signal handler */
+    memset(&sig_act, 0, sizeof(sig_act));
+    sig_act.sa_handler = &sigIntHandler;
+    sigaction(SIGINT, &sig_act, NULL);
+}
+
+/****************************************************************************/
+void QF_enterCriticalSection_(void) {
+    pthread_mutex_lock(&QF_pThreadMutex_);
+}
+/****************************************************************************/
+void QF_leaveCriticalSection_(void) {
+    pthread_mutex_unlock(&QF_pThreadMutex_);
+}
+
+/* executor ================================================================*/
+/* push the AO to the run queue of the calling worker (owner only) */
+static void wsPush(QF_Worker * const w, QActive * const act) {
+    uint32_t const t = w->tail;
+    __atomic_store_n(&w->ring[t & (QF_WS_RING - 1U)], act, __ATOMIC_RELAXED);
+    __atomic_store_n(&w->tail, t + 1U, __ATOMIC_RELEASE);
+}
+/*..........................................................................*/
+/* take the AO from the front of the run queue (owner or thief) */
+static QActive *wsTake(QF_Worker * const w) {
+    uint32_t h = __atomic_load_n(&w->head, __ATOMIC_ACQUIRE);
+    for (;;) {
+        uint32_t const t = __atomic_load_n(&w->tail, __ATOMIC_ACQUIRE);
+        if (h == t) { /* run queue empty? */
+            return (QActive *)0;
+        }
+        QActive * const act =
+            __atomic_load_n(&w->ring[h & (QF_WS_RING - 1U)],
+                            __ATOMIC_RELAXED);
+        /* claim the entry; fails when another thread took it first */
+        if (__atomic_compare_exchange_n(&w->head, &h, h + 1U, false,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+        {
+            return act;
+        }
+    }
+}
+/*..........................................................................*/
+/* take the AO from the injection queue */
+static QActive *wsTakeInjected(void) {
+    QActive *act = (QActive *)0;
+    if (__atomic_load_n(&l_injectCount, __ATOMIC_ACQUIRE) != 0U) {
+        pthread_mutex_lock(&l_wsMutex);
+        if (l_injectHead != l_injectTail) {
+            act = l_inject[l_injectHead & (QF_WS_RING - 1U)];
+            ++l_injectHead;
+            __atomic_sub_fetch(&l_injectCount, 1U, __ATOMIC_RELAXED);
+        }
+        pthread_mutex_unlock(&l_wsMutex);
+    }
+    return act;
+}
+/*..........................................................................*/
+/* steal the AO from the run queue of another worker, see NOTE01 */
+static QActive *wsSteal(QF_Worker * const w) {
+    /* start at a random victim, so that the thieves spread out (xorshift) */
+    uint32_t x = w->seed;
+    x ^= x << 13U;
+    x ^= x >> 17U;
+    x ^= x << 5U;
+    w->seed = x;
+
+    uint_fast16_t const n = l_nWorkers;
+    uint_fast16_t v = (uint_fast16_t)(x % n);
+    for (uint_fast16_t i = 0U; i < n; ++i) {
+        QF_Worker * const victim = &l_worker[v];
+        if (victim != w) {
+            QActive * const act = wsTake(victim);
+            if (act != (QActive *)0) {
+                __atomic_store_n(&w->stats.nSteals, w->stats.nSteals + 1U,
+                                 __ATOMIC_RELAXED);
+                return act;
+            }
+        }
+        v = (v + 1U < n) ? (v + 1U) : 0U;
+    }
+    return (QActive *)0;
+}
+/*..........................................................................*/
+/* is there any work for the workers? */
+static bool wsHasWork(void) {
+    if (__atomic_load_n(&l_injectCount, __ATOMIC_SEQ_CST) != 0U) {
+        return true;
+    }
+    for (uint_fast16_t i = 0U; i < l_nWorkers; ++i) {
+        if (__atomic_load_n(&l_worker[i].head, __ATOMIC_SEQ_CST)
+            != __atomic_load_n(&l_worker[i].tail, __ATOMIC_SEQ_CST))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+/*..........................................................................*/
+/* wake up a parked worker after making work available, see NOTE02 */
+static void wsWake(void) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&l_nParked, __ATOMIC_SEQ_CST) != 0U) {
+        pthread_mutex_lock(&l_wsMutex);
+        pthread_cond_signal(&l_wsCond);
+        pthread_mutex_unlock(&l_wsMutex);
+    }
+}
+/*..........................................................................*/
+/* block the worker until work is available, see NOTE02 */
+static void wsPark(QF_Worker * const w) {
+    pthread_mutex_lock(&l_wsMutex);
+    __atomic_add_fetch(&l_nParked, 1U, __ATOMIC_SEQ_CST);
+    if (l_isRunning && !wsHasWork()) { /* check again after announcing */
+        __atomic_store_n(&w->stats.nParks, w->stats.nParks + 1U,
+                         __ATOMIC_RELAXED);
+        pthread_cond_wait(&l_wsCond, &l_wsMutex);
+    }
+    __atomic_sub_fetch(&l_nParked, 1U, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&l_wsMutex);
+}
+/*..........................................................................*/
+/* execute one RTC step of the scheduled AO */
+static void wsStep(QF_Worker * const w, QActive * const act) {
+    /* perform the run-to-completion (RTC) step...
+    * 1. retrieve the event from the AO's event queue, which by this
+    *    time must be non-empty (the AO is scheduled).
+    * 2. dispatch the event to the AO's state machine.
+    * 3. determine if event is garbage and collect it if so
+    */
+    QEvt const *e = QActive_get_(act);
+    QHSM_DISPATCH(&act->super, e, act->prio);
+    QF_gc(e);
+    __atomic_store_n(&w->stats.nSteps, w->stats.nSteps + 1U,
+                     __ATOMIC_RELAXED);
+
+    QF_ACTQ_CRIT_E_(act);
+    uint8_t const state = act->osObject.state;
+    if (state == (uint8_t)QF_WS_STOPPED) { /* stopped in this RTC step? */
+        QF_ACTQ_CRIT_X_(act);
+        QActive_unregister_(act); /* un-register this active object */
+    }
+    else if (act->eQueue.frontEvt != (QEvt *)0) { /* more events? */
+        wsPush(w, act); /* stays scheduled, behind the other ready AOs */
+        QF_ACTQ_CRIT_X_(act);
+
+        /* other AOs waiting in the run queue? let a parked worker steal */
+        if ((w->tail - __atomic_load_n(&w->head, __ATOMIC_RELAXED)) > 1U) {
+            wsWake();
+        }
+    }
+    else {
+        act->osObject.state = (uint8_t)QF_WS_IDLE;
+        QF_ACTQ_CRIT_X_(act);
+    }
+}
+/*..........................................................................*/
+static void *worker_thread(void *arg) { /* for pthread_create() */
+    QF_Worker * const w = (QF_Worker *)arg;
+    l_self = w;
+
+    while (l_isRunning) {
+        QActive *act = wsTake(w); /* own run queue first */
+        if (act == (QActive *)0) {
+            act = wsTakeInjected();
+        }
+        if (act == (QActive *)0) {
+            act = wsSteal(w);
+        }
+
+        if (act != (QActive *)0) {
+            wsStep(w, act);
+        }
+        else {
+            wsPark(w);
+        }
+    }
+    return (void *)0; /* return success */
+}
+/*..........................................................................*/
+/* schedule the AO, whose event queue just became not empty.
+* NOTE: called inside the critical section of the AO's event queue
+*/
+void QF_wsSchedule_(QActive * const act) {
+    /* the AO must be registered (e.g., it must not be stopped) */
+    Q_ASSERT_ID(410, QActive_registry_[act->prio] != (QActive *)0);
+
+    if (act->osObject.state == (uint8_t)QF_WS_IDLE) {
+        act->osObject.state = (uint8_t)QF_WS_SCHEDULED;
+
+        QF_Worker * const w = l_self;
+        if (w != (QF_Worker *)0) { /* posted by a worker? */
+            wsPush(w, act);
+        }
+        else { /* posted by another thread (e.g., ticker) */
+            pthread_mutex_lock(&l_wsMutex);
+            l_inject[l_injectTail & (QF_WS_RING - 1U)] = act;
+            ++l_injectTail;
+            __atomic_add_fetch(&l_injectCount, 1U, __ATOMIC_RELEASE);
+            pthread_mutex_unlock(&l_wsMutex);
+        }
+        wsWake();
+    }
+    /* otherwise the AO is already scheduled or stopped */
+}
+
+/****************************************************************************/
+int_t QF_run(void) {
+    struct sched_param sparam;
+
+    QF_onStartup();  /* invoke startup callback */
+
+    /* produce the QS_QF_RUN trace record */
+    QS_BEGIN_NOCRIT_PRE_(QS_QF_RUN, 0U)
+    QS_END_NOCRIT_PRE_()
+
+    if (l_nWorkers == 0U) { /* the number of workers not set? */
+        long const nCpus = sysconf(_SC_NPROCESSORS_ONLN);
+        l_nWorkers = (nCpus < 1L)
+            ? 1U
+            : (((unsigned long)nCpus < QF_WS_MAX_WORKERS)
+               ? (uint_fast16_t)nCpus
+               : (uint_fast16_t)QF_WS_MAX_WORKERS);
+    }
+
+    l_isRunning = true;
+
+    /* start the worker threads with the default scheduling policy */
+    for (uint_fast16_t i = 0U; i < l_nWorkers; ++i) {
+        l_worker[i].seed = (uint32_t)(i + 1U) * 2654435769U;
+        int const err = pthread_create(&l_worker[i].thread, NULL,
+                                       &worker_thread, &l_worker[i]);
+        Q_ASSERT_ID(320, err == 0); /* worker thread must be created */
+    }
+
+    /* try to set the priority of the ticker thread, see NOTE04 */
+    sparam.sched_priority = l_tickPrio;
+    if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &sparam) == 0) {
+        /* success, this application has sufficient privileges */
+    }
+    else {
+        /* setting priority failed, probably due to insufficient privieges */
+    }
+
+    /* the absolute deadline of the next clock tick */
+    struct timespec next;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+
+    while (l_isRunning) { /* the clock tick loop... */
+        QF_onClockTick(); /* callback (must call QTIMEEVT_TICK_X()) */
+
+        tickerSleep(&next); /* sleep until the next tick deadline */
+    }
+
+    /* wake up all parked workers and wait until they finish */
+    pthread_mutex_lock(&l_wsMutex);
+    pthread_cond_broadcast(&l_wsCond);
+    pthread_mutex_unlock(&l_wsMutex);
+    for (uint_fast16_t i = 0U; i < l_nWorkers; ++i) {
+        pthread_join(l_worker[i].thread, NULL);
+    }
+
+    QF_onCleanup();  /* cleanup callback */
+    QS_EXIT();       /* cleanup the QSPY connection */
+
+    pthread_cond_destroy(&l_wsCond);
+    pthread_mutex_destroy(&l_wsMutex);
+    pthread_mutex_destroy(&QF_pThreadMutex_); /* cleanup the global mutex */
+
+    return 0; /* return success */
+}
+/*..........................................................................*/
+void QF_setTickRate(uint32_t ticksPerSec, int_t tickPrio) {
+    Q_REQUIRE_ID(300, ticksPerSec != 0U);
+    l_tick.tv_nsec = NANOSLEEP_NSEC_PER_SEC / ticksPerSec;
+    l_tickPrio = tickPrio;
+}
+/*..........................................................................*/
+void QF_setWorkers(uint_fast16_t const nWorkers) {
+    /* must be called before QF_run() with a valid number of workers */
+    Q_REQUIRE_ID(330, (!l_isRunning) && (nWorkers <= QF_WS_MAX_WORKERS));
+    l_nWorkers = nWorkers;
+}
+/*..........................................................................*/
+void QF_getWorkerStats(uint_fast16_t const worker,
+                       QF_WorkerStats * const stats)
+{
+    Q_REQUIRE_ID(340, worker < l_nWorkers);
+    QF_Worker const * const w = &l_worker[worker];
+    stats->nSteps  = __atomic_load_n(&w->stats.nSteps,  __ATOMIC_RELAXED);
+    stats->nSteals = __atomic_load_n(&w->stats.nSteals, __ATOMIC_RELAXED);
+    stats->nParks  = __atomic_load_n(&w->stats.nParks,  __ATOMIC_RELAXED);
+}
+/*..........................................................................*/
+void QF_stop(void) {
+    l_isRunning = false; /* stop the loop in QF_run() and in the workers */
+}
+
+/*..........................................................................*/
+void QF_consoleSetup(void) {
+    struct termios tio;   /* modified terminal attributes */
+
+    tcgetattr(0, &l_tsav); /* save the current terminal attributes */
+    tcgetattr(0, &tio);    /* obtain the current terminal attributes */
+    tio.c_lflag &= ~(ICANON | ECHO); /* disable the canonical mode & echo */
+    tcsetattr(0, TCSANOW, &tio);     /* set the new attributes */
+}
+/*..........................................................................*/
+void QF_consoleCleanup(void) {
+    tcsetattr(0, TCSANOW, &l_tsav); /* restore the saved attributes */
+}
+/*..........................................................................*/
+int QF_consoleGetKey(void) {
+    int byteswaiting;
+    ioctl(0, FIONREAD, &byteswaiting);
+    if (byteswaiting > 0) {
+        char ch;
+        read(0, &ch, 1);
+        return (int)ch;
+    }
+    return 0; /* no input at this time */
+}
+/*..........................................................................*/
+int QF_consoleWaitForKey(void) {
+    return getchar();
+}
+
+/****************************************************************************/
+void QActive_start_(QActive * const me, QPrioSpec const prioSpec,
+                  QEvt const * * const qSto, uint_fast16_t const qLen,
+                  void * const stkSto, uint_fast16_t const stkSize,
+                  void const * const par)
+{
+    (void)stkSize; /* unused parameter in the POSIX-WS port */
+
+    /* no external stack storage needed for this port */
+    Q_REQUIRE_ID(600, (stkSto == (void *)0));
+    QEQueue_init(&me->eQueue, qSto, qLen);
+    pthread_mutex_init(&me->osObject.mutex, NULL);
+    me->osObject.state = (uint8_t)QF_WS_IDLE;
+
+    me->prio  = QF_PRIO_SPEC_PRIO_(prioSpec);  /* QF-priority of the AO */
+    me->pthre = QF_PRIO_SPEC_PTHRE_(prioSpec); /* preemption-threshold */
+    QActive_register_(me); /* register this AO */
+
+    /* the top-most initial tran. (virtual) */
+    QHSM_INIT(&me->super, par, me->prio);
+    QS_FLUSH(); /* flush the trace buffer to the host */
+}
+/*..........................................................................*/
+#ifdef QF_ACTIVE_STOP
+void QActive_stop(QActive * const me) {
+    QActive_unsubscribeAll(me); /* unsubscribe from all events */
+
+    /* the worker unregisters the AO after this RTC step, see NOTE2 */
+    QF_ACTQ_CRIT_E_(me);
+    me->osObject.state = (uint8_t)QF_WS_STOPPED;
+    QF_ACTQ_CRIT_X_(me);
+}
+#endif
+/*..........................................................................*/
+void QActive_setAttr(QActive *const me, uint32_t attr1, void const *attr2) {
+    (void)me;    /* unused parameter */
+    (void)attr1; /* unused parameter */
+    (void)attr2; /* unused parameter */
+    Q_ERROR_ID(900); /* this function should not be called in this QP port */
+}
+
+/****************************************************************************/
+/* time difference (a - b) [ns] */
+static int64_t timespecDiff(struct timespec const * const a,
+                            struct timespec const * const b)
+{
+    return ((int64_t)(a->tv_sec - b->tv_sec) * NANOSLEEP_NSEC_PER_SEC)
+           + (int64_t)(a->tv_nsec - b->tv_nsec);
+}
+/*..........................................................................*/
+static void timespecAdd(struct timespec * const t, int64_t const nsec) {
+    int64_t const ns = (int64_t)t->tv_nsec + nsec;
+    t->tv_sec  += (time_t)(ns / NANOSLEEP_NSEC_PER_SEC);
+    t->tv_nsec  = (long)(ns % NANOSLEEP_NSEC_PER_SEC);
+}
+/*..........................................................................*/
+/* sleep until the absolute deadline of the next tick */
+static void tickerSleep(struct timespec * const next) {
+    int64_t const period = (int64_t)l_tick.tv_nsec;
+    struct timespec now;
+
+    timespecAdd(next, period);
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    int64_t const late = timespecDiff(&now, next);
+    if (late >= 0) { /* the deadline already passed? */
+        /* skip all missed ticks, but keep the phase of the deadlines */
+        timespecAdd(next, ((late / period) + 1) * period);
+    }
+
+#ifdef TIMER_ABSTIME
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, next, NULL)
+           == EINTR)
+    {
+        /* interrupted by a signal, sleep again */
+    }
+#else /* no clock_nanosleep(), sleep for the time left to the deadline */
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    int64_t const left = timespecDiff(next, &now);
+    if (left > 0) {
+        struct timespec rel = { 0, 0 };
+        timespecAdd(&rel, left);
+        nanosleep(&rel, NULL);
+    }
+#endif
+}
+
+/*..........................................................................*/
+static void sigIntHandler(int dummy) {
+    (void)dummy; /* unused parameter */
+    QF_onCleanup();
+    exit(-1);
+}
+
+/*==========================================================================*/
+/* NOTE01:
+* Every worker owns a bounded run queue of the scheduled AOs. Only the
+* owner appends the AOs at the tail, but any thread (the owner or a thief)
+* takes the AOs from the head by atomically advancing the head with
+* compare-and-swap, similarly to the local run queues of goroutines in the
+* Go scheduler. The owner thus serves its run queue in FIFO order, which
+* keeps the workers fair to all scheduled AOs, while the idle workers steal
+* the oldest AOs. Because every AO is in at most one run queue at a time,
+* the length of each run queue (QF_WS_RING) needs only to cover all
+* QF_MAX_ACTIVE AOs and the run queues never overflow.
+*
+* The handover of an AO between the workers (or between the run queue and
+* a thief) is ordered by the release store of the tail and the acquire
+* load (compare-and-swap) of the head, so the next RTC step of the AO on
+* any worker observes all the changes made by the previous RTC step.
+*
+* NOTE02:
+* The AOs scheduled outside of the workers (e.g., by the time events of
+* the ticker thread or by the initial transitions before QF_run()) go to
+* the shared injection queue protected by the l_wsMutex. The workers with
+* no work block on the l_wsCond condition variable ("park"). A parking
+* worker first increments the number of parked workers and then checks
+* again for the work, whereas the thread making the work available checks
+* the number of parked workers only after publishing the work. Both sides
+* use sequentially-consistent operations, so either the parking worker
+* sees the new work or the other thread sees the parked worker and signals
+* l_wsCond under the l_wsMutex, which cannot be lost.
+*
+* NOTE03:
+* In some (older) Linux kernels, the POSIX nanosleep() system call might
+* deliver only 2*actual-system-tick granularity. To compensate for this,
+* you would need to reduce the constant NANOSLEEP_NSEC_PER_SEC by factor 2.
+*
+* NOTE04:
+* The ticker thread (the thread calling QF_run()) tries to run with the
+* SCHED_FIFO policy at the priority set by QF_setTickRate(), which requires
+* the superuser privileges. The worker threads run with the default
+* scheduling policy, because they execute the AOs of all priorities.
+*/
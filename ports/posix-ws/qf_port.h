@@ -0,0 +1,221 @@
+/*============================================================================
+* QP/C Real-Time Embedded Framework (RTEF)
+* Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+*
+* SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+*
+* This software is dual-licensed under the terms of the open source GNU
+* General Public License version 3 (or any later version), or alternatively,
+* under the terms of one of the closed source Quantum Leaps commercial
+* licenses.
+*
+* The terms of the open source GNU General Public License version 3
+* can be found at: <www.gnu.org/licenses/gpl-3.0>
+*
+* The terms of the closed source Quantum Leaps commercial licenses
+* can be found at: <www.state-machine.com/licensing>
+*
+* Redistributions in source code must retain this top-level comment block.
+* Plagiarizing this software to sidestep the license obligations is illegal.
+*
+* Contact information:
+* <www.state-machine.com>
+* <info@state-machine.com>
+============================================================================*/
+/*!
+* @date Last updated on: 2022-10-18
+* @version Last updated for: @ref qpc_7_1_1
+*
+* @file
+* @brief QF/C port to POSIX API (M:N work-stealing executor)
+*/
+#ifndef QF_PORT_H
+#define QF_PORT_H
+
+/* POSIX-WS event queue and thread types */
+#define QF_EQUEUE_TYPE       QEQueue
+#define QF_OS_OBJECT_TYPE    QF_ActiveOSObject /* see NOTE2 */
+/* QF_THREAD_TYPE    not used in this port */
+
+/* The maximum number of active objects in the application, see NOTE3 */
+#ifndef QF_MAX_ACTIVE
+#define QF_MAX_ACTIVE        1024U
+#endif
+
+/* The maximum number of the worker threads of the executor, see NOTE2 */
+#ifndef QF_WS_MAX_WORKERS
+#define QF_WS_MAX_WORKERS    64U
+#endif
+
+/* The number of system clock tick rates */
+#define QF_MAX_TICK_RATE     2U
+
+/* Activate the QF QActive_stop() API */
+#define QF_ACTIVE_STOP       1
+
+/* various QF object sizes configuration for this port */
+#define QF_EVENT_SIZ_SIZE    4U
+#define QF_EQUEUE_CTR_SIZE   4U
+#define QF_MPOOL_SIZ_SIZE    4U
+#define QF_MPOOL_CTR_SIZE    4U
+#define QF_TIMEEVT_CTR_SIZE  4U
+
+/* QF_LOG2 with the count-leading-zeros builtin of the compiler, see NOTE3 */
+#ifdef __GNUC__
+#define QF_LOG2(n_) ((uint_fast8_t)(((n_) != 0U) \
+    ? (32U - (uint_fast8_t)__builtin_clz((unsigned)(n_))) : 0U))
+#endif
+
+/* QF critical section entry/exit for POSIX-WS, see NOTE1 */
+/* QF_CRIT_STAT_TYPE not defined */
+#define QF_CRIT_ENTRY(dummy) QF_enterCriticalSection_()
+#define QF_CRIT_EXIT(dummy)  QF_leaveCriticalSection_()
+
+#include <pthread.h>   /* POSIX-thread API */
+
+/* the executor always uses the object-level critical sections, see NOTE1 */
+#define QF_OBJ_CRIT
+
+/* separate mutex in every memory pool */
+#define QF_MPOOL_CRIT_TYPE   pthread_mutex_t
+
+#include "qep_port.h"  /* QEP port */
+#include "qequeue.h"   /* POSIX-WS needs event-queue */
+#include "qmpool.h"    /* POSIX-WS needs memory-pool */
+
+/* QActive "OS-object" scheduled by the executor, see NOTE2 */
+typedef struct {
+    pthread_mutex_t mutex;  /* protects the AO's event queue and state */
+    uint8_t volatile state; /* QF_WS_IDLE, QF_WS_SCHEDULED or QF_WS_STOPPED */
+} QF_ActiveOSObject;
+
+#include "qf.h"        /* QF platform-independent public interface */
+
+void QF_enterCriticalSection_(void);
+void QF_leaveCriticalSection_(void);
+
+/* set clock tick rate and p-thread priority of the ticker thread */
+void QF_setTickRate(uint32_t ticksPerSec, int_t tickPrio);
+
+/* set the number of the worker threads (call before QF_run()),
+* where 0 means one worker per online CPU core, see NOTE2
+*/
+void QF_setWorkers(uint_fast16_t const nWorkers);
+
+/* statistics of a worker thread of the executor */
+typedef struct {
+    uint32_t nSteps;  /* run-to-completion steps executed */
+    uint32_t nSteals; /* AOs stolen from the run queues of other workers */
+    uint32_t nParks;  /* times the worker blocked for lack of work */
+} QF_WorkerStats;
+
+/* obtain the statistics of the given worker [0..number of workers - 1] */
+void QF_getWorkerStats(uint_fast16_t const worker,
+                       QF_WorkerStats * const stats);
+
+/* clock tick callback (NOTE not called when "ticker thread" is not running) */
+void QF_onClockTick(void); /* clock tick callback (provided in the app) */
+
+/* abstractions for console access... */
+void QF_consoleSetup(void);
+void QF_consoleCleanup(void);
+int QF_consoleGetKey(void);
+int QF_consoleWaitForKey(void);
+
+/****************************************************************************/
+/* interface used only inside QF implementation, but not in applications */
+#ifdef QP_IMPL
+
+    /* scheduler locking (not used in this port) */
+    #define QF_SCHED_STAT_
+    #define QF_SCHED_LOCK_(dummy) ((void)0)
+    #define QF_SCHED_UNLOCK_()    ((void)0)
+
+    /* critical section of the AO's event queue */
+    #define QF_ACTQ_CRIT_ENTRY(me_) \
+        pthread_mutex_lock(&(me_)->osObject.mutex)
+    #define QF_ACTQ_CRIT_EXIT(me_) \
+        pthread_mutex_unlock(&(me_)->osObject.mutex)
+
+    /* critical section of the memory pool */
+    #define QF_MPOOL_CRIT_INIT(me_)  pthread_mutex_init(&(me_)->crit, NULL)
+    #define QF_MPOOL_CRIT_ENTRY(me_) pthread_mutex_lock(&(me_)->crit)
+    #define QF_MPOOL_CRIT_EXIT(me_)  pthread_mutex_unlock(&(me_)->crit)
+
+    /* critical section of the time events at a given tick rate */
+    #define QF_TIMEEVT_CRIT_ENTRY(rate_) \
+        pthread_mutex_lock(&QF_timeEvtMutex_[(rate_)])
+    #define QF_TIMEEVT_CRIT_EXIT(rate_) \
+        pthread_mutex_unlock(&QF_timeEvtMutex_[(rate_)])
+
+    /* POSIX-WS active object event queue customization, see NOTE2 */
+    #define QACTIVE_EQUEUE_WAIT_(me_) \
+        Q_ASSERT((me_)->eQueue.frontEvt != (QEvt *)0)
+    #define QACTIVE_EQUEUE_SIGNAL_(me_) QF_wsSchedule_((me_))
+
+    /* schedule the AO, whose event queue just became not empty */
+    void QF_wsSchedule_(QActive * const act);
+
+    /* native QF event pool operations */
+    #define QF_EPOOL_TYPE_            QMPool
+    #define QF_EPOOL_INIT_(p_, poolSto_, poolSize_, evtSize_) \
+        (QMPool_init(&(p_), (poolSto_), (poolSize_), (evtSize_)))
+    #define QF_EPOOL_EVENT_SIZE_(p_)  ((uint_fast16_t)(p_).blockSize)
+    #define QF_EPOOL_GET_(p_, e_, m_, qs_id_) \
+        ((e_) = (QEvt *)QMPool_get(&(p_), (m_), (qs_id_)))
+    #define QF_EPOOL_PUT_(p_, e_, qs_id_) \
+        (QMPool_put(&(p_), (e_), (qs_id_)))
+
+    /* mutexes for the time events at each tick rate */
+    extern pthread_mutex_t QF_timeEvtMutex_[QF_MAX_TICK_RATE];
+
+#endif /* QP_IMPL */
+
+/*==========================================================================*/
+/*
+* NOTE1:
+* The active objects in this port run concurrently on several worker
+* threads, so this port always uses the object-level critical sections
+* (QF_OBJ_CRIT), like the multithreaded POSIX port with -DQF_OBJ_CRIT.
+* Every AO event queue, every event pool and every list of time events
+* (one per tick rate) has its own mutex. The QF critical section with the
+* single QF_pThreadMutex_ protects only the rest of the framework, such as
+* the registration of AOs and the subscriber lists. The object-level
+* critical sections imply the atomic event reference counters
+* (QF_EVT_REF_ATOMIC, see qf_pkg.h).
+*
+* NOTE2:
+* Unlike the POSIX port, which creates a p-thread for every active object,
+* this port runs the AOs as lightweight schedulable entities on a fixed
+* pool of worker threads (M:N scheduling). The number of the workers is
+* set by QF_setWorkers() before QF_run() and defaults to the number of
+* online CPU cores, but it cannot exceed QF_WS_MAX_WORKERS.
+*
+* An AO becomes "scheduled" when its event queue turns from empty to not
+* empty (QACTIVE_EQUEUE_SIGNAL_()). A scheduled AO is placed into the run
+* queue of the worker that posted the event, or into the shared injection
+* queue when the event was posted from any other thread (e.g., the ticker
+* thread). A worker executes ONE run-to-completion step of the AO at a
+* time and then places the AO back at the end of its own run queue, if
+* more events are waiting. The workers, whose run queues are empty, steal
+* the AOs from the run queues of the other workers before they block.
+*
+* The "state" in the ::QF_ActiveOSObject guarantees that an AO is in at
+* most one run queue or is executed by at most one worker at any given
+* time, so the RTC semantics of every AO are preserved. However, the AO
+* priorities determine neither the order nor the preemption of the RTC
+* steps of different AOs. The priorities only identify the AOs in QF (e.g.,
+* in the subscriber lists) and must still be unique.
+*
+* QActive_stop() must be called by the AO itself (from its own state
+* machine). The AO is unregistered after its current RTC step completes.
+*
+* NOTE3:
+* The number of AOs is not limited by the number of threads, but it is
+* still limited by QF_MAX_ACTIVE (up to 1024U, see ::QPSet), which this
+* port sets to 1024U by default. QS software tracing is not available with
+* more than 64 active objects, so a Spy build must define a smaller
+* QF_MAX_ACTIVE (e.g., -DQF_MAX_ACTIVE=64U).
+*/
+
+#endif /* QF_PORT_H */
@@ -33,6 +33,10 @@
 
 /* expose features from the 2008 POSIX standard (IEEE Standard 1003.1-2008) */
 #define _POSIX_C_SOURCE 200809L
+#ifdef __linux__
+    /* for CPU affinity, thread names and syscall(), see NOTE5 in qf_port.h */
+    #define _GNU_SOURCE
+#endif
 
 #define QP_IMPL           /* this is QP implementation */
 #include "qf_port.h"      /* QF port */
@@ -55,21 +59,81 @@
 #include <termios.h>
 #include <unistd.h>
 #include <signal.h>
+#include <sched.h>        /* for sched_yield() */
+#include <time.h>         /* for clock_gettime() and clock_nanosleep() */
+#include <errno.h>        /* for EINTR */
+#include <sys/resource.h> /* for setpriority() */
+#ifdef __linux__
+    #include <sys/syscall.h>  /* for SYS_gettid and SYS_futex */
+    #include <sys/timerfd.h>  /* for timerfd_create() and timerfd_settime() */
+#endif
+#ifdef QF_FUTEX_WAIT
+    #include <linux/futex.h>  /* for FUTEX_WAIT_PRIVATE/FUTEX_WAKE_PRIVATE */
+#endif
 
 Q_DEFINE_THIS_MODULE("qf_port")
 
 /* Global objects ==========================================================*/
 pthread_mutex_t QF_pThreadMutex_; /* mutex for QF critical section */
+#ifdef QF_OBJ_CRIT
+pthread_mutex_t QF_timeEvtMutex_[QF_MAX_TICK_RATE]; /* see NOTE06 */
+#endif
 
 /* Local objects ===========================================================*/
 static pthread_mutex_t l_startupMutex;
+#ifdef QF_ACTQ_BATCH
+__thread QActive *QF_batchAct_; /* AO of the calling thread, see NOTE8 */
+#endif
+#ifdef QF_EPOOL_MAG_SIZE
+static pthread_key_t l_magKey; /* flushes the magazines at the thread exit */
+#endif
 static bool l_isRunning;      /* flag indicating when QF is running */
 static struct termios l_tsav; /* structure with saved terminal attributes */
 static struct timespec l_tick;
 static int_t l_tickPrio;
+static QF_TickStats l_tickStats; /* see NOTE08 */
+static uint64_t l_tickLatSum;    /* sum of the tick latencies [ns] */
+#ifdef QF_TICKLESS
+/* the "tickless" ticker, see NOTE09 */
+static pthread_mutex_t l_tickerMutex    = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  l_tickerSyncCond = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t  l_tickerWakeCond; /* on CLOCK_MONOTONIC */
+static pthread_t       l_tickerThread;
+static struct timespec l_tickerNext; /* deadline of the next clock tick */
+static uint32_t l_tickerPlan;  /* clock ticks of the planned sleep */
+static bool l_tickerLong;      /* sleeping (or behind) over more ticks */
+static bool l_tickerSleeping;  /* waiting for l_tickerWakeCond */
+static bool l_tickerWake;      /* wake-up of the ticker requested */
+#endif
+#if (QF_MAX_HRTIMER > 0U)
+/* the thread servicing the high-resolution time events, see NOTE10 */
+static pthread_t l_hrTimerThread;
+#ifdef __linux__
+static int l_hrTimerFd = -1;  /* timerfd armed for the earliest deadline */
+#else
+static pthread_cond_t l_hrTimerCond; /* on CLOCK_MONOTONIC */
+static uint64_t l_hrTimerDeadline;   /* the earliest deadline (0 for none) */
+#endif
+#endif
 enum { NANOSLEEP_NSEC_PER_SEC = 1000000000 }; /* see NOTE05 */
 
 static void sigIntHandler(int dummy);
+#ifndef QF_TICKLESS
+static void tickerSleep(struct timespec * const next);
+#else
+static void tickerLoop(int64_t const delay);
+#endif
+#if (QF_MAX_HRTIMER > 0U)
+static void hrTimerStart(void);
+#endif
+#ifdef QF_EPOOL_MAG_SIZE
+static void magFlush(void * const mags);
+#endif
+#ifdef QF_MPSC_EQUEUE
+static void QMPSCQueue_init(QMPSCQueue * const me,
+                            QEvt const * * const qSto,
+                            uint_fast16_t const qLen);
+#endif
 
 /* QF functions ============================================================*/
 void QF_init(void) {
@@ -81,6 +145,15 @@ void QF_init(void) {
     /* init the global mutex with the default non-recursive initializer */
     pthread_mutex_init(&QF_pThreadMutex_, NULL);
 
+#ifdef QF_OBJ_CRIT
+    /* init the time event mutexes for all tick rates */
+    for (uint_fast8_t tickRate = 0U; tickRate < QF_MAX_TICK_RATE;
+         ++tickRate)
+    {
+        pthread_mutex_init(&QF_timeEvtMutex_[tickRate], NULL);
+    }
+#endif
+
     /* init the startup mutex with the default non-recursive initializer */
     pthread_mutex_init(&l_startupMutex, NULL);
 
@@ -89,8 +162,35 @@ void QF_init(void) {
     */
     pthread_mutex_lock(&l_startupMutex);
 
+#ifdef QF_EPOOL_MAG_SIZE
+    /* the magazines of a thread are flushed when the thread exits */
+    pthread_key_create(&l_magKey, &magFlush);
+#endif
+
     l_tick.tv_sec = 0;
     l_tick.tv_nsec = NANOSLEEP_NSEC_PER_SEC/100L; /* default clock tick */
+
+#ifdef QF_TICKLESS
+    /* the ticker sleeps until absolute deadlines on CLOCK_MONOTONIC */
+    pthread_condattr_t condAttr;
+    pthread_condattr_init(&condAttr);
+    pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+    pthread_cond_init(&l_tickerWakeCond, &condAttr);
+    pthread_condattr_destroy(&condAttr);
+#endif
+#if (QF_MAX_HRTIMER > 0U)
+#ifdef __linux__
+    /* the high-resolution time events expire on a timerfd */
+    l_hrTimerFd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    Q_ASSERT_ID(310, l_hrTimerFd >= 0);
+#else
+    pthread_condattr_t hrCondAttr;
+    pthread_condattr_init(&hrCondAttr);
+    pthread_condattr_setclock(&hrCondAttr, CLOCK_MONOTONIC);
+    pthread_cond_init(&l_hrTimerCond, &hrCondAttr);
+    pthread_condattr_destroy(&hrCondAttr);
+#endif
+#endif
     l_tickPrio = sched_get_priority_min(SCHED_FIFO); /* default tick prio */
 
     /* install the SIGINT (Ctrl-C) signal handler */
@@ -133,11 +233,25 @@ int_t QF_run(void) {
     pthread_mutex_unlock(&l_startupMutex);
 
     l_isRunning = true;
+#if (QF_MAX_HRTIMER > 0U)
+    hrTimerStart(); /* service the high-resolution time events */
+#endif
+#ifndef QF_TICKLESS
+    /* the absolute deadline of the next clock tick, see NOTE08 */
+    struct timespec next;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+
     while (l_isRunning) { /* the clock tick loop... */
         QF_onClockTick(); /* callback (must call QTIMEEVT_TICK_X()) */
 
-        nanosleep(&l_tick, NULL); /* sleep for the number of ticks, NOTE05 */
+        tickerSleep(&next); /* sleep until the next tick deadline */
     }
+#else
+    tickerLoop(0); /* the first clock tick right away, see NOTE09 */
+#endif
+#ifdef QF_EPOOL_MAG_SIZE
+    QF_magFlush(); /* return the cached events of this thread to the pools */
+#endif
     QF_onCleanup(); /* invoke cleanup callback */
     pthread_mutex_destroy(&l_startupMutex);
     pthread_mutex_destroy(&QF_pThreadMutex_);
@@ -151,8 +265,34 @@ void QF_setTickRate(uint32_t ticksPerSec, int_t tickPrio) {
     l_tickPrio = tickPrio;
 }
 /*..........................................................................*/
+void QF_getTickStats(QF_TickStats * const stats) {
+    QF_CRIT_STAT_
+    QF_CRIT_E_();
+    *stats = l_tickStats;
+    stats->avgLat = (l_tickStats.nTicks != 0U)
+                    ? (uint32_t)(l_tickLatSum / l_tickStats.nTicks)
+                    : 0U;
+    QF_CRIT_X_();
+}
+/*..........................................................................*/
 void QF_stop(void) {
     l_isRunning = false; /* stop the loop in QF_run() */
+#ifdef QF_EPOOL_MAG_SIZE
+    QF_magFlush(); /* return the cached events of this thread to the pools */
+#endif
+#ifdef QF_TICKLESS
+    /* wake up the ticker sleeping until the next time event expiration */
+    pthread_mutex_lock(&l_tickerMutex);
+    l_tickerWake = true;
+    pthread_cond_signal(&l_tickerWakeCond);
+    pthread_mutex_unlock(&l_tickerMutex);
+#endif
+#if (QF_MAX_HRTIMER > 0U)
+    /* wake up the high-resolution time event thread */
+    pthread_mutex_lock(&QF_pThreadMutex_);
+    QF_hrTimerSet_(1U); /* the deadline long past */
+    pthread_mutex_unlock(&QF_pThreadMutex_);
+#endif
 }
 
 /*..........................................................................*/
@@ -188,22 +328,79 @@ int QF_consoleWaitForKey(void) {
 static void *thread_routine(void *arg) { /* the expected POSIX signature */
     QActive *act = (QActive *)arg;
 
+    /* thread name set by QActive_setAttr(), see NOTE5 in qf_port.h */
+    if (act->thread.name != (char const *)0) {
+#if (defined __linux__)
+        pthread_setname_np(pthread_self(), act->thread.name);
+#elif (defined __APPLE__)
+        pthread_setname_np(act->thread.name);
+#endif
+    }
+
+    /* nice level of a non-real-time thread, see NOTE5 in qf_port.h */
+    if ((act->thread.sched != (QF_SchedAttr *)0)
+        && (act->thread.sched->policy != SCHED_FIFO)
+        && (act->thread.sched->policy != SCHED_RR))
+    {
+#ifdef __linux__
+        /* in Linux, the nice level is an attribute of every thread */
+        (void)setpriority(PRIO_PROCESS, (id_t)syscall(SYS_gettid),
+                          act->thread.sched->prio);
+#else
+        (void)setpriority(PRIO_PROCESS, 0, act->thread.sched->prio);
+#endif
+    }
+
+#ifdef QF_ACTQ_BATCH
+    QF_batchAct_ = act; /* LIFO self-posting in a batch, see NOTE8 */
+    act->thread.nLifo = 0U;
+#endif
+
     /* block this thread until the startup mutex is unlocked from QF_run() */
     pthread_mutex_lock(&l_startupMutex);
     pthread_mutex_unlock(&l_startupMutex);
 
 #ifdef QF_ACTIVE_STOP
-    act->thread = true;
-    while (act->thread)
+    act->thread.isRunning = true;
+    while (act->thread.isRunning)
 #else
     for (;;) /* for-ever */
 #endif
     {
+#ifndef QF_ACTQ_BATCH
         QEvt const *e = QActive_get_(act); /* wait for the event */
         QHSM_DISPATCH(&act->super, e, act->prio); /* dispatch to the HSM */
         QF_gc(e); /* check if the event is garbage, and collect it if so */
+#else /* batched dequeue, see NOTE8 in qf_port.h */
+        QEvt const *batch[QF_ACTQ_BATCH];
+        uint_fast16_t const n = QActive_getBatch_(act, &batch[0],
+                                                  QF_ACTQ_BATCH);
+        for (uint_fast16_t i = 0U; i < n; ++i) {
+            QEvt const *e = batch[i];
+            for (;;) {
+#ifdef QF_ACTIVE_STOP
+                if (act->thread.isRunning) /* not stopped in this batch? */
+#endif
+                {
+                    QHSM_DISPATCH(&act->super, e, act->prio);
+                }
+                QF_gc(e); /* check if the event is garbage... */
+
+                /* no events posted LIFO to itself in the dispatch? */
+                if (act->thread.nLifo == 0U) {
+                    break;
+                }
+                /* the LIFO events go before the rest of the batch */
+                --act->thread.nLifo;
+                e = QActive_get_(act); /* at the front of the queue */
+            }
+        }
+#endif /* QF_ACTQ_BATCH */
     }
 #ifdef QF_ACTIVE_STOP
+#ifdef QF_EPOOL_MAG_SIZE
+    QF_magFlush(); /* return the cached events of this thread to the pools */
+#endif
     QActive_unregister_(act); /* un-register this active object */
 #endif
     return (void *)0; /* return success */
@@ -223,11 +420,20 @@ void QActive_start_(QActive * const me, QPrioSpec const prioSpec,
     /* p-threads allocate stack internally */
     Q_REQUIRE_ID(600, stkSto == (void *)0);
 
+#ifdef QF_MPSC_EQUEUE
+    QMPSCQueue_init(&me->eQueue, qSto, qLen);
+#else
     QEQueue_init(&me->eQueue, qSto, qLen);
+#endif
+#ifdef QF_OBJ_CRIT
+    pthread_cond_init(&me->osObject.cond, NULL);
+    pthread_mutex_init(&me->osObject.mutex, NULL); /* see NOTE06 */
+#else
     pthread_cond_init(&me->osObject, NULL);
+#endif
 
-    me->prio  = (uint8_t)(prioSpec & 0xFFU); /* QF-priority of the AO */
-    me->pthre = (uint8_t)(prioSpec >> 8U);   /* preemption-threshold */
+    me->prio  = QF_PRIO_SPEC_PRIO_(prioSpec);  /* QF-priority of the AO */
+    me->pthre = QF_PRIO_SPEC_PTHRE_(prioSpec); /* preemption-threshold */
     QActive_register_(me); /* register this AO */
 
     /* the top-most initial tran. (virtual) */
@@ -239,19 +445,47 @@ void QActive_start_(QActive * const me, QPrioSpec const prioSpec,
     /* SCHED_FIFO corresponds to real-time preemptive priority-based scheduler
     * NOTE: This scheduling policy requires the superuser privileges
     */
-    pthread_attr_setschedpolicy (&attr, SCHED_FIFO);
-    pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
-    pthread_attr_setdetachstate (&attr, PTHREAD_CREATE_DETACHED);
+    int policy = SCHED_FIFO;
 
     /* priority of the p-thread, see NOTE04 */
+#if (QF_MAX_ACTIVE <= 64U)
     param.sched_priority = me->prio
                            + (sched_get_priority_max(SCHED_FIFO)
                               - QF_MAX_ACTIVE - 3U);
+#else /* more AOs than SCHED_FIFO priorities, see NOTE12 */
+    param.sched_priority = sched_get_priority_min(SCHED_FIFO)
+        + (int)(((uint_fast32_t)me->prio
+                 * (uint_fast32_t)(sched_get_priority_max(SCHED_FIFO)
+                                   - sched_get_priority_min(SCHED_FIFO) - 3))
+                / QF_MAX_ACTIVE);
+#endif
+
+    /* scheduling set by QActive_setAttr(), see NOTE5 in qf_port.h */
+    if (me->thread.sched != (QF_SchedAttr *)0) {
+        policy = me->thread.sched->policy;
+        param.sched_priority = ((policy == SCHED_FIFO) || (policy == SCHED_RR))
+                               ? me->thread.sched->prio
+                               : 0; /* nice level set in thread_routine() */
+    }
+
+    pthread_attr_setschedpolicy (&attr, policy);
+    pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+    pthread_attr_setdetachstate (&attr, PTHREAD_CREATE_DETACHED);
     pthread_attr_setschedparam(&attr, &param);
 
-    pthread_attr_setstacksize(&attr, (stkSize < PTHREAD_STACK_MIN
-                                      ? PTHREAD_STACK_MIN
-                                      : stkSize));
+    /* CPU affinity set by QActive_setAttr(), see NOTE5 in qf_port.h */
+    if (me->thread.cpuSet != (void *)0) {
+#ifdef __linux__
+        pthread_attr_setaffinity_np(&attr, sizeof(cpu_set_t),
+                                    (cpu_set_t const *)me->thread.cpuSet);
+#endif
+    }
+
+    /* NOTE: PTHREAD_STACK_MIN might be a signed run-time value */
+    size_t const stkMin = (size_t)PTHREAD_STACK_MIN;
+    pthread_attr_setstacksize(&attr, ((size_t)stkSize < stkMin
+                                      ? stkMin
+                                      : (size_t)stkSize));
 
     err = pthread_create(&thread, &attr, &thread_routine, me);
     if (err != 0) {
@@ -275,16 +509,825 @@ void QActive_start_(QActive * const me, QPrioSpec const prioSpec,
 #ifdef QF_ACTIVE_STOP
 void QActive_stop(QActive * const me) {
     QActive_unsubscribeAll(me); /* unsubscribe this AO from all events */
-    me->thread = false; /* stop the thread loop (see thread_routine()) */
+    me->thread.isRunning = false; /* stop the thread loop */
 }
 #endif
 /*..........................................................................*/
 void QActive_setAttr(QActive *const me, uint32_t attr1, void const *attr2) {
-    (void)me;    /* unused parameter */
-    (void)attr1; /* unused parameter */
-    (void)attr2; /* unused parameter */
-    Q_ERROR_ID(900); /* this function should not be called in this QP port */
+    /* this function must be called before QACTIVE_START(), see NOTE5 */
+    Q_REQUIRE_ID(900, me->prio == 0U);
+    switch (attr1) {
+        case THREAD_NAME_ATTR:
+            me->thread.name = (char const *)attr2;
+            break;
+        case THREAD_AFFINITY_ATTR:
+#ifdef __linux__
+            me->thread.cpuSet = attr2;
+#else
+            Q_ERROR_ID(910); /* CPU affinity not supported on this OS */
+#endif
+            break;
+        case THREAD_SCHED_ATTR:
+            me->thread.sched = (QF_SchedAttr const *)attr2;
+            break;
+        default:
+            Q_ERROR_ID(920); /* unknown thread attribute */
+            break;
+    }
+}
+
+#ifdef QF_EPOOL_MAG_SIZE
+/****************************************************************************/
+/* Per-thread caches of free events, see NOTE6 in qf_port.h */
+enum { MAG_BATCH = QF_EPOOL_MAG_SIZE / 2U }; /* blocks moved at a time */
+
+typedef struct {
+    void *blk[QF_EPOOL_MAG_SIZE]; /* stack of the cached free blocks */
+    uint_fast16_t n;              /* number of the cached free blocks */
+} QF_Magazine;
+
+/* magazines of the calling thread, one for every event pool */
+static __thread QF_Magazine l_mag[QF_MAX_EPOOL];
+
+/* the magazines of the calling thread are registered with l_magKey */
+static __thread bool l_magUsed;
+
+/*..........................................................................*/
+/* registers the magazines of the calling thread for the flush at exit */
+static void magUse(void) {
+    l_magUsed = true;
+    pthread_setspecific(l_magKey, &l_mag[0]);
+}
+
+/*..........................................................................*/
+void *QF_magGet_(QMPool * const pool, uint_fast16_t const margin,
+                 uint_fast8_t const qs_id)
+{
+    void *b;
+    if (margin != 0U) { /* allocation with a margin? */
+        b = QMPool_get(pool, margin, qs_id); /* check the margin exactly */
+    }
+    else {
+        QF_Magazine * const mag = &l_mag[pool - &QF_ePool_[0]];
+        if (mag->n == 0U) { /* magazine empty? */
+            mag->n = QMPool_getBatch_(pool, &mag->blk[0], MAG_BATCH, qs_id);
+            if (!l_magUsed) {
+                magUse();
+            }
+        }
+        if (mag->n != 0U) {
+            --mag->n;
+            b = mag->blk[mag->n];
+        }
+        else { /* the pool is empty */
+            b = (void *)0;
+        }
+    }
+    return b;
+}
+/*..........................................................................*/
+void QF_magPut_(QMPool * const pool, void * const b,
+                uint_fast8_t const qs_id)
+{
+    /*! @pre the block must be from this pool */
+    Q_REQUIRE_ID(700, QF_PTR_RANGE_(b, pool->start, pool->end));
+
+    if (!l_magUsed) {
+        magUse();
+    }
+    QF_Magazine * const mag = &l_mag[pool - &QF_ePool_[0]];
+    if (mag->n == QF_EPOOL_MAG_SIZE) { /* magazine full? */
+        mag->n -= MAG_BATCH;
+        QMPool_putBatch_(pool, &mag->blk[mag->n], MAG_BATCH, qs_id);
+    }
+    mag->blk[mag->n] = b;
+    ++mag->n;
+}
+/*..........................................................................*/
+void QF_magFlush(void) {
+    magFlush(&l_mag[0]);
+}
+/*..........................................................................*/
+/* returns all the events cached in the magazines @p mags to the pools
+* (also the destructor of l_magKey at the exit of the thread)
+*/
+static void magFlush(void * const mags) {
+    QF_Magazine * const mag = (QF_Magazine *)mags;
+    for (uint_fast8_t idx = 0U; idx < QF_maxPool_; ++idx) {
+        if (mag[idx].n != 0U) {
+#ifdef Q_SPY
+            QMPool_putBatch_(&QF_ePool_[idx], &mag[idx].blk[0], mag[idx].n,
+                             (uint_fast8_t)QS_EP_ID + idx + 1U);
+#else
+            QMPool_putBatch_(&QF_ePool_[idx], &mag[idx].blk[0], mag[idx].n,
+                             0U);
+#endif
+            mag[idx].n = 0U;
+        }
+    }
+}
+#endif /* QF_EPOOL_MAG_SIZE */
+
+#ifdef QF_MPSC_EQUEUE
+/****************************************************************************/
+/* Lock-free AO event queue, see NOTE3 in qf_port.h */
+
+/* pointer to the entry of the queue 'q_' at the position 'pos_' */
+#define QMPSC_ENTRY_(q_, pos_) \
+    (((pos_) < (q_)->end) ? &(q_)->ring[(pos_)] : &(q_)->last)
+
+#ifdef QF_FUTEX_WAIT
+
+/* the futex word is the nFree counter of the queue */
+Q_ASSERT_STATIC(sizeof(QEQueueCtr) == sizeof(uint32_t));
+
+/* the reservation must be ordered before the check of the 'waiting' flag,
+* which pairs with the store of the flag before the check of nFree by the
+* consumer (see QMPSCQueue_wait())
+*/
+#define QMPSC_RESERVE_ORDER_ __ATOMIC_SEQ_CST
+
+/* hint to the CPU that the thread is spinning */
+#if (defined __x86_64__) || (defined __i386__)
+    #define QF_CPU_RELAX_() __builtin_ia32_pause()
+#elif (defined __aarch64__)
+    #define QF_CPU_RELAX_() __asm__ volatile ("yield")
+#else
+    #define QF_CPU_RELAX_() ((void)0)
+#endif
+
+#else
+
+#define QMPSC_RESERVE_ORDER_ __ATOMIC_ACQUIRE
+
+#endif /* QF_FUTEX_WAIT */
+
+/*..........................................................................*/
+static void QMPSCQueue_init(QMPSCQueue * const me,
+                            QEvt const * * const qSto,
+                            uint_fast16_t const qLen)
+{
+    me->ring  = (QEvt const * volatile *)qSto;
+    me->last  = (QEvt *)0;
+    me->end   = (QEQueueCtr)qLen;
+    me->head  = 0U;
+    me->tail  = 0U;
+    me->nFree = (QEQueueCtr)(qLen + 1U); /* +1 for the last entry */
+    me->nMin  = me->nFree;
+    for (uint_fast16_t n = 0U; n < qLen; ++n) {
+        me->ring[n] = (QEvt *)0; /* empty entry */
+    }
+#ifdef QF_FUTEX_WAIT
+    /* spinning and yielding only waste the only CPU of a uniprocessor */
+    bool const isSmp = (sysconf(_SC_NPROCESSORS_ONLN) > 1L);
+    me->spins   = isSmp ? QF_FUTEX_SPINS  : 0U;
+    me->yields  = isSmp ? QF_FUTEX_YIELDS : 0U;
+    me->nSpin   = 0U;
+    me->nYield  = 0U;
+    me->nBlock  = 0U;
+    me->waiting = 0U;
+#endif
+}
+/*..........................................................................*/
+/* reserve one free entry (lock-free), keeping the requested margin */
+static bool QMPSCQueue_reserve(QMPSCQueue * const me,
+                               uint_fast16_t const margin,
+                               QEQueueCtr * const nFree)
+{
+    QEQueueCtr n = __atomic_load_n(&me->nFree, __ATOMIC_RELAXED);
+    bool status;
+    do {
+        status = (margin == QF_NO_MARGIN)
+                 ? (n > 0U)
+                 : (n > (QEQueueCtr)margin);
+    } while (status
+             && !__atomic_compare_exchange_n(&me->nFree, &n, n - 1U, false,
+                                 QMPSC_RESERVE_ORDER_, __ATOMIC_RELAXED));
+
+    if (status) {
+        --n; /* one free entry just used up */
+
+        /* update the minimum so far */
+        QEQueueCtr nMin = __atomic_load_n(&me->nMin, __ATOMIC_RELAXED);
+        while ((nMin > n)
+               && !__atomic_compare_exchange_n(&me->nMin, &nMin, n, false,
+                                 __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        {
+            /* nMin changed by another producer, try again */
+        }
+    }
+    *nFree = n;
+    return status;
+}
+/*..........................................................................*/
+/* claim the entry at the head and store the event in it (lock-free) */
+static void QMPSCQueue_put(QMPSCQueue * const me, QEvt const * const e) {
+    QEQueueCtr head = __atomic_load_n(&me->head, __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&me->head, &head,
+               ((head == me->end) ? 0U : (head + 1U)), false,
+               __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+        /* head claimed by another producer, try again */
+    }
+    __atomic_store_n(QMPSC_ENTRY_(me, head), e, __ATOMIC_RELEASE);
+}
+/*..........................................................................*/
+/* wake up the consumer only on the empty->not-empty edge of its queue */
+static void QActive_signal_(QActive * const me) {
+    Q_ASSERT_ID(410, QActive_registry_[me->prio] != (QActive *)0);
+
+#ifdef QF_FUTEX_WAIT
+    if (__atomic_load_n(&me->eQueue.waiting, __ATOMIC_SEQ_CST) != 0U) {
+        (void)syscall(SYS_futex, &me->eQueue.nFree, FUTEX_WAKE_PRIVATE,
+                      1, NULL, NULL, 0);
+    }
+#else
+    pthread_mutex_lock(&me->osObject.mutex);
+    pthread_cond_signal(&me->osObject.cond);
+    pthread_mutex_unlock(&me->osObject.mutex);
+#endif
+}
+#ifdef QF_FUTEX_WAIT
+/*..........................................................................*/
+/* wait until the queue is not empty: spin, yield, then block, see NOTE4 */
+static void QMPSCQueue_wait(QMPSCQueue * const me) {
+    QEQueueCtr const empty = (QEQueueCtr)(me->end + 1U);
+
+    for (uint32_t n = me->spins; n > 0U; --n) {
+        if (__atomic_load_n(&me->nFree, __ATOMIC_ACQUIRE) != empty) {
+            __atomic_store_n(&me->nSpin, me->nSpin + 1U, __ATOMIC_RELAXED);
+            return;
+        }
+        QF_CPU_RELAX_();
+    }
+    for (uint32_t n = me->yields; n > 0U; --n) {
+        sched_yield();
+        if (__atomic_load_n(&me->nFree, __ATOMIC_ACQUIRE) != empty) {
+            __atomic_store_n(&me->nYield, me->nYield + 1U, __ATOMIC_RELAXED);
+            return;
+        }
+    }
+
+    __atomic_store_n(&me->nBlock, me->nBlock + 1U, __ATOMIC_RELAXED);
+    __atomic_store_n(&me->waiting, 1U, __ATOMIC_SEQ_CST);
+    while (__atomic_load_n(&me->nFree, __ATOMIC_SEQ_CST) == empty) {
+        /* the kernel re-checks nFree, so no wake-up can be lost */
+        (void)syscall(SYS_futex, &me->nFree, FUTEX_WAIT_PRIVATE,
+                      empty, NULL, NULL, 0);
+    }
+    __atomic_store_n(&me->waiting, 0U, __ATOMIC_RELAXED);
+}
+#endif /* QF_FUTEX_WAIT */
+
+/*..........................................................................*/
+bool QActive_post_(QActive * const me, QEvt const * const e,
+                   uint_fast16_t const margin, void const * const sender)
+{
+    QMPSCQueue * const q = &me->eQueue;
+    QEQueueCtr nFree;
+    QS_CRIT_STAT_
+
+    Q_UNUSED_PAR(sender); /* when Q_SPY undefined */
+
+    /*! @pre event pointer must be valid */
+    Q_REQUIRE_ID(100, e != (QEvt *)0);
+
+    bool const status = QMPSCQueue_reserve(q, margin, &nFree);
+    if ((!status) && (margin == QF_NO_MARGIN)) {
+        Q_ERROR_ID(110); /* must be able to post the event */
+    }
+
+    /* is it a dynamic event? */
+    if (e->poolId_ != 0U) {
+        /* a moved event can be posted only once (see QActive_postMove_()) */
+        Q_ASSERT_ID(120, QF_EVT_NOT_MOVED_(e));
+
+        QF_EVT_REF_CTR_INC_(e); /* increment the reference counter */
+    }
+
+    if (status) { /* can post the event? */
+
+        QS_BEGIN_PRE_(QS_QF_ACTIVE_POST, me->prio)
+            QS_TIME_PRE_();       /* timestamp */
+            QS_OBJ_PRE_(sender);  /* the sender object */
+            QS_SIG_PRE_(e->sig);  /* the signal of the event */
+            QS_OBJ_PRE_(me);      /* this active object (recipient) */
+            QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
+            QS_EQC_PRE_(nFree);   /* number of free entries */
+            QS_EQC_PRE_(q->nMin); /* min number of free entries */
+        QS_END_PRE_()
+
+        QMPSCQueue_put(q, e);
+
+        /* was the queue empty? */
+        if (nFree == q->end) {
+            QActive_signal_(me); /* wake up the consumer */
+        }
+    }
+    else { /* cannot post the event */
+
+        QS_BEGIN_PRE_(QS_QF_ACTIVE_POST_ATTEMPT, me->prio)
+            QS_TIME_PRE_();       /* timestamp */
+            QS_OBJ_PRE_(sender);  /* the sender object */
+            QS_SIG_PRE_(e->sig);  /* the signal of the event */
+            QS_OBJ_PRE_(me);      /* this active object (recipient) */
+            QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
+            QS_EQC_PRE_(nFree);   /* number of free entries */
+            QS_EQC_PRE_(margin);  /* margin requested */
+        QS_END_PRE_()
+
+    #if (QF_MAX_EPOOL > 0U)
+        QF_gc(e); /* recycle the event to avoid a leak */
+    #endif
+    }
+
+    return status;
+}
+/*..........................................................................*/
+/* NOTE: can be called only from the thread of the AO 'me' (self-posting) */
+void QActive_postLIFO_(QActive * const me, QEvt const * const e) {
+    QMPSCQueue * const q = &me->eQueue;
+    QEQueueCtr nFree;
+    QS_CRIT_STAT_
+
+    /* the queue must be able to accept the event (cannot overflow) */
+    Q_ALLEGE_ID(210, QMPSCQueue_reserve(q, QF_NO_MARGIN, &nFree));
+
+    /* is it a dynamic event? */
+    if (e->poolId_ != 0U) {
+        QF_EVT_REF_CTR_INC_(e); /* increment the reference counter */
+    }
+
+    QS_BEGIN_PRE_(QS_QF_ACTIVE_POST_LIFO, me->prio)
+        QS_TIME_PRE_();       /* timestamp */
+        QS_SIG_PRE_(e->sig);  /* the signal of this event */
+        QS_OBJ_PRE_(me);      /* this active object */
+        QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
+        QS_EQC_PRE_(nFree);   /* # free entries */
+        QS_EQC_PRE_(q->nMin); /* min number of free entries */
+    QS_END_PRE_()
+
+    /* the consumer itself puts the event in front of the tail */
+    q->tail = (q->tail == 0U) ? q->end : (q->tail - 1U);
+    __atomic_store_n(QMPSC_ENTRY_(q, q->tail), e, __ATOMIC_RELAXED);
+}
+/*..........................................................................*/
+QEvt const *QActive_get_(QActive * const me) {
+    QMPSCQueue * const q = &me->eQueue;
+    QEvt const * volatile * const entry = QMPSC_ENTRY_(q, q->tail);
+    QS_CRIT_STAT_
+
+    QEvt const *e = __atomic_load_n(entry, __ATOMIC_ACQUIRE);
+    if (e == (QEvt *)0) { /* no event at the tail? */
+
+        /* block while the queue is empty (no entries reserved) */
+#ifdef QF_FUTEX_WAIT
+        QMPSCQueue_wait(q);
+#else
+        pthread_mutex_lock(&me->osObject.mutex);
+        while (__atomic_load_n(&q->nFree, __ATOMIC_ACQUIRE)
+               == (QEQueueCtr)(q->end + 1U))
+        {
+            pthread_cond_wait(&me->osObject.cond, &me->osObject.mutex);
+        }
+        pthread_mutex_unlock(&me->osObject.mutex);
+#endif
+
+        /* wait for the producer to store the reserved entry, NOTE07 */
+        for (uint_fast8_t n = 0U;
+             (e = __atomic_load_n(entry, __ATOMIC_ACQUIRE)) == (QEvt *)0;
+             ++n)
+        {
+            if (n < 16U) {
+                sched_yield();
+            }
+            else {
+                static struct timespec const c_wait = { 0, 1000L };
+                nanosleep(&c_wait, NULL);
+                n = 16U;
+            }
+        }
+    }
+
+    /* free the entry before releasing it to the producers */
+    __atomic_store_n(entry, (QEvt *)0, __ATOMIC_RELAXED);
+    q->tail = (q->tail == q->end) ? 0U : (q->tail + 1U);
+    QEQueueCtr const nFree = __atomic_add_fetch(&q->nFree, 1U,
+                                                __ATOMIC_RELEASE);
+
+    if (nFree <= q->end) { /* any events left in the queue? */
+        QS_BEGIN_PRE_(QS_QF_ACTIVE_GET, me->prio)
+            QS_TIME_PRE_();      /* timestamp */
+            QS_SIG_PRE_(e->sig); /* the signal of this event */
+            QS_OBJ_PRE_(me);     /* this active object */
+            QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
+            QS_EQC_PRE_(nFree);  /* # free entries */
+        QS_END_PRE_()
+    }
+    else {
+        QS_BEGIN_PRE_(QS_QF_ACTIVE_GET_LAST, me->prio)
+            QS_TIME_PRE_();      /* timestamp */
+            QS_SIG_PRE_(e->sig); /* the signal of this event */
+            QS_OBJ_PRE_(me);     /* this active object */
+            QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
+        QS_END_PRE_()
+    }
+    return e;
+}
+/*..........................................................................*/
+uint_fast16_t QF_getQueueMin(uint_fast16_t const prio) {
+    Q_REQUIRE_ID(400, (prio <= QF_MAX_ACTIVE)
+                      && (QActive_registry_[prio] != (QActive *)0));
+    return (uint_fast16_t)__atomic_load_n(
+               &QActive_registry_[prio]->eQueue.nMin, __ATOMIC_RELAXED);
+}
+#ifdef QF_PUBLISH_BATCH
+/*..........................................................................*/
+/* batched multicast to the lock-free AO event queues, see NOTE11 */
+void QF_multicast_(QPSet const * const subscrList, QEvt const * const e,
+                   void const * const sender)
+{
+    QS_CRIT_STAT_
+
+    Q_UNUSED_PAR(sender); /* when Q_SPY undefined */
+
+    QPSet batch; /* subscribers with the lock-free QActive_post_() */
+    QPSet other; /* subscribers with other post() operations */
+    QPSet_setEmpty(&batch);
+    QPSet_setEmpty(&other);
+    uint_fast16_t nBatch = 0U;
+
+    QPSet set = *subscrList;
+    while (QPSet_notEmpty(&set)) {
+        uint_fast16_t const p = QPSet_findMax(&set);
+        QPSet_remove(&set, p);
+        QActive const * const a = QActive_registry_[p];
+
+        /* the prio of the AO must be registered with the framework */
+        Q_ASSERT_ID(500, a != (QActive *)0);
+
+        if (((QActiveVtable const *)a->super.vptr)->post == &QActive_post_) {
+            QPSet_insert(&batch, p);
+            ++nBatch;
+        }
+        else {
+            QPSet_insert(&other, p);
+        }
+    }
+
+    /* all references of the batched recipients (plus the reference of
+    * the publisher) must fit in the reference counter
+    */
+    Q_ASSERT_ID(520,
+        (uint_fast32_t)nBatch < (uint_fast32_t)(QEvtRefCtr)~(QEvtRefCtr)0U);
+
+    /* add the references of all batched recipients at once */
+    if ((nBatch > 0U) && (e->poolId_ != 0U)) {
+        QF_EVT_REF_CTR_ADD_(e, nBatch);
+    }
+
+    QPSet wake; /* recipients whose queues were empty */
+    QPSet_setEmpty(&wake);
+    while (QPSet_notEmpty(&batch)) {
+        uint_fast16_t const p = QPSet_findMax(&batch);
+        QPSet_remove(&batch, p);
+        QActive * const a = QActive_registry_[p];
+        QMPSCQueue * const q = &a->eQueue;
+        QEQueueCtr nFree;
+
+        /* must be able to post the event */
+        Q_ALLEGE_ID(510, QMPSCQueue_reserve(q, QF_NO_MARGIN, &nFree));
+
+        QS_BEGIN_PRE_(QS_QF_ACTIVE_POST, a->prio)
+            QS_TIME_PRE_();       /* timestamp */
+            QS_OBJ_PRE_(sender);  /* the sender object */
+            QS_SIG_PRE_(e->sig);  /* the signal of the event */
+            QS_OBJ_PRE_(a);       /* this active object (recipient) */
+            QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
+            QS_EQC_PRE_(nFree);   /* number of free entries */
+            QS_EQC_PRE_(q->nMin); /* min number of free entries */
+        QS_END_PRE_()
+
+        QMPSCQueue_put(q, e);
+
+        /* was the queue empty? */
+        if (nFree == q->end) {
+            QPSet_insert(&wake, p); /* wake up after the fan-out */
+        }
+    }
+
+    /* wake up the consumers only after the whole fan-out */
+    while (QPSet_notEmpty(&wake)) {
+        uint_fast16_t const p = QPSet_findMax(&wake);
+        QPSet_remove(&wake, p);
+        QActive_signal_(QActive_registry_[p]);
+    }
+
+    /* the remaining subscribers */
+    while (QPSet_notEmpty(&other)) {
+        uint_fast16_t const p = QPSet_findMax(&other);
+        QPSet_remove(&other, p);
+
+        /* QACTIVE_POST() asserts internally if the queue overflows */
+        QACTIVE_POST(QActive_registry_[p], e, sender);
+    }
+}
+#endif /* QF_PUBLISH_BATCH */
+#ifdef QF_FUTEX_WAIT
+/*..........................................................................*/
+void QF_getWaitStats(uint_fast16_t const prio, QF_WaitStats * const stats) {
+    Q_REQUIRE_ID(420, (prio <= QF_MAX_ACTIVE)
+                      && (QActive_registry_[prio] != (QActive *)0)
+                      && (stats != (QF_WaitStats *)0));
+    QMPSCQueue const * const q = &QActive_registry_[prio]->eQueue;
+    stats->spin  = __atomic_load_n(&q->nSpin,  __ATOMIC_RELAXED);
+    stats->yield = __atomic_load_n(&q->nYield, __ATOMIC_RELAXED);
+    stats->block = __atomic_load_n(&q->nBlock, __ATOMIC_RELAXED);
 }
+#endif /* QF_FUTEX_WAIT */
+#endif /* QF_MPSC_EQUEUE */
+
+/****************************************************************************/
+/* time difference (a - b) [ns] */
+static int64_t timespecDiff(struct timespec const * const a,
+                            struct timespec const * const b)
+{
+    return ((int64_t)(a->tv_sec - b->tv_sec) * NANOSLEEP_NSEC_PER_SEC)
+           + (int64_t)(a->tv_nsec - b->tv_nsec);
+}
+/*..........................................................................*/
+static void timespecAdd(struct timespec * const t, int64_t const nsec) {
+    int64_t const ns = (int64_t)t->tv_nsec + nsec;
+    t->tv_sec  += (time_t)(ns / NANOSLEEP_NSEC_PER_SEC);
+    t->tv_nsec  = (long)(ns % NANOSLEEP_NSEC_PER_SEC);
+}
+/*..........................................................................*/
+/* update the statistics of the clock tick deadlines, see NOTE08 */
+static void tickerStat(uint32_t const overruns, int64_t lat) {
+    QF_CRIT_STAT_
+
+    if (lat < 0) { /* woken up before the deadline (e.g., by a signal)? */
+        lat = 0;
+    }
+    else if (lat > (int64_t)UINT32_MAX) {
+        lat = (int64_t)UINT32_MAX;
+    }
+    else {
+        /* latency within the range */
+    }
+
+    QF_CRIT_E_();
+    if ((l_tickStats.nTicks == 0U)
+        || ((uint32_t)lat < l_tickStats.minLat))
+    {
+        l_tickStats.minLat = (uint32_t)lat;
+    }
+    if ((uint32_t)lat > l_tickStats.maxLat) {
+        l_tickStats.maxLat = (uint32_t)lat;
+    }
+    ++l_tickStats.nTicks;
+    l_tickStats.nOverruns += overruns;
+    l_tickLatSum += (uint64_t)lat;
+    QF_CRIT_X_();
+}
+
+#ifndef QF_TICKLESS
+/*..........................................................................*/
+/* sleep until the absolute deadline of the next tick, see NOTE08 */
+static void tickerSleep(struct timespec * const next) {
+    int64_t const period = (int64_t)l_tick.tv_nsec;
+    struct timespec now;
+    uint32_t overruns = 0U;
+
+    timespecAdd(next, period);
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    int64_t const late = timespecDiff(&now, next);
+    if (late >= 0) { /* the deadline already passed? */
+#ifdef QF_TICK_CATCH_UP
+        overruns = 1U; /* the missed tick follows without sleeping */
+#else
+        /* skip all missed ticks, but keep the phase of the deadlines */
+        overruns = (uint32_t)((late / period) + 1);
+        timespecAdd(next, (int64_t)overruns * period);
+#endif
+    }
+
+#ifdef TIMER_ABSTIME
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, next, NULL)
+           == EINTR)
+    {
+        /* interrupted by a signal, sleep again */
+    }
+#else /* no clock_nanosleep(), sleep for the time left to the deadline */
+    int64_t const left = timespecDiff(next, &now);
+    if (left > 0) {
+        struct timespec rel = { 0, 0 };
+        timespecAdd(&rel, left);
+        nanosleep(&rel, NULL);
+    }
+#endif
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    tickerStat(overruns, timespecDiff(&now, next));
+}
+
+#else /* QF_TICKLESS */
+/*..........................................................................*/
+/* the number of clock ticks the ticker can sleep (0 for no limit) */
+static uint32_t tickerPlan(void) {
+    /* the other tick rates are derived from the rate 0 in the application,
+    * so the ticker keeps ticking while any of them is in use, see NOTE09
+    */
+    for (uint_fast8_t tickRate = 1U; tickRate < QF_MAX_TICK_RATE;
+         ++tickRate)
+    {
+        if (QTimeEvt_ticksToNext(tickRate) != 0U) {
+            return 1U;
+        }
+    }
+    return (uint32_t)QTimeEvt_ticksToNext(0U);
+}
+/*..........................................................................*/
+/* the "tickless" ticker loop, see NOTE09 */
+static void tickerLoop(int64_t const delay) {
+    int64_t const period = (int64_t)l_tick.tv_nsec;
+    struct timespec now;
+
+    pthread_mutex_lock(&l_tickerMutex);
+    l_tickerThread = pthread_self();
+    clock_gettime(CLOCK_MONOTONIC, &l_tickerNext);
+    timespecAdd(&l_tickerNext, delay); /* the first clock tick */
+    while (l_isRunning) {
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        if (timespecDiff(&now, &l_tickerNext) >= 0) { /* tick due? */
+            pthread_mutex_unlock(&l_tickerMutex);
+            QF_onClockTick(); /* callback (must call QTIMEEVT_TICK_X()) */
+            pthread_mutex_lock(&l_tickerMutex);
+
+            timespecAdd(&l_tickerNext, period);
+            pthread_cond_broadcast(&l_tickerSyncCond); /* one more tick */
+            continue;
+        }
+
+        /* all due ticks delivered */
+        if (l_tickerLong) {
+            l_tickerLong = false;
+            pthread_cond_broadcast(&l_tickerSyncCond);
+        }
+
+        /* any time event armed while planning wakes up the ticker */
+        l_tickerWake = false;
+        l_tickerPlan = UINT32_MAX;
+        pthread_mutex_unlock(&l_tickerMutex);
+        uint32_t const nTicks = tickerPlan();
+        pthread_mutex_lock(&l_tickerMutex);
+
+        if ((!l_tickerWake) && l_isRunning) {
+            l_tickerPlan = (nTicks != 0U) ? nTicks : UINT32_MAX;
+            l_tickerLong = (l_tickerPlan > 1U);
+            l_tickerSleeping = true;
+            if (nTicks != 0U) { /* sleep until the nearest expiration */
+                struct timespec deadline = l_tickerNext;
+                timespecAdd(&deadline, (int64_t)(nTicks - 1U) * period);
+                int err = 0;
+                while ((!l_tickerWake) && (err != ETIMEDOUT)) {
+                    err = pthread_cond_timedwait(&l_tickerWakeCond,
+                                                 &l_tickerMutex, &deadline);
+                }
+                if (err == ETIMEDOUT) {
+                    clock_gettime(CLOCK_MONOTONIC, &now);
+                    tickerStat(0U, timespecDiff(&now, &deadline));
+                }
+            }
+            else { /* no time events armed, sleep until woken up */
+                while (!l_tickerWake) {
+                    pthread_cond_wait(&l_tickerWakeCond, &l_tickerMutex);
+                }
+            }
+            l_tickerSleeping = false;
+        }
+    }
+    l_tickerLong = false;
+    pthread_cond_broadcast(&l_tickerSyncCond);
+    pthread_mutex_unlock(&l_tickerMutex);
+}
+/*..........................................................................*/
+/* deliver the clock ticks skipped by the ticker before arming a time event */
+void QF_ticklessSync_(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    pthread_mutex_lock(&l_tickerMutex);
+    if (!pthread_equal(pthread_self(), l_tickerThread)) {
+        while (l_tickerLong && (timespecDiff(&now, &l_tickerNext) >= 0)) {
+            if (l_tickerSleeping) {
+                l_tickerWake = true;
+                pthread_cond_signal(&l_tickerWakeCond);
+            }
+            pthread_cond_wait(&l_tickerSyncCond, &l_tickerMutex);
+        }
+    }
+    pthread_mutex_unlock(&l_tickerMutex);
+}
+/*..........................................................................*/
+/* wake up the ticker when a time event expires sooner than planned */
+void QF_ticklessWake_(uint_fast8_t const tickRate, QTimeEvtCtr const nTicks) {
+    pthread_mutex_lock(&l_tickerMutex);
+    if ((tickRate != 0U)
+        ? (l_tickerPlan > 1U)
+        : ((uint32_t)nTicks < l_tickerPlan))
+    {
+        l_tickerWake = true;
+        if (l_tickerSleeping) {
+            pthread_cond_signal(&l_tickerWakeCond);
+        }
+    }
+    pthread_mutex_unlock(&l_tickerMutex);
+}
+#endif /* QF_TICKLESS */
+
+#if (QF_MAX_HRTIMER > 0U)
+/****************************************************************************/
+/* high-resolution time events, see NOTE10 */
+uint64_t QF_hrTimeNow(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * (uint64_t)NANOSLEEP_NSEC_PER_SEC)
+           + (uint64_t)now.tv_nsec;
+}
+/*..........................................................................*/
+/* set the earliest deadline (called inside the QF critical section) */
+void QF_hrTimerSet_(uint64_t const deadline) {
+#ifdef __linux__
+    struct itimerspec its;
+    memset(&its, 0, sizeof(its)); /* one-shot; all zeros disarm the timer */
+    its.it_value.tv_sec  = (time_t)(deadline / NANOSLEEP_NSEC_PER_SEC);
+    its.it_value.tv_nsec = (long)(deadline % NANOSLEEP_NSEC_PER_SEC);
+    timerfd_settime(l_hrTimerFd, TFD_TIMER_ABSTIME, &its, NULL);
+#else
+    l_hrTimerDeadline = deadline;
+    pthread_cond_signal(&l_hrTimerCond);
+#endif
+}
+/*..........................................................................*/
+static void *hrTimerThread(void *arg) { /* for pthread_create() */
+    (void)arg; /* unused parameter */
+#ifdef __linux__
+    while (l_isRunning) {
+        uint64_t nExp;
+        /* block until the earliest deadline passes */
+        if (read(l_hrTimerFd, &nExp, sizeof(nExp)) > 0) {
+            QHrTimeEvt_expire_(QF_hrTimeNow(), &l_hrTimerThread);
+        }
+    }
+#else
+    pthread_mutex_lock(&QF_pThreadMutex_);
+    while (l_isRunning) {
+        uint64_t const deadline = l_hrTimerDeadline;
+        if (deadline == 0U) { /* no time events armed? */
+            pthread_cond_wait(&l_hrTimerCond, &QF_pThreadMutex_);
+        }
+        else if (QF_hrTimeNow() < deadline) {
+            struct timespec ts;
+            ts.tv_sec  = (time_t)(deadline / NANOSLEEP_NSEC_PER_SEC);
+            ts.tv_nsec = (long)(deadline % NANOSLEEP_NSEC_PER_SEC);
+            pthread_cond_timedwait(&l_hrTimerCond, &QF_pThreadMutex_, &ts);
+        }
+        else {
+            l_hrTimerDeadline = 0U; /* set again in QHrTimeEvt_expire_() */
+            pthread_mutex_unlock(&QF_pThreadMutex_);
+            QHrTimeEvt_expire_(QF_hrTimeNow(), &l_hrTimerThread);
+            pthread_mutex_lock(&QF_pThreadMutex_);
+        }
+    }
+    pthread_mutex_unlock(&QF_pThreadMutex_);
+#endif
+    return (void *)0; /* return success */
+}
+/*..........................................................................*/
+static void hrTimerStart(void) {
+    pthread_attr_t attr;
+    struct sched_param param;
+
+    /* the same real-time priority as the clock tick, see NOTE10 */
+    pthread_attr_init(&attr);
+    pthread_attr_setschedpolicy (&attr, SCHED_FIFO);
+    pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+    pthread_attr_setdetachstate (&attr, PTHREAD_CREATE_DETACHED);
+    param.sched_priority = l_tickPrio;
+    pthread_attr_setschedparam(&attr, &param);
+
+    int err = pthread_create(&l_hrTimerThread, &attr, &hrTimerThread, 0);
+    if (err != 0) { /* no privileges for SCHED_FIFO? */
+        pthread_attr_setschedpolicy(&attr, SCHED_OTHER);
+        param.sched_priority = 0;
+        pthread_attr_setschedparam(&attr, &param);
+        err = pthread_create(&l_hrTimerThread, &attr, &hrTimerThread, 0);
+    }
+    Q_ASSERT_ID(320, err == 0); /* the thread must be created */
+    pthread_attr_destroy(&attr);
+}
+#endif /* (QF_MAX_HRTIMER > 0U) */
 
 /****************************************************************************/
 static void sigIntHandler(int dummy) {
@@ -334,5 +1377,76 @@ static void sigIntHandler(int dummy) {
 * In some (older) Linux kernels, the POSIX nanosleep() system call might
 * deliver only 2*actual-system-tick granularity. To compensate for this,
 * you would need to reduce the constant NANOSLEEP_NSEC_PER_SEC by factor 2.
+*
+* NOTE06:
+* With the object-level critical sections (QF_OBJ_CRIT defined, see NOTE2
+* in qf_port.h), each active object queue has its own mutex initialized in
+* QActive_start_(), each memory pool has its own mutex initialized in
+* QMPool_init(), and the time events of each tick rate are protected by
+* the QF_timeEvtMutex_[] initialized in QF_init().
+*
+* NOTE07:
+* The consumer can find the queue not empty (an entry reserved by decrementing
+* nFree), but the producer still storing the event pointer in the entry. This
+* window is only a few instructions long, so the consumer just yields the CPU.
+* If the producer has lower priority (SCHED_FIFO), sched_yield() would not let
+* it run, so the consumer eventually sleeps briefly instead.
+*
+* NOTE08:
+* The ticker sleeps until absolute deadlines spaced exactly one tick period
+* apart (clock_nanosleep() with TIMER_ABSTIME on CLOCK_MONOTONIC), so the
+* time spent in QF_onClockTick() does not stretch the tick period and the
+* tick rate does not drift. When a deadline has already passed before the
+* ticker goes to sleep, the missed ticks are counted as overruns and by
+* default skipped, keeping the phase of the following deadlines. Defining
+* QF_TICK_CATCH_UP delivers the missed ticks back-to-back instead. The
+* latency of every wake-up past its deadline is recorded as well. The
+* cumulative statistics are available from QF_getTickStats(), which the
+* application can report, for example, in its own QS user record.
+*
+* NOTE09:
+* When the macro QF_TICKLESS is defined (e.g., -DQF_TICKLESS), the ticker (QF_run())
+* does not wake up at every clock tick. Instead, it sleeps until the tick
+* at which the nearest time event expires (QTimeEvt_ticksToNext()) or
+* indefinitely when no time events are armed. The clock ticks skipped in the
+* meantime are delivered back-to-back by calling QF_onClockTick() when the
+* ticker wakes up, so the tick counts stay identical to the periodic clock
+* tick. Arming a time event that expires sooner than planned wakes up the
+* ticker (QF_ticklessWake_()). Before a time event is armed, the ticks whose
+* deadlines have already passed are delivered first (QF_ticklessSync_()), so
+* the time event expires at the same clock tick as with the periodic tick.
+* Time events armed at the tick rates other than 0 keep the ticker ticking
+* periodically, because QF_onClockTick() derives these rates from the rate 0.
+* Consequently, QF_onClockTick() should only call QTIMEEVT_TICK_X() (and not
+* poll for inputs, for example). In this mode, QF_getTickStats() covers
+* the timed wake-ups of the ticker.
+*
+* NOTE10:
+* The high-resolution time events (QHrTimeEvt, up to QF_MAX_HRTIMER armed
+* at a time) are kept by QF in a heap sorted by the deadline in nanoseconds
+* of CLOCK_MONOTONIC (QF_hrTimeNow()). QF calls QF_hrTimerSet_() with the
+* earliest deadline whenever it changes. On Linux, this deadline is set as
+* the absolute expiration time of a timerfd, which the dedicated time event
+* thread reads (blocks on). Elsewhere, this thread waits for the deadline on
+* a condition variable on CLOCK_MONOTONIC. Either way, the expired time
+* events are posted by QHrTimeEvt_expire_() independently from the clock
+* tick, so their resolution is limited only by the OS timer slack and the
+* wake-up latency of the thread. The thread runs at the same priority as the
+* ticker (see QF_setTickRate()).
+*
+* NOTE11:
+* With the lock-free AO event queues, the batched multicast (QF_PUBLISH_BATCH)
+* adds the references of all subscribers to the published event with one
+* atomic operation, reserves an entry in every subscriber's queue exactly as
+* QActive_post_() does, and wakes up the subscribers whose queues were empty
+* only after the event has been placed in all the queues. This way, the
+* publisher is not preempted by the woken-up subscribers in the middle of
+* the fan-out.
+*
+* NOTE12:
+* Linux provides only 99 SCHED_FIFO priorities, so with more than 64 active
+* objects (QF_MAX_ACTIVE > 64U, see NOTE7 in qf_port.h), the QF priorities
+* are scaled down to the SCHED_FIFO range and several AOs share the same
+* thread priority. The relative order of the thread priorities is preserved.
 */
 
@@ -32,17 +32,32 @@
 #ifndef QF_PORT_H
 #define QF_PORT_H
 
+/* the futex-based AO wait strategy requires the lock-free AO queues */
+#if (defined QF_FUTEX_WAIT) && (!defined QF_MPSC_EQUEUE)
+    #define QF_MPSC_EQUEUE
+#endif
+
 /* POSIX event queue and thread types */
+#ifndef QF_MPSC_EQUEUE
 #define QF_EQUEUE_TYPE       QEQueue
-#define QF_OS_OBJECT_TYPE    pthread_cond_t
-#define QF_THREAD_TYPE       bool
+#else
+#define QF_EQUEUE_TYPE       QMPSCQueue  /* lock-free AO queue, see NOTE3 */
+#endif
+#define QF_THREAD_TYPE       QF_ActiveThread /* see NOTE5 */
 
-/* The maximum number of active objects in the application */
+/* The maximum number of active objects in the application, see NOTE7 */
+#ifndef QF_MAX_ACTIVE
 #define QF_MAX_ACTIVE        64U
+#endif
 
 /* The number of system clock tick rates */
 #define QF_MAX_TICK_RATE     2U
 
+/* The maximum number of armed high-resolution time events */
+#ifndef QF_MAX_HRTIMER
+#define QF_MAX_HRTIMER       64U
+#endif
+
 /* Activate the QF QActive_stop() API */
 #define QF_ACTIVE_STOP       1
 
@@ -53,15 +68,122 @@
 #define QF_MPOOL_CTR_SIZE    4U
 #define QF_TIMEEVT_CTR_SIZE  4U
 
+/* QF_LOG2 with the count-leading-zeros builtin of the compiler, see NOTE7 */
+#ifdef __GNUC__
+#define QF_LOG2(n_) ((uint_fast8_t)(((n_) != 0U) \
+    ? (32U - (uint_fast8_t)__builtin_clz((unsigned)(n_))) : 0U))
+#endif
+
 /* QF critical section entry/exit for POSIX, see NOTE1 */
 /* QF_CRIT_STAT_TYPE not defined */
 #define QF_CRIT_ENTRY(dummy) QF_enterCriticalSection_()
 #define QF_CRIT_EXIT(dummy)  QF_leaveCriticalSection_()
 
 #include <pthread.h>   /* POSIX-thread API */
+
+/* the lock-free AO queues require object-level critical sections */
+#if (defined QF_MPSC_EQUEUE) && (!defined QF_OBJ_CRIT)
+    #define QF_OBJ_CRIT
+#endif
+
+/* batched dequeue of events in the AO threads (optional), see NOTE8 */
+#ifdef QF_ACTQ_BATCH
+    #if (QF_ACTQ_BATCH < 2U) || (QF_ACTQ_BATCH > 255U)
+        #error "QF_ACTQ_BATCH defined incorrectly, expected 2U..255U"
+    #endif
+    #ifdef QF_MPSC_EQUEUE
+        #error "QF_ACTQ_BATCH is not supported with QF_MPSC_EQUEUE"
+    #endif
+#endif /* QF_ACTQ_BATCH */
+
+/* QF object-level critical sections (optional), see NOTE2 */
+#ifdef QF_OBJ_CRIT
+
+    /* QActive "OS-object" with its own mutex and condition variable */
+    typedef struct {
+        pthread_cond_t  cond;  /* signaled when the queue becomes not empty */
+        pthread_mutex_t mutex; /* protects the AO's event queue */
+    } QF_ActiveOSObject;
+    #define QF_OS_OBJECT_TYPE  QF_ActiveOSObject
+
+    /* separate mutex in every memory pool */
+    #define QF_MPOOL_CRIT_TYPE pthread_mutex_t
+
+#else
+
+    #define QF_OS_OBJECT_TYPE  pthread_cond_t
+
+#endif /* QF_OBJ_CRIT */
+
 #include "qep_port.h"  /* QEP port */
 #include "qequeue.h"   /* POSIX needs event-queue */
 #include "qmpool.h"    /* POSIX needs memory-pool */
+
+/* scheduling policy and priority of an AO thread, see NOTE5 */
+typedef struct {
+    int policy; /* SCHED_FIFO, SCHED_RR, SCHED_OTHER, SCHED_BATCH, ... */
+    int prio;   /* real-time priority or nice level (SCHED_OTHER/BATCH) */
+} QF_SchedAttr;
+
+/* p-thread of an active object, see NOTE5 */
+typedef struct {
+    char const *name;           /* thread name or NULL */
+    void const *cpuSet;         /* CPU affinity (cpu_set_t const *) or NULL */
+    QF_SchedAttr const *sched;  /* scheduling attributes or NULL */
+    bool volatile isRunning;    /* the thread loop is running */
+#ifdef QF_ACTQ_BATCH
+    QEQueueCtr nLifo; /* events posted LIFO to itself in a batch, NOTE8 */
+#endif
+} QF_ActiveThread;
+
+/* attributes of the AO threads for QActive_setAttr(), see NOTE5 */
+enum QF_ActiveThreadAttrs {
+    THREAD_NAME_ATTR,     /* attr2: char const * (up to 15 characters) */
+    THREAD_AFFINITY_ATTR, /* attr2: cpu_set_t const * (Linux only) */
+    THREAD_SCHED_ATTR     /* attr2: QF_SchedAttr const * */
+};
+
+#ifdef QF_MPSC_EQUEUE
+/* Lock-free, bounded, multiple-producer/single-consumer AO event queue,
+* see NOTE3
+*/
+typedef struct {
+    QEvt const * volatile *ring; /* ring buffer of events (user storage) */
+    QEvt const * volatile last;  /* the extra (last) entry of the ring */
+    QEQueueCtr end;              /* number of entries in ring[] */
+    QEQueueCtr volatile head;    /* next entry claimed by a producer */
+    QEQueueCtr tail;             /* next entry taken by the consumer */
+    QEQueueCtr volatile nFree;   /* number of free entries (+1 for last) */
+    QEQueueCtr volatile nMin;    /* minimum number of free entries ever */
+#ifdef QF_FUTEX_WAIT
+    uint32_t spins;          /* spin iterations before yielding, see NOTE4 */
+    uint32_t yields;         /* yields before blocking on the futex */
+    uint32_t volatile nSpin; /* waits ended in the spinning phase */
+    uint32_t volatile nYield;/* waits ended in the yielding phase */
+    uint32_t volatile nBlock;/* waits that blocked on the futex */
+    uint32_t volatile waiting; /* consumer blocked (or about to) */
+#endif /* QF_FUTEX_WAIT */
+} QMPSCQueue;
+#endif /* QF_MPSC_EQUEUE */
+
+#ifdef QF_FUTEX_WAIT
+#ifndef QF_FUTEX_SPINS
+    /* default number of spin iterations before yielding the CPU */
+    #define QF_FUTEX_SPINS   200U
+#endif
+#ifndef QF_FUTEX_YIELDS
+    /* default number of sched_yield() calls before blocking */
+    #define QF_FUTEX_YIELDS  10U
+#endif
+
+/* statistics of the AO wait phases, see QF_getWaitStats() */
+typedef struct {
+    uint32_t spin;  /* waits ended in the spinning phase */
+    uint32_t yield; /* waits ended in the yielding phase */
+    uint32_t block; /* waits that blocked on the futex */
+} QF_WaitStats;
+#endif /* QF_FUTEX_WAIT */
+
 #include "qf.h"        /* QF platform-independent public interface */
 
 void QF_enterCriticalSection_(void);
@@ -70,7 +192,34 @@ void QF_leaveCriticalSection_(void);
 /* set clock tick rate and p-thread priority */
 void QF_setTickRate(uint32_t ticksPerSec, int_t tickPrio);
 
-/* clock tick callback (NOTE not called when "ticker thread" is not running) */
+/* statistics of the clock tick deadlines, see NOTE08 in qf_port.c */
+typedef struct {
+    uint32_t nTicks;    /* number of clock ticks */
+    uint32_t nOverruns; /* number of missed tick deadlines */
+    uint32_t minLat;    /* minimum wake-up latency past the deadline [ns] */
+    uint32_t maxLat;    /* maximum wake-up latency past the deadline [ns] */
+    uint32_t avgLat;    /* average wake-up latency past the deadline [ns] */
+} QF_TickStats;
+
+/* obtain the cumulative statistics of the clock tick deadlines */
+void QF_getTickStats(QF_TickStats * const stats);
+
+#if (QF_MAX_HRTIMER > 0U)
+/* current CLOCK_MONOTONIC time [ns] for QHrTimeEvt, see NOTE10 in qf_port.c */
+uint64_t QF_hrTimeNow(void);
+#endif
+
+#ifdef QF_FUTEX_WAIT
+/* obtain the wait statistics of the AO with the given priority */
+void QF_getWaitStats(uint_fast16_t const prio, QF_WaitStats * const stats);
+#endif
+
+/* clock tick callback (NOTE not called when "ticker thread" is not running)
+* NOTE: with QF_TICKLESS, QF_onClockTick() must only call QTIMEEVT_TICK_X()
+* (for any tick rates), because the skipped ticks are delivered back-to-back
+* when the ticker wakes up. Polling inputs or other periodic work must be
+* done elsewhere (e.g., in a time event handler), see NOTE09 in qf_port.c.
+*/
 void QF_onClockTick(void); /* clock tick callback (provided in the app) */
 
 /* abstractions for console access... */
@@ -88,6 +237,8 @@ int QF_consoleWaitForKey(void);
     #define QF_SCHED_LOCK_(dummy) ((void)0)
     #define QF_SCHED_UNLOCK_()    ((void)0)
 
+#ifndef QF_OBJ_CRIT
+
     /* POSIX active object event queue customization... */
     #define QACTIVE_EQUEUE_WAIT_(me_) \
         while ((me_)->eQueue.frontEvt == (QEvt *)0) \
@@ -96,19 +247,100 @@ int QF_consoleWaitForKey(void);
         Q_ASSERT_ID(410, QActive_registry_[(me_)->prio] != (QActive *)0); \
         pthread_cond_signal(&(me_)->osObject)
 
+#else /* object-level critical sections, see NOTE2 */
+
+    /* critical section of the AO's event queue */
+    #define QF_ACTQ_CRIT_ENTRY(me_) \
+        pthread_mutex_lock(&(me_)->osObject.mutex)
+    #define QF_ACTQ_CRIT_EXIT(me_) \
+        pthread_mutex_unlock(&(me_)->osObject.mutex)
+
+    /* critical section of the memory pool */
+    #define QF_MPOOL_CRIT_INIT(me_)  pthread_mutex_init(&(me_)->crit, NULL)
+    #define QF_MPOOL_CRIT_ENTRY(me_) pthread_mutex_lock(&(me_)->crit)
+    #define QF_MPOOL_CRIT_EXIT(me_)  pthread_mutex_unlock(&(me_)->crit)
+
+    /* critical section of the time events at a given tick rate */
+    #define QF_TIMEEVT_CRIT_ENTRY(rate_) \
+        pthread_mutex_lock(&QF_timeEvtMutex_[(rate_)])
+    #define QF_TIMEEVT_CRIT_EXIT(rate_) \
+        pthread_mutex_unlock(&QF_timeEvtMutex_[(rate_)])
+
+#ifndef QF_MPSC_EQUEUE
+
+    /* POSIX active object event queue customization... */
+    #define QACTIVE_EQUEUE_WAIT_(me_) \
+        while ((me_)->eQueue.frontEvt == (QEvt *)0) \
+            pthread_cond_wait(&(me_)->osObject.cond, &(me_)->osObject.mutex)
+    #define QACTIVE_EQUEUE_SIGNAL_(me_) \
+        Q_ASSERT_ID(410, QActive_registry_[(me_)->prio] != (QActive *)0); \
+        pthread_cond_signal(&(me_)->osObject.cond)
+
+#else
+
+    /* the AO queue operations are provided in qf_port.c, see NOTE3 */
+    #define QF_ACTQ_PORT
+
+#endif /* QF_MPSC_EQUEUE */
+
+    /* mutexes for the time events at each tick rate */
+    extern pthread_mutex_t QF_timeEvtMutex_[QF_MAX_TICK_RATE];
+
+#endif /* QF_OBJ_CRIT */
+
     /* native QF event pool operations */
     #define QF_EPOOL_TYPE_            QMPool
     #define QF_EPOOL_INIT_(p_, poolSto_, poolSize_, evtSize_) \
         (QMPool_init(&(p_), (poolSto_), (poolSize_), (evtSize_)))
     #define QF_EPOOL_EVENT_SIZE_(p_)  ((uint_fast16_t)(p_).blockSize)
+#ifndef QF_EPOOL_MAG_SIZE
     #define QF_EPOOL_GET_(p_, e_, m_, qs_id_) \
         ((e_) = (QEvt *)QMPool_get(&(p_), (m_), (qs_id_)))
     #define QF_EPOOL_PUT_(p_, e_, qs_id_) \
         (QMPool_put(&(p_), (e_), (qs_id_)))
+#else /* per-thread caches of free events, see NOTE6 */
+    #if (QF_EPOOL_MAG_SIZE < 2U) || (QF_EPOOL_MAG_SIZE > 0xFFU)
+        #error "QF_EPOOL_MAG_SIZE defined incorrectly, expected 2U..255U"
+    #endif
+    #define QF_EPOOL_GET_(p_, e_, m_, qs_id_) \
+        ((e_) = (QEvt *)QF_magGet_(&(p_), (m_), (qs_id_)))
+    #define QF_EPOOL_PUT_(p_, e_, qs_id_) \
+        (QF_magPut_(&(p_), (e_), (qs_id_)))
+    void *QF_magGet_(QMPool * const pool, uint_fast16_t const margin,
+                     uint_fast8_t const qs_id);
+    void QF_magPut_(QMPool * const pool, void * const b,
+                    uint_fast8_t const qs_id);
+
+    /* returns the events cached by the calling thread to the pools */
+    void QF_magFlush(void);
+#endif /* QF_EPOOL_MAG_SIZE */
+
+#ifdef QF_ACTQ_BATCH
+    /* LIFO self-posting during a batch (e.g., QActive_recall()), see NOTE8 */
+    #define QACTIVE_EQUEUE_LIFO_(me_) \
+        ((void)(((me_) == QF_batchAct_) ? ++(me_)->thread.nLifo : 0U))
+    extern __thread QActive *QF_batchAct_; /* AO of the calling thread */
+#endif /* QF_ACTQ_BATCH */
 
     /* mutex for QF critical section */
     extern pthread_mutex_t QF_pThreadMutex_;
 
+#ifdef QF_TICKLESS
+    /* "tickless" clock tick hooks, see NOTE09 in qf_port.c */
+    #define QF_TICKLESS_SYNC_(rate_) QF_ticklessSync_()
+    #define QF_TICKLESS_WAKE_(rate_, nTicks_) \
+        QF_ticklessWake_((rate_), (nTicks_))
+    void QF_ticklessSync_(void);
+    void QF_ticklessWake_(uint_fast8_t const tickRate,
+                          QTimeEvtCtr const nTicks);
+#endif
+
+#if (QF_MAX_HRTIMER > 0U)
+    /* high-resolution time event hook, see NOTE10 in qf_port.c */
+    #define QF_HRTIMER_SET_(deadline_) QF_hrTimerSet_((deadline_))
+    void QF_hrTimerSet_(uint64_t const deadline);
+#endif
+
 #endif /* QP_IMPL */
 
 /****************************************************************************/
@@ -140,6 +372,129 @@ int QF_consoleWaitForKey(void);
 * also subject to priority inversions. However, the p-thread mutex
 * implementation, such as POSIX threads, should support the priority-
 * inheritance protocol.
+*
+* NOTE2:
+* When the macro QF_OBJ_CRIT is defined (e.g., on the command line
+* -DQF_OBJ_CRIT), this port replaces the single QF_pThreadMutex_ with
+* object-level critical sections for the hot paths of the framework:
+* every active object queue is protected by its own mutex (in the AO's
+* osObject together with the condition variable), every memory pool by
+* its own mutex (QMPool.crit), and all time events at a given tick rate
+* by the QF_timeEvtMutex_[rate] mutex. This allows active objects running
+* on different CPU cores to post, allocate and recycle events without
+* contending for the same lock. The global QF_pThreadMutex_ still protects
+* the publish-subscribe lists, the active object registry and the
+* "raw" event queues. The event reference counters are then updated with
+* atomic operations and QS tracing uses its own separate mutex (see
+* qs_port.h). Mutexes are always acquired in the order: global or object
+* critical section first, followed by the QS critical section.
+*
+* NOTE3:
+* When the macro QF_MPSC_EQUEUE is defined (e.g., -DQF_MPSC_EQUEUE), the
+* active objects use the lock-free QMPSCQueue instead of the native QEQueue
+* and the functions QActive_post_(), QActive_postLIFO_(), QActive_get_() and
+* QF_getQueueMin() are provided in qf_port.c instead of qf_actq.c. This
+* option implies QF_OBJ_CRIT (NOTE2).
+*
+* The producers reserve a free entry by atomically decrementing nFree
+* (which also enforces the margin and updates nMin), claim the next entry
+* at the head and store the event pointer there. Only the producer that
+* finds the queue empty (nFree == end + 1) wakes up the consumer, so posting
+* to a busy AO costs no mutex and no system call. The single consumer (the
+* AO thread) takes the events at the tail and blocks on the condition
+* variable in the osObject only when the queue is empty.
+*
+* QActive_postLIFO_() may be called only from the thread of the AO itself
+* (self-posting, such as in QActive_recall()). The QTicker active object is
+* not available with QF_MPSC_EQUEUE.
+*
+* NOTE4:
+* When the macro QF_FUTEX_WAIT is defined (Linux only, e.g.,
+* -DQF_FUTEX_WAIT), QActive_get_() waits for an event to an empty queue in
+* three phases: it first spins for up to QF_FUTEX_SPINS iterations, then it
+* calls sched_yield() up to QF_FUTEX_YIELDS times, and only then it blocks
+* on a futex (the nFree counter of the queue). The producers issue the
+* FUTEX_WAKE system call only when the consumer is actually blocked, so that
+* bursty traffic to a spinning AO incurs no system calls at all. The number
+* of waits ended in each phase is counted per AO and can be obtained with
+* QF_getWaitStats() to tune the two limits for the tail latency versus the
+* CPU usage. On a uniprocessor the spinning and yielding phases are skipped,
+* because the producer cannot run while the consumer spins. This option
+* implies QF_MPSC_EQUEUE (NOTE3).
+*
+* NOTE5:
+* By default, every AO thread is created with the SCHED_FIFO policy and
+* the priority derived from the QF priority of the AO (see NOTE04 in
+* qf_port.c). QActive_setAttr() can override this before QACTIVE_START():
+* THREAD_NAME_ATTR names the thread (visible in top, perf or ftrace),
+* THREAD_AFFINITY_ATTR pins the thread to the given set of CPU cores (e.g.,
+* to isolate a hot AO on a dedicated core) and THREAD_SCHED_ATTR selects
+* the scheduling policy and priority. For the SCHED_OTHER and SCHED_BATCH
+* policies the priority is the nice level of the thread. All attributes
+* are referenced by pointers, so the objects must remain valid at least
+* until QF_run() starts the AO threads.
+*
+* NOTE6:
+* When the macro QF_EPOOL_MAG_SIZE is defined (e.g., -DQF_EPOOL_MAG_SIZE=16U),
+* every thread keeps a small cache ("magazine") of up to QF_EPOOL_MAG_SIZE
+* free events for each event pool. Q_NEW() takes an event from the magazine
+* of the calling thread and QF_gc() returns the event to the magazine of the
+* thread that recycles it, both without any critical section. Only an empty
+* magazine is refilled and a full magazine is drained by a batch of
+* QF_EPOOL_MAG_SIZE/2 events in a single critical section of the pool
+* (QMPool_getBatch_() and QMPool_putBatch_()). The allocations with a margin
+* (Q_NEW_X() with a non-zero margin) bypass the magazines, so the margin is
+* checked exactly.
+*
+* The free events cached in the magazines are counted as used by the pool.
+* The nFree and nMin counters of the pool (QF_getPoolMin() and the
+* QS_QF_MPOOL_GET/PUT trace records) count only the free events in the
+* shared pool and change at the batch granularity. They are lower than the
+* number of the events not in use by up to QF_EPOOL_MAG_SIZE events per
+* thread. Also, Q_NEW() fails (assertion 320 in qf_dyn) as soon as the
+* magazine of the calling thread and the shared pool are both empty, even
+* if other threads still cache free events. Therefore, every event pool
+* must have room for up to QF_EPOOL_MAG_SIZE additional events per thread
+* that allocates or recycles the events.
+*
+* The cached events are returned to the pools when the thread exits (the
+* destructor of a thread-specific key), when the AO thread stops, in
+* QF_stop() (the events of the calling thread) and at the end of QF_run()
+* before QF_onCleanup() (the events of the main thread). A thread that
+* lives on but stops using events (e.g., a non-AO thread that produced the
+* events only during a startup phase) can return its cached events by
+* calling QF_magFlush().
+*
+* NOTE7:
+* The application can define QF_MAX_ACTIVE up to 1024U (e.g.,
+* -DQF_MAX_ACTIVE=512U) to run several hundred active objects in one
+* process. Beyond 64U, the priority sets (the subscriber lists) are
+* two-level bitmaps with the summary word (see ::QPSet), and QF_LOG2() uses
+* the CLZ builtin of the compiler, so that QPSet_findMax() remains O(1).
+* Beyond 255U, the QF-priority and the preemption-threshold take 16 bits
+* each (see Q_PRIO()). Since Linux provides fewer SCHED_FIFO priorities,
+* several AOs share the same thread priority (see NOTE12 in qf_port.c).
+* QS software tracing is not available with more than 64 active objects,
+* and an event published to more than 254 subscribers requires the wider
+* event reference counter (Q_EVT_REF_CTR_SIZE of 2U or 4U).
+*
+* NOTE8:
+* When the macro QF_ACTQ_BATCH is defined (e.g., -DQF_ACTQ_BATCH=16U), every
+* AO thread takes up to QF_ACTQ_BATCH events from its queue at once with
+* QActive_getBatch_(), which enters the critical section of the queue only
+* once per batch. The thread then dispatches and garbage-collects the events
+* from the buffer on its stack without touching the queue. The QS trace
+* records and the number of free entries in the queue are the same as with
+* QActive_get_(), but the events are removed from the queue earlier. Hence
+* the posters see more free entries while a batch is being processed. An
+* event that the AO posts LIFO to itself during a batch (e.g., with
+* QActive_recall()) is counted in QF_ActiveThread.nLifo (see
+* QACTIVE_EQUEUE_LIFO_()) and the thread takes it from the queue with
+* QActive_get_() and dispatches it right after the current event, before
+* the remaining events of the batch (as without QF_ACTQ_BATCH). When the AO
+* stops itself (QActive_stop()), the remaining events of the batch are not
+* dispatched, but are garbage-collected. This option is not available with
+* the lock-free AO queues (NOTE3), which take no lock in QActive_get_().
 */
 
 #endif /* QF_PORT_H */
@@ -64,6 +64,11 @@
 #define INVALID_SOCKET -1
 #define SOCKET_ERROR   -1
 
+#ifdef QF_OBJ_CRIT
+/* global variables ........................................................*/
+pthread_mutex_t QS_pThreadMutex_ = PTHREAD_MUTEX_INITIALIZER;
+#endif /* QF_OBJ_CRIT */
+
 /* local variables .........................................................*/
 static int l_sock = INVALID_SOCKET;
 static struct timespec const c_timeout = { 0, QS_TIMEOUT_MS*1000000L };
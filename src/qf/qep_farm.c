@@ -0,0 +1,330 @@
+/*$file${src::qf::qep_farm.c} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
+/*
+* Model: qpc.qm
+* File:  ${src::qf::qep_farm.c}
+*
+* This code has been generated by QM 5.2.1 <www.state-machine.com/qm>.
+* DO NOT EDIT THIS FILE MANUALLY. All your changes will be lost.
+*
+* This code is covered by the following QP license:
+* License #    : LicenseRef-QL-dual
+* Issued to    : Any user of the QP/C real-time embedded framework
+* Framework(s) : qpc
+* Support ends : 2023-12-31
+* License scope:
+*
+* Copyright (C) 2005 Quantum Leaps, LLC <state-machine.com>.
+*
+* SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+*
+* This software is dual-licensed under the terms of the open source GNU
+* General Public License version 3 (or any later version), or alternatively,
+* under the terms of one of the closed source Quantum Leaps commercial
+* licenses.
+*
+* The terms of the open source GNU General Public License version 3
+* can be found at: <www.gnu.org/licenses/gpl-3.0>
+*
+* The terms of the closed source Quantum Leaps commercial licenses
+* can be found at: <www.state-machine.com/licensing>
+*
+* Redistributions in source code must retain this top-level comment block.
+* Plagiarizing this software to sidestep the license obligations is illegal.
+*
+* Contact information:
+* <www.state-machine.com/licensing>
+* <info@state-machine.com>
+*/
+/*$endhead${src::qf::qep_farm.c} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+/*! @file
+* @brief ::QHsmFarm implementation
+*/
+#define QP_IMPL           /* this is QP implementation */
+#include "qep_port.h"     /* QEP port */
+#include "qassert.h"      /* QP embedded systems-friendly assertions */
+#ifdef Q_SPY              /* QS software tracing enabled? */
+    #include "qs_port.h"  /* QS port */
+    #include "qs_pkg.h"   /* QS facilities for pre-defined trace records */
+#else
+    #include "qs_dummy.h" /* disable the QS software tracing */
+#endif /* Q_SPY */
+
+Q_DEFINE_THIS_MODULE("qep_farm")
+
+/*==========================================================================*/
+/*! the last group, which collects the instances in all the other states */
+#define QHSM_FARM_OTHER_ ((uint_fast8_t)(QHSM_FARM_STATES - 1U))
+
+/*! pointer to the instance @p i_ in the ::QHsmFarm */
+#define QHSM_FARM_INST_(i_) \
+    ((QHsm *)&me->sto[(uint_fast32_t)(i_) * me->stride])
+
+/*==========================================================================*/
+/*$skip${QP_VERSION} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
+/* Check for the minimum required QP version */
+#if (QP_VERSION < 690U) || (QP_VERSION != ((QP_RELEASE^4294967295U) % 0x3E8U))
+#error qpc version 6.9.0 or higher required
+#endif
+/*$endskip${QP_VERSION} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+
+/*$define${QEP::QHsmFarm} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
+
+/*${QEP::QHsmFarm} .........................................................*/
+
+/*${QEP::QHsmFarm::ctor} ...................................................*/
+void QHsmFarm_ctor(QHsmFarm * const me,
+    void * const sto,
+    uint_fast16_t const stride,
+    uint_fast16_t const n,
+    uint8_t * const grpSto,
+    uint16_t * const orderSto)
+{
+    /*! @pre the storage of the instances, the groups and the indices must
+    * be provided and the instances must be derived from QHsm
+    */
+    Q_REQUIRE_ID(100, (sto != (void *)0)
+                      && (grpSto != (uint8_t *)0)
+                      && (orderSto != (uint16_t *)0)
+                      && (n != 0U) && (n <= 0xFFFFU)
+                      && (stride >= sizeof(QHsm)) && (stride <= 0xFFFFU));
+
+    me->sto    = (uint8_t *)sto;
+    me->grp    = grpSto;
+    me->order  = orderSto;
+    me->stride = (uint16_t)stride;
+    me->n      = (uint16_t)n;
+    me->nGrp   = 0U;
+    for (uint_fast16_t g = 0U; g < QHSM_FARM_STATES; ++g) {
+        me->grpState[g] = Q_STATE_CAST(0);
+        me->grpCnt[g]   = 0U;
+    }
+    #ifdef QHSM_SIG_MAP
+    me->smap   = (QHsmSigMap const *)0; /* set by QHsmFarm_init() */
+    #endif /* def QHSM_SIG_MAP */
+}
+
+/*${QEP::QHsmFarm::init} ...................................................*/
+void QHsmFarm_init(QHsmFarm * const me,
+    void const * const par,
+    uint_fast8_t const qs_id)
+{
+    for (uint_fast16_t i = 0U; i < me->n; ++i) {
+        QHsm * const inst = QHSM_FARM_INST_(i);
+
+        /* the instance must be a QHsm (dispatched without the vptr) */
+        Q_ASSERT_ID(210, (inst->vptr != (struct QHsmVtable *)0)
+                         && (inst->vptr->dispatch == &QHsm_dispatch_));
+
+    #ifdef QHSM_SIG_MAP
+        /* all the instances must share the same signal map (or none) */
+        if (i == 0U) {
+            me->smap = inst->smap;
+        }
+        Q_ASSERT_ID(220, inst->smap == me->smap);
+    #endif /* def QHSM_SIG_MAP */
+
+        QHsm_init_(inst, par, qs_id); /* the top-most initial transition */
+        uint_fast8_t const g = QHsmFarm_group_(me, inst->state.fun);
+        me->grp[i] = (uint8_t)g;
+        ++me->grpCnt[g];
+    }
+}
+
+/*${QEP::QHsmFarm::dispatch} ...............................................*/
+void QHsmFarm_dispatch(QHsmFarm * const me,
+    QEvt const * const e,
+    uint_fast16_t const i,
+    uint_fast8_t const qs_id)
+{
+    /*! @pre the index must be in range */
+    Q_REQUIRE_ID(300, i < me->n);
+
+    QHsm * const inst = QHSM_FARM_INST_(i);
+    QStateHandler const s = inst->state.fun;
+    QHsm_dispatch_(inst, e, qs_id);
+    if ((inst->state.fun != s) /* state changed? */
+        || ((me->grp[i] == QHSM_FARM_OTHER_)
+            && (me->nGrp < QHSM_FARM_OTHER_)))
+    {
+        QHsmFarm_regroup_(me, i);
+    }
+}
+
+/*${QEP::QHsmFarm::dispatchSet} ............................................*/
+void QHsmFarm_dispatchSet(QHsmFarm * const me,
+    QEvt const * const e,
+    uint16_t const * const set,
+    uint_fast16_t const nSet,
+    uint_fast8_t const qs_id)
+{
+    /*! @pre the set must be provided and must fit in the scratch storage */
+    Q_REQUIRE_ID(400, (set != (uint16_t const *)0) && (nSet <= me->n));
+
+    QHsmFarm_dispatchGroups_(me, e, set, nSet, qs_id);
+}
+
+/*${QEP::QHsmFarm::broadcast} ..............................................*/
+void QHsmFarm_broadcast(QHsmFarm * const me,
+    QEvt const * const e,
+    uint_fast8_t const qs_id)
+{
+    QHsmFarm_dispatchGroups_(me, e, (uint16_t const *)0, me->n, qs_id);
+}
+
+/*${QEP::QHsmFarm::inst} ...................................................*/
+QHsm * QHsmFarm_inst(QHsmFarm * const me,
+    uint_fast16_t const i)
+{
+    /*! @pre the index must be in range */
+    Q_REQUIRE_ID(600, i < me->n);
+
+    return QHSM_FARM_INST_(i);
+}
+
+/*${QEP::QHsmFarm::state} ..................................................*/
+QStateHandler QHsmFarm_state(QHsmFarm * const me,
+    uint_fast16_t const i)
+{
+    /*! @pre the index must be in range */
+    Q_REQUIRE_ID(700, i < me->n);
+
+    return QHSM_FARM_INST_(i)->state.fun;
+}
+
+/*${QEP::QHsmFarm::group_} .................................................*/
+uint_fast8_t QHsmFarm_group_(QHsmFarm * const me,
+    QStateHandler const state)
+{
+    uint_fast8_t gFree = QHSM_FARM_OTHER_; /* the first free group */
+    uint_fast8_t g = 0U;
+    while ((g < QHSM_FARM_OTHER_) && (me->grpState[g] != state)) {
+        if ((gFree == QHSM_FARM_OTHER_)
+            && (me->grpState[g] == Q_STATE_CAST(0)))
+        {
+            gFree = g;
+        }
+        ++g;
+    }
+    if (g == QHSM_FARM_OTHER_) { /* not found? */
+        g = gFree; /* the free group or the group of all the other states */
+        if (g < QHSM_FARM_OTHER_) { /* free group available? */
+            me->grpState[g] = state;
+            ++me->nGrp;
+        }
+    }
+    return g;
+}
+
+/*${QEP::QHsmFarm::regroup_} ...............................................*/
+void QHsmFarm_regroup_(QHsmFarm * const me,
+    uint_fast16_t const i)
+{
+    /* leave the old group and reclaim it when it becomes empty */
+    uint_fast8_t g = me->grp[i];
+    --me->grpCnt[g];
+    if ((g < QHSM_FARM_OTHER_) && (me->grpCnt[g] == 0U)) {
+        me->grpState[g] = Q_STATE_CAST(0);
+        --me->nGrp;
+    }
+
+    /* join the group of the current state */
+    g = QHsmFarm_group_(me, QHSM_FARM_INST_(i)->state.fun);
+    me->grp[i] = (uint8_t)g;
+    ++me->grpCnt[g];
+}
+
+/*${QEP::QHsmFarm::dispatchGroups_} ........................................*/
+void QHsmFarm_dispatchGroups_(QHsmFarm * const me,
+    QEvt const * const e,
+    uint16_t const * const set,
+    uint_fast16_t const nSet,
+    uint_fast8_t const qs_id)
+{
+    uint_fast16_t pos[QHSM_FARM_STATES]; /* instances in/start of groups */
+
+    for (uint_fast16_t g = 0U; g < QHSM_FARM_STATES; ++g) {
+        pos[g] = 0U;
+    }
+
+    /* 1st pass over the dense groups: count the instances in the groups */
+    for (uint_fast16_t k = 0U; k < nSet; ++k) {
+        uint_fast16_t const i = (set != (uint16_t const *)0) ? set[k] : k;
+
+        /* the index must be in range */
+        Q_ASSERT_ID(510, i < me->n);
+
+        ++pos[me->grp[i]];
+    }
+
+    /* start of every group in the order of the dispatched instances */
+    uint_fast16_t start = 0U;
+    for (uint_fast16_t g = 0U; g < QHSM_FARM_STATES; ++g) {
+        uint_fast16_t const cnt = pos[g];
+        pos[g] = start;
+        start += cnt;
+    }
+
+    /* 2nd pass: sort the instances into the groups (stable) */
+    for (uint_fast16_t k = 0U; k < nSet; ++k) {
+        uint_fast16_t const i = (set != (uint16_t const *)0) ? set[k] : k;
+        uint_fast8_t const g = me->grp[i];
+        me->order[pos[g]] = (uint16_t)i;
+        ++pos[g];
+    }
+
+    /* dispatch the event group by group (pos[g] is the end of group g) */
+    uint_fast16_t k = 0U;
+    for (uint_fast16_t g = 0U; g < QHSM_FARM_STATES; ++g) {
+    #ifdef QHSM_SIG_MAP
+        /* no state handles the signal in the state of the whole group? */
+        if ((k < pos[g]) && (g < QHSM_FARM_OTHER_)
+            && (me->smap != (QHsmSigMap const *)0)
+            && (QHsmSigMap_route_(me->smap, me->grpState[g], e->sig)
+                == Q_STATE_CAST(&QHsm_top)))
+        {
+        #ifdef Q_SPY
+            /* trace the skipped instances the same way as QHsm_dispatch_()
+            * traces an ignored event
+            */
+            if (QS_LOC_CHECK_(qs_id)
+                && (QS_GLB_CHECK_(QS_QEP_DISPATCH)
+                    || QS_GLB_CHECK_(QS_QEP_IGNORED)))
+            {
+                QS_CRIT_STAT_
+                for (; k < pos[g]; ++k) {
+                    QHsm const * const inst = QHSM_FARM_INST_(me->order[k]);
+
+                    QS_BEGIN_PRE_(QS_QEP_DISPATCH, qs_id)
+                        QS_TIME_PRE_();      /* time stamp */
+                        QS_SIG_PRE_(e->sig); /* the signal of the event */
+                        QS_OBJ_PRE_(inst);   /* this state machine object */
+                        QS_FUN_PRE_(inst->state.fun); /* the current state */
+                    QS_END_PRE_()
+
+                    QS_BEGIN_PRE_(QS_QEP_IGNORED, qs_id)
+                        QS_TIME_PRE_();      /* time stamp */
+                        QS_SIG_PRE_(e->sig); /* the signal of the event */
+                        QS_OBJ_PRE_(inst);   /* this state machine object */
+                        QS_FUN_PRE_(inst->state.fun); /* the current state */
+                    QS_END_PRE_()
+                }
+            }
+        #endif /* Q_SPY */
+            k = pos[g]; /* skip the group (all its instances ignore e) */
+        }
+    #endif /* def QHSM_SIG_MAP */
+        for (; k < pos[g]; ++k) {
+            uint_fast16_t const i = me->order[k];
+            QHsm * const inst = QHSM_FARM_INST_(i);
+            QStateHandler const s = inst->state.fun;
+            QHsm_dispatch_(inst, e, qs_id);
+            if ((inst->state.fun != s) /* state changed? */
+                || ((g == QHSM_FARM_OTHER_)
+                    && (me->nGrp < QHSM_FARM_OTHER_)))
+            {
+                QHsmFarm_regroup_(me, i);
+            }
+        }
+    }
+}
+/*$enddef${QEP::QHsmFarm} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
@@ -72,6 +72,24 @@ enum {
     QEP_EMPTY_SIG_ = 0, /*!< reserved empty signal for internal use only */
 };
 
+#ifdef QHSM_TRAN_CACHE
+/*! maximum number of the entries probed in the ::QHsmTranCache */
+enum { QHSM_TRAN_PROBES_ = 4 };
+#endif
+
+#ifdef QHSM_SIG_MAP
+/*! hash of a state handler in the ::QHsmSigMap */
+#define QHSM_SIG_MAP_HASH_(state_) \
+    ((uint_fast16_t)(((uint32_t)(uintptr_t)(state_) * 0x9E3779B1U) >> 16U))
+#endif
+
+#ifdef QHSM_PROFILER
+/*! hash of a (state, signal) pair in the ::QHsmProf */
+#define QHSM_PROF_HASH_(state_, sig_) \
+    ((uint_fast16_t)((((uint32_t)(uintptr_t)(state_) \
+        ^ ((uint32_t)(sig_) << 8U)) * 0x9E3779B1U) >> 16U))
+#endif
+
 /*! Immutable events corresponding to the reserved signals.
 *
 * @details
@@ -80,19 +98,41 @@ enum {
 * actions, exit actions, and initial transitions.
 */
 static QEvt const QEP_reservedEvt_[] = {
-    { (QSignal)QEP_EMPTY_SIG_, 0U, 0U },
-    { (QSignal)Q_ENTRY_SIG,    0U, 0U },
-    { (QSignal)Q_EXIT_SIG,     0U, 0U },
-    { (QSignal)Q_INIT_SIG,     0U, 0U }
+    QEVT_INITIALIZER(QEP_EMPTY_SIG_),
+    QEVT_INITIALIZER(Q_ENTRY_SIG),
+    QEVT_INITIALIZER(Q_EXIT_SIG),
+    QEVT_INITIALIZER(Q_INIT_SIG)
 };
 
+#ifdef QHSM_PROFILER
+/*! helper function to trigger internal event in an HSM, which also counts
+* the executed exit, entry and initial actions in the ::QHsmProf
+*/
+static QState QEP_trig_(QHsm * const me,
+                        QStateHandler const state,
+                        enum_t const sig)
+{
+    QState const r = (*state)(me, &QEP_reservedEvt_[sig]);
+    if ((sig != (enum_t)QEP_EMPTY_SIG_)
+        && ((r == Q_RET_HANDLED) || (r == Q_RET_TRAN))
+        && (me->prof != (QHsmProf *)0))
+    {
+        QHsmProf_action_(me->prof, state, (QSignal)sig);
+    }
+    return r;
+}
+
+/*! helper macro to trigger internal event in an HSM */
+#define QEP_TRIG_(state_, sig_) (QEP_trig_(me, (state_), (sig_)))
+#else
 /*! helper macro to trigger internal event in an HSM */
 #define QEP_TRIG_(state_, sig_) \
     ((*(state_))(me, &QEP_reservedEvt_[sig_]))
+#endif /* def QHSM_PROFILER */
 
 #ifdef Q_SPY
     #define QEP_EXIT_(state_, qs_id_) do {                  \
-        if ((*(state_))(me, &QEP_reservedEvt_[Q_EXIT_SIG])  \
+        if (QEP_TRIG_((state_), Q_EXIT_SIG)                 \
              == Q_RET_HANDLED) {                            \
             QS_BEGIN_PRE_(QS_QEP_STATE_EXIT, (qs_id_))      \
                 QS_OBJ_PRE_(me);                            \
@@ -102,7 +142,7 @@ static QEvt const QEP_reservedEvt_[] = {
     } while (false)
 
     #define QEP_ENTER_(state_, qs_id_) do {                 \
-        if ((*(state_))(me, &QEP_reservedEvt_[Q_ENTRY_SIG]) \
+        if (QEP_TRIG_((state_), Q_ENTRY_SIG)                \
              == Q_RET_HANDLED) {                            \
             QS_BEGIN_PRE_(QS_QEP_STATE_ENTRY, (qs_id_))     \
                 QS_OBJ_PRE_(me);                            \
@@ -113,10 +153,10 @@ static QEvt const QEP_reservedEvt_[] = {
 
 #else
     #define QEP_EXIT_(state_, dummy_) \
-        ((void)(*(state_))(me, &QEP_reservedEvt_[Q_EXIT_SIG]))
+        ((void)QEP_TRIG_((state_), Q_EXIT_SIG))
 
     #define QEP_ENTER_(state_, dummy_) \
-        ((void)(*(state_))(me, &QEP_reservedEvt_[Q_ENTRY_SIG]))
+        ((void)QEP_TRIG_((state_), Q_ENTRY_SIG))
 
 #endif /* Q_SPY */
 
@@ -188,6 +228,33 @@ QStateHandler QHsm_childState(QHsm * const me,
     return child; /* return the child */
 }
 
+/*${QEP::QHsm::setTranCache} ...............................................*/
+#ifdef QHSM_TRAN_CACHE
+void QHsm_setTranCache(QHsm * const me,
+    QHsmTranCache * const cache)
+{
+    me->tcache = cache;
+}
+#endif /* def QHSM_TRAN_CACHE */
+
+/*${QEP::QHsm::setSigMap} ..................................................*/
+#ifdef QHSM_SIG_MAP
+void QHsm_setSigMap(QHsm * const me,
+    QHsmSigMap const * const map)
+{
+    me->smap = map;
+}
+#endif /* def QHSM_SIG_MAP */
+
+/*${QEP::QHsm::setProf} ....................................................*/
+#ifdef QHSM_PROFILER
+void QHsm_setProf(QHsm * const me,
+    QHsmProf * const prof)
+{
+    me->prof = prof;
+}
+#endif /* def QHSM_PROFILER */
+
 /*${QEP::QHsm::ctor} .......................................................*/
 void QHsm_ctor(QHsm * const me,
     QStateHandler initial)
@@ -202,6 +269,15 @@ void QHsm_ctor(QHsm * const me,
     me->vptr      = &vtable;
     me->state.fun = Q_STATE_CAST(&QHsm_top);
     me->temp.fun  = initial;
+    #ifdef QHSM_TRAN_CACHE
+    me->tcache    = (QHsmTranCache *)0; /* no transition-path cache */
+    #endif
+    #ifdef QHSM_SIG_MAP
+    me->smap      = (QHsmSigMap const *)0; /* no signal routing map */
+    #endif
+    #ifdef QHSM_PROFILER
+    me->prof      = (QHsmProf *)0; /* no dispatch profiler */
+    #endif
 }
 
 /*${QEP::QHsm::top} ........................................................*/
@@ -308,6 +384,12 @@ void QHsm_dispatch_(QHsm * const me,
     Q_REQUIRE_ID(400, (t != Q_STATE_CAST(0))
                        && (t == me->temp.fun));
 
+    #ifdef QHSM_PROFILER
+    QHsmProfCtr const t0 = (me->prof != (QHsmProf *)0)
+                           ? QHsmProf_onGetTime()
+                           : 0U;
+    #endif /* def QHSM_PROFILER */
+
     QS_BEGIN_PRE_(QS_QEP_DISPATCH, qs_id)
         QS_TIME_PRE_();         /* time stamp */
         QS_SIG_PRE_(e->sig);    /* the signal of the event */
@@ -320,6 +402,12 @@ void QHsm_dispatch_(QHsm * const me,
     /* process the event hierarchically... */
     do {
         s = me->temp.fun;
+    #ifdef QHSM_SIG_MAP
+        if (me->smap != (QHsmSigMap const *)0) {
+            /* skip the states that do not handle the signal */
+            s = QHsmSigMap_route_(me->smap, s, e->sig);
+        }
+    #endif /* def QHSM_SIG_MAP */
         r = (*s)(me, e); /* invoke state handler s */
 
         if (r == Q_RET_UNHANDLED) { /* unhandled due to a guard? */
@@ -343,21 +431,32 @@ void QHsm_dispatch_(QHsm * const me,
         path[1] = t;
         path[2] = s;
 
-        /* exit current state to transition source s... */
-        /*! @tr{RQP120C} */
-        for (; t != s; t = me->temp.fun) {
-            if (QEP_TRIG_(t, Q_EXIT_SIG) == Q_RET_HANDLED) {
-                QS_BEGIN_PRE_(QS_QEP_STATE_EXIT, qs_id)
-                    QS_OBJ_PRE_(me);  /* this state machine object */
-                    QS_FUN_PRE_(t);   /* the exited state */
-                QS_END_PRE_()
-
-                /* find superstate of t */
-                (void)QEP_TRIG_(t, QEP_EMPTY_SIG_);
-            }
+        int_fast8_t ip;
+    #ifdef QHSM_TRAN_CACHE
+        if (me->tcache != (QHsmTranCache *)0) {
+            /* exit to the LCA and get the entry path from the cache */
+            ip = QHsm_tranPath_(me, path, qs_id);
+            t = s;
         }
+        else
+    #endif /* def QHSM_TRAN_CACHE */
+        {
+            /* exit current state to transition source s... */
+            /*! @tr{RQP120C} */
+            for (; t != s; t = me->temp.fun) {
+                if (QEP_TRIG_(t, Q_EXIT_SIG) == Q_RET_HANDLED) {
+                    QS_BEGIN_PRE_(QS_QEP_STATE_EXIT, qs_id)
+                        QS_OBJ_PRE_(me);  /* this state machine object */
+                        QS_FUN_PRE_(t);   /* the exited state */
+                    QS_END_PRE_()
+
+                    /* find superstate of t */
+                    (void)QEP_TRIG_(t, QEP_EMPTY_SIG_);
+                }
+            }
 
-        int_fast8_t ip = QHsm_tran_(me, path, qs_id); /* the HSM transition */
+            ip = QHsm_tran_(me, path, qs_id); /* the HSM transition */
+        }
 
     #ifdef Q_SPY
         if (r == Q_RET_TRAN_HIST) {
@@ -391,14 +490,25 @@ void QHsm_dispatch_(QHsm * const me,
             ip = 0;
             path[0] = me->temp.fun;
 
-            /* find superstate */
-            (void)QEP_TRIG_(me->temp.fun, QEP_EMPTY_SIG_);
-
-            while (me->temp.fun != t) {
-                ++ip;
-                path[ip] = me->temp.fun;
+        #ifdef QHSM_TRAN_CACHE
+            if (me->tcache != (QHsmTranCache *)0) {
+                /* get the entry path from the cache (nothing to exit) */
+                path[1] = Q_STATE_CAST(0);
+                path[2] = t;
+                ip = QHsm_tranPath_(me, path, qs_id);
+            }
+            else
+        #endif /* def QHSM_TRAN_CACHE */
+            {
                 /* find superstate */
                 (void)QEP_TRIG_(me->temp.fun, QEP_EMPTY_SIG_);
+
+                while (me->temp.fun != t) {
+                    ++ip;
+                    path[ip] = me->temp.fun;
+                    /* find superstate */
+                    (void)QEP_TRIG_(me->temp.fun, QEP_EMPTY_SIG_);
+                }
             }
             me->temp.fun = path[0];
 
@@ -446,6 +556,13 @@ void QHsm_dispatch_(QHsm * const me,
     }
     #endif /* Q_SPY */
 
+    #ifdef QHSM_PROFILER
+    if (me->prof != (QHsmProf *)0) { /* profiling this state machine? */
+        QHsmProf_dispatch_(me->prof, me->state.fun, e->sig,
+                           (QHsmProfCtr)(QHsmProf_onGetTime() - t0));
+    }
+    #endif /* def QHSM_PROFILER */
+
     me->state.fun = t; /* change the current active state */
     me->temp.fun  = t; /* mark the configuration as stable */
 }
@@ -593,4 +710,455 @@ int_fast8_t QHsm_tran_(QHsm * const me,
     }
     return ip;
 }
+
+/*${QEP::QHsm::tranPath_} ..................................................*/
+#ifdef QHSM_TRAN_CACHE
+int_fast8_t QHsm_tranPath_(QHsm * const me,
+    QStateHandler path[QHSM_MAX_NEST_DEPTH_],
+    uint_fast8_t const qs_id)
+{
+    Q_UNUSED_PAR(qs_id); /* unused when Q_SPY undefined */
+
+    QHsmTranCache * const cache = me->tcache;
+    QStateHandler const cur = path[1];
+    QStateHandler const s   = path[2];
+    QStateHandler t = path[0];
+    QS_CRIT_STAT_
+
+    /* hash the (current, source, target) key of the transition */
+    uint32_t h = ((uint32_t)(uintptr_t)cur * 0x9E3779B1U)
+                 ^ ((uint32_t)(uintptr_t)s * 0x85EBCA6BU)
+                 ^ ((uint32_t)(uintptr_t)t * 0xC2B2AE35U);
+    h ^= (h >> 15U); /* mix the high bits into the index bits */
+    uint_fast16_t const idx = (uint_fast16_t)h;
+
+    /* linear probing for the cached path or for an unused entry... */
+    QHsmTranPath *tp = &cache->sto[idx & cache->mask];
+    uint_fast16_t n = 0U;
+    while ((tp->tgt != Q_STATE_CAST(0))
+           && ((tp->tgt != t) || (tp->src != s) || (tp->cur != cur)))
+    {
+        ++n;
+        if (n < QHSM_TRAN_PROBES_) { /* more entries to probe? */
+            tp = &cache->sto[(idx + n) & cache->mask];
+        }
+        else { /* evict the path from the first probed entry */
+            tp = &cache->sto[idx & cache->mask];
+            tp->tgt = Q_STATE_CAST(0);
+        }
+    }
+
+    /* cache miss? */
+    if (tp->tgt == Q_STATE_CAST(0)) {
+        uint_fast8_t nx = 0U; /* number of the states to exit */
+        uint_fast8_t ne = 0U; /* number of the states to enter */
+        bool fit = true;      /* does the path fit into the entry? */
+
+        /* states from the current state up to the source s to exit... */
+        if (cur != Q_STATE_CAST(0)) {
+            t = cur;
+            while (fit && (t != s)) {
+                if (nx < (uint_fast8_t)QHSM_MAX_NEST_DEPTH_) {
+                    tp->exit[nx] = t;
+                    ++nx;
+                    (void)QEP_TRIG_(t, QEP_EMPTY_SIG_); /* find superstate */
+                    t = me->temp.fun;
+                }
+                else {
+                    fit = false;
+                }
+            }
+        }
+
+        /* (a) transition to self? */
+        if (s == path[0]) {
+            if (nx < (uint_fast8_t)QHSM_MAX_NEST_DEPTH_) {
+                tp->exit[nx] = s; /* exit the source */
+                ++nx;
+            }
+            else {
+                fit = false;
+            }
+            tp->entry[0] = s; /* enter the target */
+            ne = 1U;
+        }
+        else if (fit) {
+            /* the depth of the target minus the depth of the source */
+            int_fast16_t d = 0;
+            for (t = s; QEP_TRIG_(t, QEP_EMPTY_SIG_) == Q_RET_SUPER;
+                 t = me->temp.fun)
+            {
+                --d;
+            }
+            for (t = path[0]; QEP_TRIG_(t, QEP_EMPTY_SIG_) == Q_RET_SUPER;
+                 t = me->temp.fun)
+            {
+                ++d;
+            }
+
+            /* walk up from the source (exits) and from the target
+            * (entries in reverse) to their least common ancestor (LCA).
+            * Only the states below the LCA are stored, like in QHsm_tran_
+            */
+            QStateHandler x = s;       /* the source or its superstate */
+            QStateHandler y = path[0]; /* the target or its superstate */
+            while (fit && (x != y)) {
+                if (d >= 0) { /* the target side is not higher? */
+                    if (ne < (uint_fast8_t)QHSM_MAX_NEST_DEPTH_) {
+                        tp->entry[ne] = y;
+                        ++ne;
+                        (void)QEP_TRIG_(y, QEP_EMPTY_SIG_);
+                        y = me->temp.fun;
+                        --d;
+                    }
+                    else {
+                        fit = false;
+                    }
+                }
+                if (fit && (d < 0)) { /* the source side is lower? */
+                    if (nx < (uint_fast8_t)QHSM_MAX_NEST_DEPTH_) {
+                        tp->exit[nx] = x;
+                        ++nx;
+                        (void)QEP_TRIG_(x, QEP_EMPTY_SIG_);
+                        x = me->temp.fun;
+                        ++d;
+                    }
+                    else {
+                        fit = false;
+                    }
+                }
+            }
+        }
+
+        /* the path does not fit into the entry? */
+        if (!fit) {
+            /* entry path of a nested initial transition must fit */
+            Q_ASSERT_ID(720, cur != Q_STATE_CAST(0));
+
+            /* take this transition without the cache */
+            for (t = cur; t != s; t = me->temp.fun) {
+                QEP_EXIT_(t, qs_id);
+                (void)QEP_TRIG_(t, QEP_EMPTY_SIG_); /* find superstate */
+            }
+            return QHsm_tran_(me, path, qs_id);
+        }
+
+        tp->cur    = cur;
+        tp->src    = s;
+        tp->tgt    = path[0];
+        tp->nExit  = (uint8_t)nx;
+        tp->nEntry = (uint8_t)ne;
+        ++cache->nMiss;
+    }
+
+    /* replay the exits from the current state up to the LCA... */
+    for (uint_fast8_t i = 0U; i < (uint_fast8_t)tp->nExit; ++i) {
+        t = tp->exit[i];
+        QEP_EXIT_(t, qs_id);
+    }
+
+    /* ...and copy the entry path */
+    int_fast8_t ip = (int_fast8_t)tp->nEntry - 1;
+    for (int_fast8_t i = ip; i > 0; --i) {
+        path[i] = tp->entry[i];
+    }
+    return ip;
+}
+#endif /* def QHSM_TRAN_CACHE */
 /*$enddef${QEP::QHsm} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+/*$define${QEP::QHsmTranCache} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
+
+/*${QEP::QHsmTranCache} ....................................................*/
+
+/*${QEP::QHsmTranCache::init} ..............................................*/
+#ifdef QHSM_TRAN_CACHE
+void QHsmTranCache_init(QHsmTranCache * const me,
+    QHsmTranPath * const sto,
+    uint_fast32_t const size)
+{
+    /*! @pre the storage must be provided and its size must be
+    * a power of 2 not exceeding 0x10000
+    */
+    Q_REQUIRE_ID(900, (sto != (QHsmTranPath *)0)
+                      && (size != 0U) && (size <= 0x10000U)
+                      && ((size & (size - 1U)) == 0U));
+
+    me->sto   = sto;
+    me->mask  = (uint16_t)(size - 1U);
+    me->nMiss = 0U;
+    for (uint_fast32_t i = 0U; i < size; ++i) {
+        sto[i].tgt = Q_STATE_CAST(0); /* mark the entry as unused */
+    }
+}
+#endif /* def QHSM_TRAN_CACHE */
+/*$enddef${QEP::QHsmTranCache} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+/*$define${QEP::QHsmSigMap} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
+
+/*${QEP::QHsmSigMap} .......................................................*/
+
+/*${QEP::QHsmSigMap::init} .................................................*/
+#ifdef QHSM_SIG_MAP
+void QHsmSigMap_init(QHsmSigMap * const me,
+    QHsmStateSigs const * const states,
+    uint_fast8_t const nStates,
+    uint8_t * const route,
+    uint_fast16_t const nSigs)
+{
+    /*! @pre the states and the route table must be provided and
+    * the hash table must be at most half full
+    */
+    Q_REQUIRE_ID(950, (states != (QHsmStateSigs const *)0)
+                      && (nStates != 0U)
+                      && (nStates <= (QHSM_SIG_MAP_HASH / 2U))
+                      && (route != (uint8_t *)0)
+                      && (nSigs != 0U) && (nSigs <= 0xFFFFU));
+
+    me->states = (QHsmStateSigs const *)0; /* not usable for routing yet */
+    me->route  = route;
+    me->nSigs  = (uint16_t)nSigs;
+
+    /* hash the registered state handlers... */
+    for (uint_fast16_t i = 0U; i < QHSM_SIG_MAP_HASH; ++i) {
+        me->hash[i] = 0U; /* mark the entry as unused */
+    }
+    for (uint_fast8_t n = 0U; n < nStates; ++n) {
+        uint_fast16_t i = QHSM_SIG_MAP_HASH_(states[n].state);
+        while (me->hash[i & (QHSM_SIG_MAP_HASH - 1U)] != 0U) {
+            /* every state must be registered only once */
+            Q_ASSERT_ID(960, states[me->hash[i & (QHSM_SIG_MAP_HASH - 1U)]
+                                    - 1U].state != states[n].state);
+            ++i;
+        }
+        me->hash[i & (QHSM_SIG_MAP_HASH - 1U)] = (uint8_t)(n + 1U);
+    }
+
+    /* state machine object for the superstate queries */
+    QHsm sm;
+    sm.temp.fun = Q_STATE_CAST(0);
+
+    /* route every signal in every state to the innermost handling state */
+    for (uint_fast8_t n = 0U; n < nStates; ++n) {
+        uint8_t * const row = &route[(uint_fast32_t)n * nSigs];
+        for (uint_fast16_t i = 0U; i < nSigs; ++i) {
+            row[i] = 0xFFU; /* handled by no state (QHsm_top) */
+        }
+
+        uint_fast8_t k = n; /* the state n and then its superstates */
+        int_fast8_t lim = QHSM_MAX_NEST_DEPTH_;
+        for (;;) {
+            QSignal const *sig = states[k].sigs;
+            if (sig == (QSignal const *)0) { /* might handle any signal? */
+                for (uint_fast16_t i = 0U; i < nSigs; ++i) {
+                    if (row[i] == 0xFFU) {
+                        row[i] = (uint8_t)k;
+                    }
+                }
+            }
+            else {
+                for (; *sig != 0U; ++sig) {
+                    uint_fast16_t const i = (uint_fast16_t)*sig
+                                            - (uint_fast16_t)Q_USER_SIG;
+                    if ((i < nSigs) && (row[i] == 0xFFU)) {
+                        row[i] = (uint8_t)k;
+                    }
+                }
+            }
+
+            /* find the superstate of the state k */
+            (void)(*states[k].state)(&sm, &QEP_reservedEvt_[QEP_EMPTY_SIG_]);
+            if (sm.temp.fun == Q_STATE_CAST(&QHsm_top)) {
+                break;
+            }
+
+            /* the state nesting must not exceed the maximum depth */
+            --lim;
+            Q_ASSERT_ID(970, lim > 0);
+
+            /* look up the superstate among the registered states */
+            uint_fast16_t h = QHSM_SIG_MAP_HASH_(sm.temp.fun);
+            do {
+                k = me->hash[h & (QHSM_SIG_MAP_HASH - 1U)];
+
+                /* every superstate must be registered in the map */
+                Q_ASSERT_ID(980, k != 0U);
+                --k;
+                ++h;
+            } while (states[k].state != sm.temp.fun);
+        }
+    }
+
+    me->states = states; /* the map is ready for routing */
+}
+#endif /* def QHSM_SIG_MAP */
+
+/*${QEP::QHsmSigMap::route_} ...............................................*/
+#ifdef QHSM_SIG_MAP
+QStateHandler QHsmSigMap_route_(QHsmSigMap const * const me,
+    QStateHandler const s,
+    QSignal const sig)
+{
+    /* signals below Q_USER_SIG wrap around to large indices */
+    uint_fast16_t const i = (uint_fast16_t)sig - (uint_fast16_t)Q_USER_SIG;
+    if (i < (uint_fast16_t)me->nSigs) { /* signal in the route table? */
+        uint_fast16_t h = QHSM_SIG_MAP_HASH_(s);
+        uint_fast8_t n = me->hash[h & (QHSM_SIG_MAP_HASH - 1U)];
+        while (n != 0U) { /* linear probing for the state s... */
+            --n;
+            if (me->states[n].state == s) { /* state s found? */
+                n = me->route[((uint_fast32_t)n * me->nSigs) + i];
+                return (n != 0xFFU)
+                       ? me->states[n].state
+                       : Q_STATE_CAST(&QHsm_top);
+            }
+            ++h;
+            n = me->hash[h & (QHSM_SIG_MAP_HASH - 1U)];
+        }
+    }
+    return s; /* not routed */
+}
+#endif /* def QHSM_SIG_MAP */
+/*$enddef${QEP::QHsmSigMap} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+/*$define${QEP::QHsmProf} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
+
+/*${QEP::QHsmProf} .........................................................*/
+
+/*${QEP::QHsmProf::init} ...................................................*/
+#ifdef QHSM_PROFILER
+void QHsmProf_init(QHsmProf * const me,
+    QHsmProfEntry * const sto,
+    uint_fast32_t const size)
+{
+    /*! @pre the storage must be provided and its size must be
+    * a power of 2 between 2 and 0x10000
+    */
+    Q_REQUIRE_ID(1000, (sto != (QHsmProfEntry *)0)
+                       && (size >= 2U) && (size <= 0x10000U)
+                       && ((size & (size - 1U)) == 0U));
+
+    me->sto  = sto;
+    me->mask = (uint16_t)(size - 1U);
+    me->used = 0U;
+    me->lost = 0U;
+    for (uint_fast32_t i = 0U; i < size; ++i) {
+        QHsmProfEntry * const p = &sto[i];
+        p->state = Q_STATE_CAST(0); /* mark the entry as unused */
+        p->sig   = 0U;
+        p->count = 0U;
+        p->total = 0U;
+        p->min   = 0U;
+        p->max   = 0U;
+        for (uint_fast8_t b = 0U; b < QHSM_PROF_BUCKETS; ++b) {
+            p->hist[b] = 0U;
+        }
+    }
+}
+#endif /* def QHSM_PROFILER */
+
+/*${QEP::QHsmProf::export} .................................................*/
+#ifdef QHSM_PROFILER
+uint_fast16_t QHsmProf_export(QHsmProf const * const me,
+    QHsmProfEntry * const dst,
+    uint_fast16_t const max)
+{
+    /*! @pre the summary table must be provided */
+    Q_REQUIRE_ID(1100, (dst != (QHsmProfEntry *)0) || (max == 0U));
+
+    uint_fast16_t n = 0U;
+    for (uint_fast32_t i = 0U; i <= me->mask; ++i) {
+        QHsmProfEntry const * const p = &me->sto[i];
+        if (p->state != Q_STATE_CAST(0)) { /* entry in use? */
+            /* insertion sort by the total time, then by the count... */
+            uint_fast16_t k = n;
+            while ((k > 0U)
+                   && ((dst[k - 1U].total < p->total)
+                       || ((dst[k - 1U].total == p->total)
+                           && (dst[k - 1U].count < p->count))))
+            {
+                if (k < max) {
+                    dst[k] = dst[k - 1U];
+                }
+                --k;
+            }
+            if (k < max) {
+                dst[k] = *p;
+            }
+            if (n < max) {
+                ++n;
+            }
+        }
+    }
+    return n;
+}
+#endif /* def QHSM_PROFILER */
+
+/*${QEP::QHsmProf::find_} ..................................................*/
+#ifdef QHSM_PROFILER
+QHsmProfEntry * QHsmProf_find_(QHsmProf * const me,
+    QStateHandler const state,
+    QSignal const sig)
+{
+    uint_fast16_t h = QHSM_PROF_HASH_(state, sig);
+    for (;;) { /* linear probing for the (state, signal) pair... */
+        QHsmProfEntry * const p = &me->sto[h & me->mask];
+        if (p->state == Q_STATE_CAST(0)) { /* unused entry (not found)? */
+            if (me->used == me->mask) { /* keep one entry unused */
+                ++me->lost;
+                return (QHsmProfEntry *)0;
+            }
+            p->state = state;
+            p->sig   = sig;
+            ++me->used;
+            return p;
+        }
+        if ((p->state == state) && (p->sig == sig)) { /* found? */
+            return p;
+        }
+        ++h;
+    }
+}
+#endif /* def QHSM_PROFILER */
+
+/*${QEP::QHsmProf::dispatch_} ..............................................*/
+#ifdef QHSM_PROFILER
+void QHsmProf_dispatch_(QHsmProf * const me,
+    QStateHandler const state,
+    QSignal const sig,
+    QHsmProfCtr const dt)
+{
+    QHsmProfEntry * const p = QHsmProf_find_(me, state, sig);
+    if (p != (QHsmProfEntry *)0) {
+        ++p->count;
+        p->total += dt;
+        if ((p->count == 1U) || (dt < p->min)) {
+            p->min = dt;
+        }
+        if (dt > p->max) {
+            p->max = dt;
+        }
+
+        /* the log2 bucket of the dispatch time */
+        uint_fast8_t b = 0U;
+        for (QHsmProfCtr x = dt;
+             (x != 0U) && (b < (uint_fast8_t)(QHSM_PROF_BUCKETS - 1U));
+             x >>= 1U)
+        {
+            ++b;
+        }
+        ++p->hist[b];
+    }
+}
+#endif /* def QHSM_PROFILER */
+
+/*${QEP::QHsmProf::action_} ................................................*/
+#ifdef QHSM_PROFILER
+void QHsmProf_action_(QHsmProf * const me,
+    QStateHandler const state,
+    QSignal const sig)
+{
+    QHsmProfEntry * const p = QHsmProf_find_(me, state, sig);
+    if (p != (QHsmProfEntry *)0) {
+        ++p->count;
+    }
+}
+#endif /* def QHSM_PROFILER */
+/*$enddef${QEP::QHsmProf} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
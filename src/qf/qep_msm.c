@@ -146,6 +146,9 @@ void QMsm_ctor(QMsm * const me,
     me->super.vptr = &vtable;
     me->super.state.obj = &l_msm_top_s; /* the current state (top) */
     me->super.temp.fun  = initial;      /* the initial transition handler */
+    #ifdef QHSM_PROFILER
+    me->super.prof      = (QHsmProf *)0; /* no dispatch profiler */
+    #endif
 }
 
 /*${QEP::QMsm::init_} ......................................................*/
@@ -211,6 +214,13 @@ void QMsm_dispatch_(
     /*! @pre current state must be initialized */
     Q_REQUIRE_ID(300, s != (QMState *)0);
 
+    #ifdef QHSM_PROFILER
+    QStateHandler const ps = s->stateHandler; /* for the profiler */
+    QHsmProfCtr const t0 = (me->prof != (QHsmProf *)0)
+                           ? QHsmProf_onGetTime()
+                           : 0U;
+    #endif /* def QHSM_PROFILER */
+
     QS_CRIT_STAT_
     QS_BEGIN_PRE_(QS_QEP_DISPATCH, qs_id)
         QS_TIME_PRE_();               /* time stamp */
@@ -294,9 +304,9 @@ void QMsm_dispatch_(
                     /* take the tran-to-XP segment inside submachine */
                     (void)QMsm_execTatbl_(me, tatbl, qs_id);
                     s = me->state.obj;
-    #ifdef Q_SPY
+    #ifdef QM_STATE_REC_
                     me->temp.tatbl = tmp.tatbl; /* restore me->temp */
-    #endif /* Q_SPY */
+    #endif /* QM_STATE_REC_ */
                 }
                 else if (r == Q_RET_TRAN_HIST) { /* XP -> HIST ? */
                     tmp.obj = me->state.obj; /* save the history */
@@ -305,9 +315,9 @@ void QMsm_dispatch_(
                     QMsm_exitToTranSource_(me, me->state.obj, t, qs_id);
                     /* take the tran-to-XP segment inside submachine */
                     (void)QMsm_execTatbl_(me, tatbl, qs_id);
-    #ifdef Q_SPY
+    #ifdef QM_STATE_REC_
                     me->temp.obj = s; /* restore me->temp */
-    #endif /* Q_SPY */
+    #endif /* QM_STATE_REC_ */
                     s = me->state.obj;
                     me->state.obj = tmp.obj; /* restore the history */
                 }
@@ -363,6 +373,13 @@ void QMsm_dispatch_(
     else {
         /* empty */
     }
+
+    #ifdef QHSM_PROFILER
+    if (me->prof != (QHsmProf *)0) { /* profiling this state machine? */
+        QHsmProf_dispatch_(me->prof, ps, e->sig,
+                           (QHsmProfCtr)(QHsmProf_onGetTime() - t0));
+    }
+    #endif /* def QHSM_PROFILER */
 }
 
 /*${QEP::QMsm::getStateHandler_} ...........................................*/
@@ -391,6 +408,25 @@ QState QMsm_execTatbl_(
          ++a)
     {
         r = (*(*a))(me); /* call the action through the 'a' pointer */
+    #ifdef QHSM_PROFILER
+        if (me->prof != (QHsmProf *)0) { /* count the actions? */
+            if (r == Q_RET_ENTRY) {
+                QHsmProf_action_(me->prof, me->temp.obj->stateHandler,
+                                 (QSignal)Q_ENTRY_SIG);
+            }
+            else if (r == Q_RET_EXIT) {
+                QHsmProf_action_(me->prof, me->temp.obj->stateHandler,
+                                 (QSignal)Q_EXIT_SIG);
+            }
+            else if (r == Q_RET_TRAN_INIT) {
+                QHsmProf_action_(me->prof, tatbl->target->stateHandler,
+                                 (QSignal)Q_INIT_SIG);
+            }
+            else {
+                /* not counted */
+            }
+        }
+    #endif /* def QHSM_PROFILER */
     #ifdef Q_SPY
         if (r == Q_RET_ENTRY) {
 
@@ -460,6 +496,12 @@ void QMsm_exitToTranSource_(
             QS_CRIT_STAT_
 
             (void)(*s->exitAction)(me); /* execute the exit action */
+    #ifdef QHSM_PROFILER
+            if (me->prof != (QHsmProf *)0) {
+                QHsmProf_action_(me->prof, s->stateHandler,
+                                 (QSignal)Q_EXIT_SIG);
+            }
+    #endif /* def QHSM_PROFILER */
 
             QS_BEGIN_PRE_(QS_QEP_STATE_EXIT, qs_id)
                 QS_OBJ_PRE_(me);              /* this state machine object */
@@ -512,6 +554,12 @@ QState QMsm_enterHistory_(
     while (i > 0) {
         --i;
         (void)(*epath[i]->entryAction)(me); /* run entry action in epath[i] */
+    #ifdef QHSM_PROFILER
+        if (me->prof != (QHsmProf *)0) {
+            QHsmProf_action_(me->prof, epath[i]->stateHandler,
+                             (QSignal)Q_ENTRY_SIG);
+        }
+    #endif /* def QHSM_PROFILER */
 
         QS_BEGIN_PRE_(QS_QEP_STATE_ENTRY, qs_id)
             QS_OBJ_PRE_(me);
@@ -525,6 +573,12 @@ QState QMsm_enterHistory_(
     QState r;
     if (hist->initAction != Q_ACTION_CAST(0)) {
         r = (*hist->initAction)(me); /* execute the transition action */
+    #ifdef QHSM_PROFILER
+        if (me->prof != (QHsmProf *)0) {
+            QHsmProf_action_(me->prof, hist->stateHandler,
+                             (QSignal)Q_INIT_SIG);
+        }
+    #endif /* def QHSM_PROFILER */
     }
     else {
         r = Q_RET_NULL;
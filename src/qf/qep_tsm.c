@@ -0,0 +1,305 @@
+/*$file${src::qf::qep_tsm.c} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
+/*
+* Model: qpc.qm
+* File:  ${src::qf::qep_tsm.c}
+*
+* This code has been generated by QM 5.2.1 <www.state-machine.com/qm>.
+* DO NOT EDIT THIS FILE MANUALLY. All your changes will be lost.
+*
+* This code is covered by the following QP license:
+* License #    : LicenseRef-QL-dual
+* Issued to    : Any user of the QP/C real-time embedded framework
+* Framework(s) : qpc
+* Support ends : 2023-12-31
+* License scope:
+*
+* Copyright (C) 2005 Quantum Leaps, LLC <state-machine.com>.
+*
+* SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+*
+* This software is dual-licensed under the terms of the open source GNU
+* General Public License version 3 (or any later version), or alternatively,
+* under the terms of one of the closed source Quantum Leaps commercial
+* licenses.
+*
+* The terms of the open source GNU General Public License version 3
+* can be found at: <www.gnu.org/licenses/gpl-3.0>
+*
+* The terms of the closed source Quantum Leaps commercial licenses
+* can be found at: <www.state-machine.com/licensing>
+*
+* Redistributions in source code must retain this top-level comment block.
+* Plagiarizing this software to sidestep the license obligations is illegal.
+*
+* Contact information:
+* <www.state-machine.com/licensing>
+* <info@state-machine.com>
+*/
+/*$endhead${src::qf::qep_tsm.c} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+/*! @file
+* @brief ::QTsm implementation
+*/
+#define QP_IMPL           /* this is QP implementation */
+#include "qep_port.h"     /* QEP port */
+#include "qassert.h"      /* QP embedded systems-friendly assertions */
+#ifdef Q_SPY              /* QS software tracing enabled? */
+    #include "qs_port.h"  /* QS port */
+    #include "qs_pkg.h"   /* QS facilities for pre-defined trace records */
+#else
+    #include "qs_dummy.h" /* disable the QS software tracing */
+#endif /* Q_SPY */
+
+Q_DEFINE_THIS_MODULE("qep_tsm")
+
+/*==========================================================================*/
+/*! internal QEP constants */
+
+/*! reserved events passed to the entry/exit actions and initial actions */
+static QEvt const QTsm_reservedEvt_[] = {
+    QEVT_INITIALIZER(0),
+    QEVT_INITIALIZER(Q_ENTRY_SIG),
+    QEVT_INITIALIZER(Q_EXIT_SIG),
+    QEVT_INITIALIZER(Q_INIT_SIG)
+};
+
+/*==========================================================================*/
+/*$skip${QP_VERSION} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
+/* Check for the minimum required QP version */
+#if (QP_VERSION < 690U) || (QP_VERSION != ((QP_RELEASE^4294967295U) % 0x3E8U))
+#error qpc version 6.9.0 or higher required
+#endif
+/*$endskip${QP_VERSION} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+
+/*$define${QEP::QTsm} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
+
+/*${QEP::QTsm} .............................................................*/
+
+/*${QEP::QTsm::ctor} .......................................................*/
+void QTsm_ctor(
+    QHsm * const me,
+    QTsmTable const * const table)
+{
+    static struct QHsmVtable const vtable = { /* QHsm virtual table */
+        &QTsm_init_,
+        &QTsm_dispatch_
+    #ifdef Q_SPY
+        ,&QTsm_getStateHandler_
+    #endif
+    };
+    /* do not call the QHsm_ctor() here */
+    me->vptr = &vtable;
+    me->state.tst = &table->states[0]; /* the current state (top) */
+    me->temp.tbl  = table;             /* the constant tables of the TSM */
+}
+
+/*${QEP::QTsm::init_} ......................................................*/
+void QTsm_init_(
+    QHsm * const me,
+    void const * const e,
+    uint_fast8_t const qs_id)
+{
+    #ifndef Q_SPY
+    (void)qs_id; /* unused parameter */
+    #endif
+
+    QTsmTable const * const tbl = me->temp.tbl;
+
+    /*! @pre the virtual pointer and the tables must be initialized,
+    * the top-most initial transition must be defined, and the initial
+    * transition must not be taken yet.
+    */
+    Q_REQUIRE_ID(200, (me->vptr != (struct QHsmVtable *)0)
+                      && (tbl != (QTsmTable *)0)
+                      && (tbl->states[0].init != 0U)
+                      && (me->state.tst == &tbl->states[0]));
+
+    /* execute the action of the top-most initial tran. */
+    QTsmTran const * const tran = &tbl->trans[tbl->states[0].init];
+    if (tran->action != (QTsmAction)0) {
+        (*tran->action)(me, (QEvt const *)e);
+    }
+
+    QS_CRIT_STAT_
+    QS_BEGIN_PRE_(QS_QEP_STATE_INIT, qs_id)
+        QS_OBJ_PRE_(me); /* this state machine object */
+        QS_FUN_PRE_(tbl->states[0].entry);           /* source state */
+        QS_FUN_PRE_(tbl->states[tran->target].entry); /* target state */
+    QS_END_PRE_()
+
+    /* enter the target and drill into the nested initial transitions */
+    me->state.tst = QTsm_enter_(me, tran, qs_id);
+
+    QS_BEGIN_PRE_(QS_QEP_INIT_TRAN, qs_id)
+        QS_TIME_PRE_();   /* time stamp */
+        QS_OBJ_PRE_(me);  /* this state machine object */
+        QS_FUN_PRE_(me->state.tst->entry); /* the new current state */
+    QS_END_PRE_()
+}
+
+/*${QEP::QTsm::dispatch_} ..................................................*/
+void QTsm_dispatch_(
+    QHsm * const me,
+    QEvt const * const e,
+    uint_fast8_t const qs_id)
+{
+    #ifndef Q_SPY
+    (void)qs_id; /* unused parameter */
+    #endif
+
+    QTsmTable const * const tbl = me->temp.tbl;
+    QTsmState const *s = me->state.tst; /* the current state */
+
+    /*! @pre the initial transition must have been taken */
+    Q_REQUIRE_ID(300, (s != (QTsmState *)0)
+                      && (s != &tbl->states[0]));
+
+    QS_CRIT_STAT_
+    QS_BEGIN_PRE_(QS_QEP_DISPATCH, qs_id)
+        QS_TIME_PRE_();         /* time stamp */
+        QS_SIG_PRE_(e->sig);    /* the signal of the event */
+        QS_OBJ_PRE_(me);        /* this state machine object */
+        QS_FUN_PRE_(s->entry);  /* the current state */
+    QS_END_PRE_()
+
+    /* look up the transition in the row of the current state... */
+    uint_fast8_t it = 0U; /* index of the transition (0 means none) */
+    if (e->sig >= (QSignal)Q_USER_SIG) {
+        uint_fast16_t const col =
+            (uint_fast16_t)e->sig - (uint_fast16_t)Q_USER_SIG;
+        if (col < (uint_fast16_t)tbl->nSigs) {
+            uint_fast16_t const row = (uint_fast16_t)(s - tbl->states);
+            it = tbl->dispatch[(row * tbl->nSigs) + col];
+        }
+    }
+
+    /* try the guarded transitions until one is enabled... */
+    QTsmTran const *tran = &tbl->trans[it];
+    while ((it != 0U)
+           && (tran->guard != (QTsmGuard)0)
+           && !(*tran->guard)(me, e))
+    {
+        it = tran->next;
+
+        /* all guards of the source state evaluated to 'false'? */
+        if ((it == 0U) || (tbl->trans[it].source != tran->source)) {
+            QS_BEGIN_PRE_(QS_QEP_UNHANDLED, qs_id)
+                QS_SIG_PRE_(e->sig); /* the signal of the event */
+                QS_OBJ_PRE_(me);     /* this state machine object */
+                QS_FUN_PRE_(tbl->states[tran->source].entry);
+            QS_END_PRE_()
+        }
+        tran = &tbl->trans[it];
+    }
+
+    if (it == 0U) { /* the event was not handled? */
+        QS_BEGIN_PRE_(QS_QEP_IGNORED, qs_id)
+            QS_TIME_PRE_();          /* time stamp */
+            QS_SIG_PRE_(e->sig);     /* the signal of the event */
+            QS_OBJ_PRE_(me);         /* this state machine object */
+            QS_FUN_PRE_(s->entry);   /* the current state */
+        QS_END_PRE_()
+    }
+    else {
+        /* execute the transition action */
+        if (tran->action != (QTsmAction)0) {
+            (*tran->action)(me, e);
+        }
+
+        if (tran->target != 0U) { /* regular transition? */
+            /* exit the current state configuration up to the stop state */
+            QTsmState const * const stop = &tbl->states[tran->stop];
+            for (; s != stop; s = &tbl->states[s->super]) {
+                if (s->exit != (QTsmAction)0) {
+                    (*s->exit)(me, &QTsm_reservedEvt_[Q_EXIT_SIG]);
+
+                    QS_BEGIN_PRE_(QS_QEP_STATE_EXIT, qs_id)
+                        QS_OBJ_PRE_(me);
+                        QS_FUN_PRE_(s->entry); /* the exited state */
+                    QS_END_PRE_()
+                }
+            }
+
+            /* enter the target and drill into the initial transitions */
+            me->state.tst = QTsm_enter_(me, tran, qs_id);
+
+            QS_BEGIN_PRE_(QS_QEP_TRAN, qs_id)
+                QS_TIME_PRE_();          /* time stamp */
+                QS_SIG_PRE_(e->sig);     /* the signal of the event */
+                QS_OBJ_PRE_(me);         /* this state machine object */
+                QS_FUN_PRE_(tbl->states[tran->source].entry); /* source */
+                QS_FUN_PRE_(me->state.tst->entry); /* the new active state */
+            QS_END_PRE_()
+        }
+        else { /* internal transition */
+            QS_BEGIN_PRE_(QS_QEP_INTERN_TRAN, qs_id)
+                QS_TIME_PRE_();          /* time stamp */
+                QS_SIG_PRE_(e->sig);     /* the signal of the event */
+                QS_OBJ_PRE_(me);         /* this state machine object */
+                QS_FUN_PRE_(tbl->states[tran->source].entry); /* source */
+            QS_END_PRE_()
+        }
+    }
+}
+
+/*${QEP::QTsm::getStateHandler_} ...........................................*/
+#ifdef Q_SPY
+QStateHandler QTsm_getStateHandler_(QHsm * const me) {
+    /* the state is identified by its entry action (see ::QTsmState),
+    * which is cast via the generic function pointer void (*)(void)
+    */
+    return Q_STATE_CAST((void (*)(void))me->state.tst->entry);
+}
+#endif /* def Q_SPY */
+
+/*${QEP::QTsm::enter_} .....................................................*/
+QTsmState const * QTsm_enter_(
+    QHsm * const me,
+    QTsmTran const * tran,
+    uint_fast8_t const qs_id)
+{
+    #ifndef Q_SPY
+    (void)qs_id; /* unused parameter */
+    #endif
+
+    QTsmTable const * const tbl = me->temp.tbl;
+    QTsmState const *t;
+    uint_fast8_t init;
+
+    QS_CRIT_STAT_
+    do {
+        /* retrace the precomputed entry path of the transition... */
+        uint8_t const *path = &tbl->paths[tran->path];
+        for (uint_fast8_t n = tran->nEntry; n != 0U; --n) {
+            QTsmState const * const s = &tbl->states[*path];
+            ++path;
+            (*s->entry)(me, &QTsm_reservedEvt_[Q_ENTRY_SIG]);
+
+            QS_BEGIN_PRE_(QS_QEP_STATE_ENTRY, qs_id)
+                QS_OBJ_PRE_(me);
+                QS_FUN_PRE_(s->entry); /* the entered state */
+            QS_END_PRE_()
+        }
+
+        t = &tbl->states[tran->target];
+        init = t->init;
+        if (init != 0U) { /* nested initial transition? */
+            tran = &tbl->trans[init];
+
+            /* the initial transition must enter a substate */
+            Q_ASSERT_ID(410, tran->target != 0U);
+
+            if (tran->action != (QTsmAction)0) {
+                (*tran->action)(me, &QTsm_reservedEvt_[Q_INIT_SIG]);
+            }
+
+            QS_BEGIN_PRE_(QS_QEP_STATE_INIT, qs_id)
+                QS_OBJ_PRE_(me); /* this state machine object */
+                QS_FUN_PRE_(t->entry); /* source (pseudo)state */
+                QS_FUN_PRE_(tbl->states[tran->target].entry); /* target */
+            QS_END_PRE_()
+        }
+    } while (init != 0U);
+
+    return t;
+}
+/*$enddef${QEP::QTsm} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
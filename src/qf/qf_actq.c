@@ -42,6 +42,8 @@
 * @note
 * this source file is only included in the application build when the native
 * QF active object queue is used (instead of a message queue of an RTOS).
+* The QF port can also replace the native queue operations by defining the
+* macro #QF_ACTQ_PORT, in which case this file compiles to nothing.
 */
 #define QP_IMPL           /* this is QP implementation */
 #include "qf_port.h"      /* QF port */
@@ -54,6 +56,9 @@
     #include "qs_dummy.h" /* disable the QS software tracing */
 #endif /* Q_SPY */
 
+/* does the QF port provide its own active object queue operations? */
+#ifndef QF_ACTQ_PORT
+
 Q_DEFINE_THIS_MODULE("qf_actq")
 
 /*==========================================================================*/
@@ -78,7 +83,7 @@ bool QActive_post_(QActive * const me,
     Q_REQUIRE_ID(100, e != (QEvt *)0);
 
     QF_CRIT_STAT_
-    QF_CRIT_E_();
+    QF_ACTQ_CRIT_E_(me);
     QEQueueCtr nFree = me->eQueue.nFree; /* get volatile into the temporary */
 
     /* test-probe#1 for faking queue overflow */
@@ -94,7 +99,7 @@ bool QActive_post_(QActive * const me,
         }
         else {
             status = false; /* cannot post */
-            Q_ERROR_CRIT_(110); /* must be able to post the event */
+            Q_ERROR_ACTQ_CRIT_(me, 110); /* must be able to post the event */
         }
     }
     else if (nFree > (QEQueueCtr)margin) {
@@ -106,6 +111,9 @@ bool QActive_post_(QActive * const me,
 
     /* is it a dynamic event? */
     if (e->poolId_ != 0U) {
+        /* a moved event can be posted only once (see QActive_postMove_()) */
+        Q_ASSERT_ACTQ_CRIT_(me, 120, QF_EVT_NOT_MOVED_(e));
+
         QF_EVT_REF_CTR_INC_(e); /* increment the reference counter */
     }
 
@@ -154,7 +162,7 @@ bool QActive_post_(QActive * const me,
             --me->eQueue.head; /* advance the head (counter clockwise) */
         }
 
-        QF_CRIT_X_();
+        QF_ACTQ_CRIT_X_(me);
     }
     else { /* cannot post the event */
 
@@ -178,7 +186,7 @@ bool QActive_post_(QActive * const me,
         }
     #endif
 
-        QF_CRIT_X_();
+        QF_ACTQ_CRIT_X_(me);
 
     #if (QF_MAX_EPOOL > 0U)
         QF_gc(e); /* recycle the event to avoid a leak */
@@ -195,7 +203,7 @@ void QActive_postLIFO_(QActive * const me,
     QEvt const * const e)
 {
     QF_CRIT_STAT_
-    QF_CRIT_E_();
+    QF_ACTQ_CRIT_E_(me);
     QEQueueCtr nFree = me->eQueue.nFree; /* get volatile into the temporary */
 
     /* test-probe#1 for faking queue overflow */
@@ -205,7 +213,7 @@ void QActive_postLIFO_(QActive * const me,
     )
 
     /* the queue must be able to accept the event (cannot overflow) */
-    Q_ASSERT_CRIT_(210, nFree != 0U);
+    Q_ASSERT_ACTQ_CRIT_(me, 210, nFree != 0U);
 
     /* is it a dynamic event? */
     if (e->poolId_ != 0U) {
@@ -241,6 +249,10 @@ void QActive_postLIFO_(QActive * const me,
     QEvt const * const frontEvt  = me->eQueue.frontEvt;
     me->eQueue.frontEvt = e; /* deliver the event directly to the front */
 
+    #ifdef QACTIVE_EQUEUE_LIFO_
+    QACTIVE_EQUEUE_LIFO_(me); /* the port tracks the LIFO posting */
+    #endif
+
     /* was the queue empty? */
     if (frontEvt == (QEvt *)0) {
         QACTIVE_EQUEUE_SIGNAL_(me); /* signal the event queue */
@@ -255,7 +267,7 @@ void QActive_postLIFO_(QActive * const me,
 
         me->eQueue.ring[me->eQueue.tail] = frontEvt;
     }
-    QF_CRIT_X_();
+    QF_ACTQ_CRIT_X_(me);
 }
 /*$enddef${QF::QActive::postLIFO_} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
 /*$define${QF::QActive::get_} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
@@ -263,7 +275,7 @@ void QActive_postLIFO_(QActive * const me,
 /*${QF::QActive::get_} .....................................................*/
 QEvt const * QActive_get_(QActive * const me) {
     QF_CRIT_STAT_
-    QF_CRIT_E_();
+    QF_ACTQ_CRIT_E_(me);
     QACTIVE_EQUEUE_WAIT_(me);  /* wait for event to arrive directly */
 
     /* always remove event from the front */
@@ -293,7 +305,7 @@ QEvt const * QActive_get_(QActive * const me) {
         me->eQueue.frontEvt = (QEvt *)0; /* queue becomes empty */
 
         /* all entries in the queue must be free (+1 for fronEvt) */
-        Q_ASSERT_CRIT_(310, nFree == (me->eQueue.end + 1U));
+        Q_ASSERT_ACTQ_CRIT_(me, 310, nFree == (me->eQueue.end + 1U));
 
         QS_BEGIN_NOCRIT_PRE_(QS_QF_ACTIVE_GET_LAST, me->prio)
             QS_TIME_PRE_();      /* timestamp */
@@ -302,26 +314,224 @@ QEvt const * QActive_get_(QActive * const me) {
             QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
         QS_END_NOCRIT_PRE_()
     }
-    QF_CRIT_X_();
+    QF_ACTQ_CRIT_X_(me);
     return e;
 }
 /*$enddef${QF::QActive::get_} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+/*$define${QF::QActive::getBatch_} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
+
+/*${QF::QActive::getBatch_} ................................................*/
+#ifdef QF_ACTQ_BATCH
+uint_fast16_t QActive_getBatch_(QActive * const me,
+    QEvt const * * const evts,
+    uint_fast16_t const max)
+{
+    /*! @pre the batch buffer must be provided */
+    Q_REQUIRE_ID(600, (evts != (QEvt const **)0) && (max > 0U));
+
+    QF_CRIT_STAT_
+    QF_ACTQ_CRIT_E_(me);
+    QACTIVE_EQUEUE_WAIT_(me);  /* wait for event to arrive directly */
+
+    QEQueueCtr nFree = me->eQueue.nFree; /* volatile into tmp */
+    uint_fast16_t n = 0U;
+    do {
+        /* always remove event from the front */
+        QEvt const * const e = me->eQueue.frontEvt;
+        evts[n] = e;
+        ++n;
+        ++nFree; /* one more free entry */
+
+        /* any events in the ring buffer? */
+        if (nFree <= me->eQueue.end) {
+
+            /* remove event from the tail */
+            me->eQueue.frontEvt = me->eQueue.ring[me->eQueue.tail];
+            if (me->eQueue.tail == 0U) { /* need to wrap the tail? */
+                me->eQueue.tail = me->eQueue.end;   /* wrap around */
+            }
+            --me->eQueue.tail;
+
+            QS_BEGIN_NOCRIT_PRE_(QS_QF_ACTIVE_GET, me->prio)
+                QS_TIME_PRE_();      /* timestamp */
+                QS_SIG_PRE_(e->sig); /* the signal of this event */
+                QS_OBJ_PRE_(me);     /* this active object */
+                QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
+                QS_EQC_PRE_(nFree);  /* # free entries */
+            QS_END_NOCRIT_PRE_()
+        }
+        else {
+            me->eQueue.frontEvt = (QEvt *)0; /* queue becomes empty */
+
+            /* all entries in the queue must be free (+1 for fronEvt) */
+            Q_ASSERT_ACTQ_CRIT_(me, 610, nFree == (me->eQueue.end + 1U));
+
+            QS_BEGIN_NOCRIT_PRE_(QS_QF_ACTIVE_GET_LAST, me->prio)
+                QS_TIME_PRE_();      /* timestamp */
+                QS_SIG_PRE_(e->sig); /* the signal of this event */
+                QS_OBJ_PRE_(me);     /* this active object */
+                QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
+            QS_END_NOCRIT_PRE_()
+        }
+    } while ((n < max) && (me->eQueue.frontEvt != (QEvt *)0));
+
+    me->eQueue.nFree = nFree; /* update the number of free */
+    QF_ACTQ_CRIT_X_(me);
+    return n;
+}
+#endif /* def QF_ACTQ_BATCH */
+/*$enddef${QF::QActive::getBatch_} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
 
 /*$define${QF::QF-base::getQueueMin} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
 
 /*${QF::QF-base::getQueueMin} ..............................................*/
-uint_fast16_t QF_getQueueMin(uint_fast8_t const prio) {
+uint_fast16_t QF_getQueueMin(uint_fast16_t const prio) {
     Q_REQUIRE_ID(400, (prio <= QF_MAX_ACTIVE)
                       && (QActive_registry_[prio] != (QActive *)0));
+    QActive * const a = QActive_registry_[prio];
     QF_CRIT_STAT_
-    QF_CRIT_E_();
-    uint_fast16_t const min =
-         (uint_fast16_t)QActive_registry_[prio]->eQueue.nMin;
-    QF_CRIT_X_();
+    QF_ACTQ_CRIT_E_(a);
+    uint_fast16_t const min = (uint_fast16_t)a->eQueue.nMin;
+    QF_ACTQ_CRIT_X_(a);
 
     return min;
 }
 /*$enddef${QF::QF-base::getQueueMin} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+/*$define${QF::QF-pkg::multicast_} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
+
+/*${QF::QF-pkg::multicast_} ................................................*/
+#ifdef QF_PUBLISH_BATCH
+void QF_multicast_(
+    QPSet const * const subscrList,
+    QEvt const * const e,
+    void const * const sender)
+{
+    Q_UNUSED_PAR(sender); /* when Q_SPY undefined */
+
+    QPSet batch; /* subscribers with the native QActive_post_() */
+    QPSet other; /* subscribers with other post() operations */
+    QPSet_setEmpty(&batch);
+    QPSet_setEmpty(&other);
+    uint_fast16_t nBatch = 0U;
+
+    QPSet set = *subscrList;
+    while (QPSet_notEmpty(&set)) {
+        uint_fast16_t const p = QPSet_findMax(&set);
+        QPSet_remove(&set, p);
+        QActive const * const a = QActive_registry_[p];
+
+        /* the prio of the AO must be registered with the framework */
+        Q_ASSERT_ID(500, a != (QActive *)0);
+
+        if (((QActiveVtable const *)a->super.vptr)->post == &QActive_post_) {
+            QPSet_insert(&batch, p);
+            ++nBatch;
+        }
+        else {
+            QPSet_insert(&other, p);
+        }
+    }
+
+    /* all references of the batched recipients (plus the reference of
+    * the publisher) must fit in the reference counter
+    */
+    Q_ASSERT_ID(520,
+        (uint_fast32_t)nBatch < (uint_fast32_t)(QEvtRefCtr)~(QEvtRefCtr)0U);
+
+    QPSet wake; /* recipients whose queues were empty */
+    QPSet_setEmpty(&wake);
+    QF_CRIT_STAT_
+
+    #ifndef QF_OBJ_CRIT
+    QF_CRIT_E_(); /* one critical section for the whole fan-out */
+    #endif
+
+    /* add the references of all batched recipients at once */
+    if ((nBatch > 0U) && (e->poolId_ != 0U)) {
+        QF_EVT_REF_CTR_ADD_(e, nBatch);
+    }
+
+    while (QPSet_notEmpty(&batch)) {
+        uint_fast16_t const p = QPSet_findMax(&batch);
+        QPSet_remove(&batch, p);
+        QActive * const a = QActive_registry_[p];
+
+    #ifdef QF_OBJ_CRIT
+        QF_ACTQ_CRIT_E_(a);
+    #endif
+        QEQueueCtr nFree = a->eQueue.nFree; /* get volatile into temporary */
+
+        /* must be able to post the event */
+        Q_ASSERT_ACTQ_CRIT_(a, 510, nFree > 0U);
+
+        --nFree; /* one free entry just used up */
+        a->eQueue.nFree = nFree; /* update the volatile */
+        if (a->eQueue.nMin > nFree) {
+            a->eQueue.nMin = nFree; /* increase minimum so far */
+        }
+
+        QS_BEGIN_NOCRIT_PRE_(QS_QF_ACTIVE_POST, a->prio)
+            QS_TIME_PRE_();               /* timestamp */
+            QS_OBJ_PRE_(sender);          /* the sender object */
+            QS_SIG_PRE_(e->sig);          /* the signal of the event */
+            QS_OBJ_PRE_(a);               /* this active object (recipient) */
+            QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
+            QS_EQC_PRE_(nFree);           /* number of free entries */
+            QS_EQC_PRE_(a->eQueue.nMin);  /* min number of free entries */
+        QS_END_NOCRIT_PRE_()
+
+    #ifdef Q_UTEST
+        if (QS_LOC_CHECK_(a->prio)) {
+            QS_onTestPost(sender, a, e, true);
+        }
+    #endif
+
+        /* empty queue? */
+        if (a->eQueue.frontEvt == (QEvt *)0) {
+            a->eQueue.frontEvt = e; /* deliver event directly */
+            QPSet_insert(&wake, p); /* signal after the fan-out */
+        }
+        /* queue is not empty, insert event into the ring-buffer */
+        else {
+            a->eQueue.ring[a->eQueue.head] = e;
+            if (a->eQueue.head == 0U) { /* need to wrap head? */
+                a->eQueue.head = a->eQueue.end; /* wrap around */
+            }
+            --a->eQueue.head; /* advance the head (counter clockwise) */
+        }
+    #ifdef QF_OBJ_CRIT
+        QF_ACTQ_CRIT_X_(a);
+    #endif
+    }
+
+    /* signal the recipients only after the whole fan-out */
+    while (QPSet_notEmpty(&wake)) {
+        uint_fast16_t const p = QPSet_findMax(&wake);
+        QPSet_remove(&wake, p);
+        QActive * const a = QActive_registry_[p];
+    #ifdef QF_OBJ_CRIT
+        QF_ACTQ_CRIT_E_(a); /* the signal belongs to the queue's lock */
+    #endif
+        QACTIVE_EQUEUE_SIGNAL_(a); /* signal the event queue */
+    #ifdef QF_OBJ_CRIT
+        QF_ACTQ_CRIT_X_(a);
+    #endif
+    }
+    #ifndef QF_OBJ_CRIT
+    QF_CRIT_X_();
+    #endif
+
+    /* the remaining subscribers */
+    while (QPSet_notEmpty(&other)) {
+        uint_fast16_t const p = QPSet_findMax(&other);
+        QPSet_remove(&other, p);
+
+        /* QACTIVE_POST() asserts internally if the queue overflows */
+        QACTIVE_POST(QActive_registry_[p], e, sender);
+    }
+}
+#endif /* def QF_PUBLISH_BATCH */
+/*$enddef${QF::QF-pkg::multicast_} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
 
 /*==========================================================================*/
 /*! Perform downcast to QTicker pointer.
@@ -385,10 +595,10 @@ void QTicker_dispatch_(
     Q_UNUSED_PAR(e);
     Q_UNUSED_PAR(qs_id); /* when Q_SPY undefined */
 
-    QF_CRIT_E_();
+    QF_ACTQ_CRIT_E_(QTICKER_CAST_(me));
     nTicks = QTICKER_CAST_(me)->eQueue.tail; /* save the # of ticks */
     QTICKER_CAST_(me)->eQueue.tail = 0U; /* clear the # ticks */
-    QF_CRIT_X_();
+    QF_ACTQ_CRIT_X_(QTICKER_CAST_(me));
 
     for (; nTicks > 0U; --nTicks) {
         QTimeEvt_tick_((uint_fast8_t)QTICKER_CAST_(me)->eQueue.head, me);
@@ -407,10 +617,10 @@ bool QTicker_post_(
     Q_UNUSED_PAR(sender); /* when Q_SPY undefined */
 
     QF_CRIT_STAT_
-    QF_CRIT_E_();
+    QF_ACTQ_CRIT_E_(me);
     if (me->eQueue.frontEvt == (QEvt *)0) {
 
-        static QEvt const tickEvt = { 0U, 0U, 0U };
+        static QEvt const tickEvt = QEVT_INITIALIZER(0U);
         me->eQueue.frontEvt = &tickEvt; /* deliver event directly */
         --me->eQueue.nFree; /* one less free event */
 
@@ -429,7 +639,7 @@ bool QTicker_post_(
         QS_EQC_PRE_(0U);     /* min number of free entries */
     QS_END_NOCRIT_PRE_()
 
-    QF_CRIT_X_();
+    QF_ACTQ_CRIT_X_(me);
 
     return true; /* the event is always posted correctly */
 }
@@ -445,3 +655,5 @@ void QTicker_postLIFO_(
     Q_ERROR_ID(900);
 }
 /*$enddef${QF::QTicker} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+
+#endif /* QF_ACTQ_PORT */
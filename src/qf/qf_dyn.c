@@ -54,6 +54,68 @@
 
 Q_DEFINE_THIS_MODULE("qf_dyn")
 
+/* Size-class index of the event pools ====================================*/
+/* The requested event sizes are divided into up to QF_EPOOL_CLASSES size
+* classes of (1 << l_classShift) bytes each, where the shift is the smallest
+* one that covers the largest event pool. Every size class maps to the
+* smallest event pool that fits the smallest event size in the class. The
+* event pools are also linked in the ascending order of their event sizes,
+* so an event larger than the pool of its class is allocated from the next
+* larger pool. With the default granularity of the native event pools
+* (the size of a pointer), this takes at most one step.
+*/
+enum { QF_EPOOL_CLASSES = 128U }; /* max number of size classes */
+enum { QF_EPOOL_NONE = 0xFFU };   /* no (next) event pool */
+
+static uint8_t l_classPool[QF_EPOOL_CLASSES]; /* class -> pool index */
+static uint8_t l_nextPool[QF_MAX_EPOOL]; /* next larger pool index */
+static uint8_t l_maxPool;          /* the pool index with the largest events */
+static uint_fast8_t l_classShift;  /* log2 of the size class [bytes] */
+
+/*..........................................................................*/
+/* rebuild the size-class index after a new event pool has been added */
+static void QF_poolIndex_(void) {
+    uint8_t sorted[QF_MAX_EPOOL];
+
+    /* sort the event pools by the event size (insertion sort) */
+    for (uint_fast8_t i = 0U; i < QF_maxPool_; ++i) {
+        uint_fast16_t const size = QF_EPOOL_EVENT_SIZE_(QF_ePool_[i]);
+        uint_fast8_t j = i;
+        while ((j > 0U)
+               && (QF_EPOOL_EVENT_SIZE_(QF_ePool_[sorted[j - 1U]]) > size))
+        {
+            sorted[j] = sorted[j - 1U];
+            --j;
+        }
+        sorted[j] = (uint8_t)i;
+    }
+    for (uint_fast8_t i = 0U; i < QF_maxPool_; ++i) {
+        l_nextPool[sorted[i]] = ((i + 1U) < QF_maxPool_)
+                                ? sorted[i + 1U] : (uint8_t)QF_EPOOL_NONE;
+    }
+    l_maxPool = sorted[QF_maxPool_ - 1U];
+
+    /* the smallest size class that covers the largest event pool */
+    uint_fast16_t const maxSize = QF_EPOOL_EVENT_SIZE_(QF_ePool_[l_maxPool]);
+    l_classShift = 0U;
+    while (((maxSize - 1U) >> l_classShift) >= QF_EPOOL_CLASSES) {
+        ++l_classShift;
+    }
+
+    /* map every class to the smallest pool for the smallest size in it */
+    uint_fast8_t i = 0U;
+    for (uint_fast16_t c = 0U; c < QF_EPOOL_CLASSES; ++c) {
+        uint_fast32_t const minSize = ((uint_fast32_t)c << l_classShift) + 1U;
+        while ((i < QF_maxPool_)
+               && (QF_EPOOL_EVENT_SIZE_(QF_ePool_[sorted[i]]) < minSize))
+        {
+            ++i;
+        }
+        l_classPool[c] = (i < QF_maxPool_) ? sorted[i]
+                                           : (uint8_t)QF_EPOOL_NONE;
+    }
+}
+
 //============================================================================
 /*$skip${QP_VERSION} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
 /* Check for the minimum required QP version */
@@ -91,20 +153,24 @@ void QF_poolInit(
     /*! @pre cannot exceed the number of available memory pools */
     Q_REQUIRE_ID(200, QF_maxPool_ < QF_MAX_EPOOL);
 
-    /*! @pre please initialize event pools in ascending order of evtSize: */
-    Q_REQUIRE_ID(201, (QF_maxPool_ == 0U)
-        || (QF_EPOOL_EVENT_SIZE_(QF_ePool_[QF_maxPool_ - 1U])
-            < evtSize));
-
     /* perform the platform-dependent initialization of the pool */
     QF_EPOOL_INIT_(QF_ePool_[QF_maxPool_], poolSto, poolSize, evtSize);
     ++QF_maxPool_; /* one more pool */
 
+    QF_poolIndex_(); /* update the size-class index of the pools */
+
     #ifdef Q_SPY
     /* generate the object-dictionary entry for the initialized pool */
     {
-        uint8_t obj_name[9] = "EvtPool?";
-        obj_name[7] = (uint8_t)(((uint8_t)'0' + QF_maxPool_) & 0x7FU);
+        uint8_t obj_name[10] = "EvtPool??";
+        if (QF_maxPool_ < 10U) {
+            obj_name[7] = (uint8_t)(((uint8_t)'0' + QF_maxPool_) & 0x7FU);
+            obj_name[8] = (uint8_t)'\0';
+        }
+        else {
+            obj_name[7] = (uint8_t)((uint8_t)'0' + (QF_maxPool_ / 10U));
+            obj_name[8] = (uint8_t)((uint8_t)'0' + (QF_maxPool_ % 10U));
+        }
         QS_obj_dict_pre_(&QF_ePool_[QF_maxPool_ - 1U], (char const *)obj_name);
     }
     #endif /* Q_SPY*/
@@ -112,7 +178,7 @@ void QF_poolInit(
 
 /*${QF::QF-dyn::poolGetMaxBlockSize} .......................................*/
 uint_fast16_t QF_poolGetMaxBlockSize(void) {
-    return QF_EPOOL_EVENT_SIZE_(QF_ePool_[QF_maxPool_ - 1U]);
+    return QF_EPOOL_EVENT_SIZE_(QF_ePool_[l_maxPool]);
 }
 
 /*${QF::QF-dyn::getPoolMin} ................................................*/
@@ -122,9 +188,9 @@ uint_fast16_t QF_getPoolMin(uint_fast8_t const poolId) {
                       && (0U < poolId) && (poolId <= QF_maxPool_));
 
     QF_CRIT_STAT_
-    QF_CRIT_E_();
+    QF_MPOOL_CRIT_E_(&QF_ePool_[poolId - 1U]);
     uint_fast16_t const min = (uint_fast16_t)QF_ePool_[poolId - 1U].nMin;
-    QF_CRIT_X_();
+    QF_MPOOL_CRIT_X_(&QF_ePool_[poolId - 1U]);
 
     return min;
 }
@@ -135,16 +201,23 @@ QEvt * QF_newX_(
     uint_fast16_t const margin,
     enum_t const sig)
 {
-    uint_fast8_t idx;
+    /* the size class of the requested event size ... */
+    uint_fast16_t const c = (evtSize > 0U)
+                            ? ((evtSize - 1U) >> l_classShift) : 0U;
 
     /* find the pool index that fits the requested event size ... */
-    for (idx = 0U; idx < QF_maxPool_; ++idx) {
-        if (evtSize <= QF_EPOOL_EVENT_SIZE_(QF_ePool_[idx])) {
-            break;
-        }
-    }
+    uint_fast8_t idx = (c < QF_EPOOL_CLASSES)
+                       ? l_classPool[c] : (uint_fast8_t)QF_EPOOL_NONE;
+
     /* cannot run out of registered pools */
-    Q_ASSERT_ID(310, idx < QF_maxPool_);
+    Q_ASSERT_ID(310, (QF_maxPool_ > 0U) && (idx != QF_EPOOL_NONE));
+
+    while (evtSize > QF_EPOOL_EVENT_SIZE_(QF_ePool_[idx])) {
+        idx = l_nextPool[idx];
+
+        /* cannot run out of registered pools */
+        Q_ASSERT_ID(315, idx != QF_EPOOL_NONE);
+    }
 
     /* get e -- platform-dependent */
     QEvt *e;
@@ -164,6 +237,9 @@ QEvt * QF_newX_(
         e->sig = (QSignal)sig;     /* set signal for this event */
         e->poolId_ = (uint8_t)(idx + 1U); /* store the pool ID */
         e->refCtr_ = 0U; /* set the reference counter to 0 */
+    #ifdef QF_POST_MOVE
+        e->moved_ = 0U;  /* not moved yet (see QActive_postMove_()) */
+    #endif
 
         QS_BEGIN_PRE_(QS_QF_NEW, (uint_fast8_t)QS_EP_ID + e->poolId_)
             QS_TIME_PRE_();        /* timestamp */
@@ -192,6 +268,40 @@ QEvt * QF_newX_(
 void QF_gc(QEvt const * const e) {
     /* is it a dynamic event? */
     if (e->poolId_ != 0U) {
+    #ifdef QF_EVT_REF_ATOMIC
+        QS_CRIT_STAT_
+
+        /* With the only reference to the event (e.g., a moved event, see
+        * QActive_postMove_()), nobody else can create or delete a reference
+        * concurrently, so the event is recycled without the atomic decrement.
+        * Otherwise, the decrement and the test for the last reference must
+        * be a single operation (see QF_EVT_REF_CTR_DEC_()).
+        */
+        QEvtRefCtr refCtr = QF_EVT_REF_CTR_GET_(e);
+        if (refCtr > 1U) {
+            refCtr = (QEvtRefCtr)(QF_EVT_REF_CTR_DEC_(e) + 1U);
+        }
+
+        /* isn't this the last reference? */
+        if (refCtr > 1U) {
+            QS_BEGIN_PRE_(QS_QF_GC_ATTEMPT,
+                          (uint_fast8_t)QS_EP_ID + e->poolId_)
+                QS_TIME_PRE_();         /* timestamp */
+                QS_SIG_PRE_(e->sig);    /* the signal of the event */
+                QS_2U8_PRE_(e->poolId_, refCtr); /* pool Id & ref Count */
+            QS_END_PRE_()
+        }
+        /* this is the last reference to this event, recycle it */
+        else {
+            uint_fast8_t const idx = (uint_fast8_t)e->poolId_ - 1U;
+
+            QS_BEGIN_PRE_(QS_QF_GC,
+                          (uint_fast8_t)QS_EP_ID + e->poolId_)
+                QS_TIME_PRE_();         /* timestamp */
+                QS_SIG_PRE_(e->sig);    /* the signal of the event */
+                QS_2U8_PRE_(e->poolId_, refCtr); /* pool Id & ref Count */
+            QS_END_PRE_()
+    #else /* all references protected by the single QF critical section */
         QF_CRIT_STAT_
         QF_CRIT_E_();
 
@@ -221,6 +331,7 @@ void QF_gc(QEvt const * const e) {
             QS_END_NOCRIT_PRE_()
 
             QF_CRIT_X_();
+    #endif /* QF_EVT_REF_ATOMIC */
 
             /* pool ID must be in range */
             Q_ASSERT_ID(410, idx < QF_maxPool_);
@@ -249,9 +360,30 @@ QEvt const * QF_newRef_(
         (e->poolId_ != 0U)
         && (evtRef == (void *)0));
 
+    #ifdef QF_EVT_REF_ATOMIC
+    QS_CRIT_STAT_
+
+    /* a moved event cannot be referenced (see QActive_postMove_()) */
+    Q_ASSERT_ID(510, QF_EVT_NOT_MOVED_(e));
+
+    /* the atomic increment needs no critical section */
+    QEvtRefCtr const refCtr = (QEvtRefCtr)QF_EVT_REF_CTR_INC_(e);
+
+    QS_BEGIN_PRE_(QS_QF_NEW_REF,
+                  (uint_fast8_t)QS_EP_ID + e->poolId_)
+        QS_TIME_PRE_();      /* timestamp */
+        QS_SIG_PRE_(e->sig); /* the signal of the event */
+        QS_2U8_PRE_(e->poolId_, refCtr); /* pool Id & ref Count */
+    QS_END_PRE_()
+
+    Q_UNUSED_PAR(refCtr); /* when Q_SPY undefined */
+    #else
     QF_CRIT_STAT_
     QF_CRIT_E_();
 
+    /* a moved event cannot be referenced (see QActive_postMove_()) */
+    Q_ASSERT_CRIT_(510, QF_EVT_NOT_MOVED_(e));
+
     QF_EVT_REF_CTR_INC_(e); /* increments the ref counter */
 
     QS_BEGIN_NOCRIT_PRE_(QS_QF_NEW_REF,
@@ -262,6 +394,7 @@ QEvt const * QF_newRef_(
     QS_END_NOCRIT_PRE_()
 
     QF_CRIT_X_();
+    #endif /* QF_EVT_REF_ATOMIC */
 
     return e;
 }
@@ -283,5 +416,32 @@ void QF_deleteRef_(void const * const evtRef) {
     #endif
 }
 /*$enddef${QF::QF-dyn} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+/*$define${QF::QActive::postMove_} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
+
+/*${QF::QActive::postMove_} ................................................*/
+void QActive_postMove_(QActive * const me,
+    QEvt const * const e,
+    void const * const sender)
+{
+    Q_UNUSED_PAR(sender); /* when Q_SPY undefined */
+
+    /*! @pre the event must be a new dynamic event, which is referenced
+    * only by the caller (not posted or published yet) */
+    Q_REQUIRE_ID(600, (e != (QEvt *)0)
+        && (e->poolId_ != 0U)
+        && (e->refCtr_ == 0U));
+
+    #ifdef QF_POST_MOVE
+    /* Mark the event as moved. The event is not accessible to anybody else
+    * yet, so a plain store suffices. The post then sets the only reference
+    * of the recipient without the atomic increment (QF_EVT_REF_CTR_INC_())
+    * and any other reference to the event asserts (QF_EVT_NOT_MOVED_()).
+    */
+    QF_CONST_CAST_(QEvt*, e)->moved_ = 1U;
+    #endif
+
+    QACTIVE_POST(me, e, sender);
+}
+/*$enddef${QF::QActive::postMove_} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
 
 #endif /* (QF_MAX_EPOOL > 0U) dynamic events configured */
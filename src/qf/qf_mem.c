@@ -52,6 +52,146 @@
 
 Q_DEFINE_THIS_MODULE("qf_mem")
 
+#ifdef QF_MPOOL_LOCKFREE
+/* Lock-free free list ====================================================*/
+/* The free blocks form a Treiber stack. Its head (QMPool.top) combines the
+* offset of the first free block from the start of the pool (plus one, so
+* that 0 means an empty list) in the lower 32 bits with a generation tag in
+* the upper 32 bits. The tag is incremented with every change of the head,
+* so a compare-and-swap based on a stale head fails even if the same block
+* has been removed and returned in the meantime (the ABA problem).
+*
+* The number of free blocks (QMPool.nFree) is reserved before a block is
+* removed and released after a block is returned, so the list always holds
+* at least nFree blocks and a reserved block is always available.
+*
+* The head, the counters and the links are accessed as C11 atomic objects
+* (<stdatomic.h>), which must be lock-free (checked in QMPool_init()).
+*/
+#ifdef __STDC_NO_ATOMICS__
+    #error "QF_MPOOL_LOCKFREE requires the C11 atomics (<stdatomic.h>)"
+#endif
+#include <stdatomic.h>
+
+#if (ATOMIC_LLONG_LOCK_FREE == 0) || (ATOMIC_POINTER_LOCK_FREE == 0)
+    #error "QF_MPOOL_LOCKFREE requires lock-free 64-bit and pointer atomics"
+#endif
+_Static_assert(sizeof(_Atomic uint64_t) == sizeof(uint64_t),
+               "the atomic tagged head must have the size of uint64_t");
+_Static_assert(sizeof(_Atomic QMPoolCtr) == sizeof(QMPoolCtr),
+               "the atomic QMPoolCtr must have the size of QMPoolCtr");
+_Static_assert(sizeof(QFreeBlock * _Atomic) == sizeof(QFreeBlock *),
+               "the atomic link must have the size of a pointer");
+
+/* the attribute 'm_' of the pool as a C11 atomic object of the type 'T_' */
+#define QMPOOL_ATOMIC_(T_, me_, m_) ((T_ _Atomic volatile *)&(me_)->m_)
+
+/* the link of the free block 'fb_' as a C11 atomic object */
+#define QMPOOL_NEXT_(fb_) \
+    ((QFreeBlock * _Atomic volatile *)&(fb_)->next)
+
+/* the tagged head of the free list with the block 'fb_' */
+#define QMPOOL_TOP_(me_, fb_, tag_) \
+    (((uint64_t)(tag_) << 32U) | (((fb_) == (void *)0) ? 0U \
+        : ((uint64_t)((uint8_t *)(fb_) - (uint8_t *)(me_)->start) + 1U)))
+
+/* the first free block in the tagged head 'top_' */
+#define QMPOOL_FB_(me_, top_) \
+    ((QFreeBlock *)((uint8_t *)(me_)->start \
+                    + ((uint32_t)(top_) - 1U)))
+
+/*..........................................................................*/
+/* reserve up to 'n' free blocks, while keeping the requested margin */
+static uint_fast16_t QMPool_reserve_(QMPool * const me,
+                                     uint_fast16_t const n,
+                                     uint_fast16_t const margin,
+                                     QMPoolCtr * const nFree)
+{
+    QMPoolCtr nf = atomic_load_explicit(
+                       QMPOOL_ATOMIC_(QMPoolCtr, me, nFree),
+                       memory_order_relaxed);
+    uint_fast16_t nGet;
+    do {
+        if (nf > (QMPoolCtr)margin) {
+            nGet = ((QMPoolCtr)(nf - (QMPoolCtr)margin) < (QMPoolCtr)n)
+                   ? (uint_fast16_t)(nf - (QMPoolCtr)margin) : n;
+        }
+        else {
+            nGet = 0U;
+        }
+    } while ((nGet != 0U)
+             && !atomic_compare_exchange_weak_explicit(
+                     QMPOOL_ATOMIC_(QMPoolCtr, me, nFree), &nf,
+                     (QMPoolCtr)(nf - (QMPoolCtr)nGet),
+                     memory_order_acquire, memory_order_relaxed));
+
+    if (nGet != 0U) {
+        nf -= (QMPoolCtr)nGet; /* the free blocks just reserved */
+
+        /* update the minimum so far */
+        QMPoolCtr nMin = atomic_load_explicit(
+                             QMPOOL_ATOMIC_(QMPoolCtr, me, nMin),
+                             memory_order_relaxed);
+        while ((nMin > nf)
+               && !atomic_compare_exchange_weak_explicit(
+                       QMPOOL_ATOMIC_(QMPoolCtr, me, nMin), &nMin, nf,
+                       memory_order_relaxed, memory_order_relaxed))
+        {
+            /* nMin changed by another thread, try again */
+        }
+    }
+    *nFree = nf;
+    return nGet;
+}
+/*..........................................................................*/
+/* remove one (already reserved) free block from the free list */
+static QFreeBlock *QMPool_pop_(QMPool * const me) {
+    uint64_t top = atomic_load_explicit(QMPOOL_ATOMIC_(uint64_t, me, top),
+                                        memory_order_acquire);
+    QFreeBlock *fb;
+    QFreeBlock *fb_next;
+    do {
+        /* the block is reserved, so the free list cannot be empty */
+        Q_ASSERT_ID(340, (uint32_t)top != 0U);
+
+        fb = QMPOOL_FB_(me, top);
+
+        /* NOTE: the block might be removed and reused by another thread
+        * at this point, so fb_next is valid only if the CAS succeeds
+        */
+        fb_next = atomic_load_explicit(QMPOOL_NEXT_(fb),
+                                       memory_order_relaxed);
+    } while (!atomic_compare_exchange_weak_explicit(
+                 QMPOOL_ATOMIC_(uint64_t, me, top), &top,
+                 QMPOOL_TOP_(me, fb_next, (top >> 32U) + 1U),
+                 memory_order_acquire, memory_order_acquire));
+
+    /* the next free block pointer can fall out of range when the client
+    * code writes past the memory block, thus corrupting the next block.
+    */
+    Q_ASSERT_ID(350, (fb_next == (QFreeBlock *)0)
+                     || QF_PTR_RANGE_((void *)fb_next, me->start, me->end));
+    return fb;
+}
+/*..........................................................................*/
+/* return the chain of free blocks 'first'..'last' to the free list */
+static void QMPool_push_(QMPool * const me,
+                         QFreeBlock * const first,
+                         QFreeBlock * const last)
+{
+    uint64_t top = atomic_load_explicit(QMPOOL_ATOMIC_(uint64_t, me, top),
+                                        memory_order_relaxed);
+    do {
+        atomic_store_explicit(QMPOOL_NEXT_(last),
+            ((uint32_t)top != 0U) ? QMPOOL_FB_(me, top) : (QFreeBlock *)0,
+            memory_order_relaxed);
+    } while (!atomic_compare_exchange_weak_explicit(
+                 QMPOOL_ATOMIC_(uint64_t, me, top), &top,
+                 QMPOOL_TOP_(me, first, (top >> 32U) + 1U),
+                 memory_order_release, memory_order_relaxed));
+}
+#endif /* QF_MPOOL_LOCKFREE */
+
 /*$skip${QP_VERSION} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
 /* Check for the minimum required QP version */
 #if (QP_VERSION < 690U) || (QP_VERSION != ((QP_RELEASE^4294967295U) % 0x3E8U))
@@ -113,6 +253,22 @@ void QMPool_init(QMPool * const me,
     me->nMin  = me->nTot;        /* the minimum number of free blocks */
     me->start = poolSto;         /* the original start this pool buffer */
     me->end   = fb;              /* the last block in this pool */
+
+    #ifdef QF_MPOOL_LOCKFREE
+    /* the offsets of the blocks must fit the tagged head */
+    Q_ASSERT_ID(120, (uint_fast32_t)((uint8_t *)me->end
+                                     - (uint8_t *)me->start) < 0xFFFFFFFFU);
+    me->top = QMPOOL_TOP_(me, me->free_head, 0U);
+
+    /* the atomic operations on this pool must be lock-free */
+    Q_ASSERT_ID(130, atomic_is_lock_free(QMPOOL_ATOMIC_(uint64_t, me, top))
+        && atomic_is_lock_free(QMPOOL_ATOMIC_(QMPoolCtr, me, nFree))
+        && atomic_is_lock_free(QMPOOL_NEXT_((QFreeBlock *)me->start)));
+    #endif
+
+    #ifdef QF_MPOOL_CRIT_INIT
+    QF_MPOOL_CRIT_INIT(me);      /* port-specific critical section */
+    #endif
 }
 
 /*${QF::QMPool::get} .......................................................*/
@@ -122,8 +278,35 @@ void * QMPool_get(QMPool * const me,
 {
     Q_UNUSED_PAR(qs_id); /* when Q_SPY undefined */
 
+    #ifdef QF_MPOOL_LOCKFREE
+    QMPoolCtr nFree;
+    QFreeBlock *fb;
+    QS_CRIT_STAT_
+
+    /* have more free blocks than the requested margin? */
+    if (QMPool_reserve_(me, 1U, margin, &nFree) != 0U) {
+        fb = QMPool_pop_(me);
+
+        QS_BEGIN_PRE_(QS_QF_MPOOL_GET, qs_id)
+            QS_TIME_PRE_();         /* timestamp */
+            QS_OBJ_PRE_(me);        /* this memory pool */
+            QS_MPC_PRE_(nFree);     /* # of free blocks in the pool */
+            QS_MPC_PRE_(me->nMin);  /* min # free blocks ever in the pool */
+        QS_END_PRE_()
+    }
+    else {
+        fb = (QFreeBlock *)0;
+
+        QS_BEGIN_PRE_(QS_QF_MPOOL_GET_ATTEMPT, qs_id)
+            QS_TIME_PRE_();         /* timestamp */
+            QS_OBJ_PRE_(me);        /* this memory pool */
+            QS_MPC_PRE_(nFree);     /* # of free blocks in the pool */
+            QS_MPC_PRE_(margin);    /* the requested margin */
+        QS_END_PRE_()
+    }
+    #else
     QF_CRIT_STAT_
-    QF_CRIT_E_();
+    QF_MPOOL_CRIT_E_(me);
 
     /* have more free blocks than the requested margin? */
     QFreeBlock *fb;
@@ -132,7 +315,7 @@ void * QMPool_get(QMPool * const me,
         fb = (QFreeBlock *)me->free_head; /* get a free block */
 
         /* the pool has some free blocks, so a free block must be available */
-        Q_ASSERT_CRIT_(310, fb != (QFreeBlock *)0);
+        Q_ASSERT_MPOOL_CRIT_(me, 310, fb != (QFreeBlock *)0);
 
         fb_next = fb->next; /* put volatile to a temporary to avoid UB */
 
@@ -140,7 +323,7 @@ void * QMPool_get(QMPool * const me,
         --me->nFree; /* one less free block */
         if (me->nFree == 0U) {
             /* pool is becoming empty, so the next free block must be NULL */
-            Q_ASSERT_CRIT_(320, fb_next == (QFreeBlock *)0);
+            Q_ASSERT_MPOOL_CRIT_(me, 320, fb_next == (QFreeBlock *)0);
 
             me->nMin = 0U; /* remember that the pool got empty */
         }
@@ -151,7 +334,8 @@ void * QMPool_get(QMPool * const me,
             * when the client code writes past the memory block, thus
             * corrupting the next block.
             */
-            Q_ASSERT_CRIT_(330, QF_PTR_RANGE_(fb_next, me->start, me->end));
+            Q_ASSERT_MPOOL_CRIT_(me, 330,
+                QF_PTR_RANGE_(fb_next, me->start, me->end));
 
             /* is the number of free blocks the new minimum so far? */
             if (me->nMin > me->nFree) {
@@ -179,7 +363,8 @@ void * QMPool_get(QMPool * const me,
             QS_MPC_PRE_(margin);    /* the requested margin */
         QS_END_NOCRIT_PRE_()
     }
-    QF_CRIT_X_();
+    QF_MPOOL_CRIT_X_(me);
+    #endif /* QF_MPOOL_LOCKFREE */
 
     return fb;  /* return the block or NULL pointer to the caller */
 }
@@ -197,8 +382,24 @@ void QMPool_put(QMPool * const me,
     Q_REQUIRE_ID(200, (me->nFree < me->nTot)
                       && QF_PTR_RANGE_(b, me->start, me->end));
 
+    #ifdef QF_MPOOL_LOCKFREE
+    QS_CRIT_STAT_
+    QMPool_push_(me, (QFreeBlock *)b, (QFreeBlock *)b);
+
+    /* one more free block in this pool (after it is in the free list) */
+    QMPoolCtr const nFree = (QMPoolCtr)(atomic_fetch_add_explicit(
+                                QMPOOL_ATOMIC_(QMPoolCtr, me, nFree), 1U,
+                                memory_order_release) + 1U);
+    Q_UNUSED_PAR(nFree); /* when Q_SPY undefined */
+
+    QS_BEGIN_PRE_(QS_QF_MPOOL_PUT, qs_id)
+        QS_TIME_PRE_();         /* timestamp */
+        QS_OBJ_PRE_(me);        /* this memory pool */
+        QS_MPC_PRE_(nFree);     /* the number of free blocks in the pool */
+    QS_END_PRE_()
+    #else
     QF_CRIT_STAT_
-    QF_CRIT_E_();
+    QF_MPOOL_CRIT_E_(me);
     ((QFreeBlock *)b)->next = (QFreeBlock *)me->free_head;/* link into list */
     me->free_head = b;      /* set as new head of the free list */
     ++me->nFree;            /* one more free block in this pool */
@@ -209,6 +410,158 @@ void QMPool_put(QMPool * const me,
         QS_MPC_PRE_(me->nFree); /* the number of free blocks in the pool */
     QS_END_NOCRIT_PRE_()
 
-    QF_CRIT_X_();
+    QF_MPOOL_CRIT_X_(me);
+    #endif /* QF_MPOOL_LOCKFREE */
+}
+
+/*${QF::QMPool::getBatch_} .................................................*/
+uint_fast16_t QMPool_getBatch_(QMPool * const me,
+    void * * const blocks,
+    uint_fast16_t const n,
+    uint_fast8_t const qs_id)
+{
+    Q_UNUSED_PAR(qs_id); /* when Q_SPY undefined */
+
+    #ifdef QF_MPOOL_LOCKFREE
+    QMPoolCtr nFree;
+    QS_CRIT_STAT_
+
+    /* reserve up to n blocks, but no more than the pool has */
+    uint_fast16_t const nGet = QMPool_reserve_(me, n, 0U, &nFree);
+    if (nGet > 0U) {
+        for (uint_fast16_t i = 0U; i < nGet; ++i) {
+            blocks[i] = QMPool_pop_(me);
+        }
+
+        QS_BEGIN_PRE_(QS_QF_MPOOL_GET, qs_id)
+            QS_TIME_PRE_();         /* timestamp */
+            QS_OBJ_PRE_(me);        /* this memory pool */
+            QS_MPC_PRE_(nFree);     /* # of free blocks in the pool */
+            QS_MPC_PRE_(me->nMin);  /* min # free blocks ever in the pool */
+        QS_END_PRE_()
+    }
+    else {
+        QS_BEGIN_PRE_(QS_QF_MPOOL_GET_ATTEMPT, qs_id)
+            QS_TIME_PRE_();         /* timestamp */
+            QS_OBJ_PRE_(me);        /* this memory pool */
+            QS_MPC_PRE_(nFree);     /* # of free blocks in the pool */
+            QS_MPC_PRE_(0U);        /* no margin requested */
+        QS_END_PRE_()
+    }
+    #else
+    QF_CRIT_STAT_
+    QF_MPOOL_CRIT_E_(me);
+
+    /* take up to n blocks, but no more than the pool has */
+    uint_fast16_t const nGet = (me->nFree < (QMPoolCtr)n)
+                               ? (uint_fast16_t)me->nFree : n;
+    if (nGet > 0U) {
+        void *fb = me->free_head;
+        for (uint_fast16_t i = 0U; i < nGet; ++i) {
+            /* the pool has some free blocks, so fb must be in range */
+            Q_ASSERT_MPOOL_CRIT_(me, 410,
+                QF_PTR_RANGE_(fb, me->start, me->end));
+            blocks[i] = fb;
+            fb = ((QFreeBlock *)fb)->next;
+        }
+        me->nFree -= (QMPoolCtr)nGet; /* nGet less free blocks */
+
+        /* the pool becoming empty must end with the NULL link */
+        Q_ASSERT_MPOOL_CRIT_(me, 420,
+            (me->nFree != 0U) || (fb == (void *)0));
+
+        /* is the number of free blocks the new minimum so far? */
+        if (me->nMin > me->nFree) {
+            me->nMin = me->nFree; /* remember the new minimum */
+        }
+
+        me->free_head = fb; /* set the head to the next free block */
+
+        QS_BEGIN_NOCRIT_PRE_(QS_QF_MPOOL_GET, qs_id)
+            QS_TIME_PRE_();         /* timestamp */
+            QS_OBJ_PRE_(me);        /* this memory pool */
+            QS_MPC_PRE_(me->nFree); /* # of free blocks in the pool */
+            QS_MPC_PRE_(me->nMin);  /* min # free blocks ever in the pool */
+        QS_END_NOCRIT_PRE_()
+    }
+    else {
+        QS_BEGIN_NOCRIT_PRE_(QS_QF_MPOOL_GET_ATTEMPT, qs_id)
+            QS_TIME_PRE_();         /* timestamp */
+            QS_OBJ_PRE_(me);        /* this memory pool */
+            QS_MPC_PRE_(me->nFree); /* # of free blocks in the pool */
+            QS_MPC_PRE_(0U);        /* no margin requested */
+        QS_END_NOCRIT_PRE_()
+    }
+    QF_MPOOL_CRIT_X_(me);
+    #endif /* QF_MPOOL_LOCKFREE */
+
+    return nGet;
+}
+
+/*${QF::QMPool::putBatch_} .................................................*/
+void QMPool_putBatch_(QMPool * const me,
+    void * const * const blocks,
+    uint_fast16_t const n,
+    uint_fast8_t const qs_id)
+{
+    Q_UNUSED_PAR(qs_id); /* when Q_SPY undefined */
+
+    #ifdef QF_MPOOL_LOCKFREE
+    QS_CRIT_STAT_
+    if (n > 0U) {
+        /* chain the blocks together and return them all at once */
+        for (uint_fast16_t i = 0U; i < n; ++i) {
+            /* the block pointer must be from this pool */
+            Q_ASSERT_ID(510, QF_PTR_RANGE_(blocks[i], me->start, me->end));
+            if ((i + 1U) < n) {
+                ((QFreeBlock *)blocks[i])->next = (QFreeBlock *)blocks[i + 1U];
+            }
+        }
+        QMPool_push_(me, (QFreeBlock *)blocks[0],
+                     (QFreeBlock *)blocks[n - 1U]);
+    }
+
+    /* n more free blocks in this pool (after they are in the free list) */
+    QMPoolCtr const nFree = (QMPoolCtr)(atomic_fetch_add_explicit(
+                                QMPOOL_ATOMIC_(QMPoolCtr, me, nFree),
+                                (QMPoolCtr)n, memory_order_release)
+                                + (QMPoolCtr)n);
+
+    /* # free blocks cannot exceed the total # blocks */
+    Q_ASSERT_ID(500, nFree <= me->nTot);
+    Q_UNUSED_PAR(nFree); /* when Q_SPY and Q_NASSERT defined */
+
+    QS_BEGIN_PRE_(QS_QF_MPOOL_PUT, qs_id)
+        QS_TIME_PRE_();         /* timestamp */
+        QS_OBJ_PRE_(me);        /* this memory pool */
+        QS_MPC_PRE_(nFree);     /* the number of free blocks in the pool */
+    QS_END_PRE_()
+    #else
+    QF_CRIT_STAT_
+    QF_MPOOL_CRIT_E_(me);
+
+    /* # free blocks cannot exceed the total # blocks */
+    Q_ASSERT_MPOOL_CRIT_(me, 500, ((QMPoolCtr)n <= me->nTot)
+                          && (me->nFree <= (QMPoolCtr)(me->nTot - n)));
+
+    for (uint_fast16_t i = 0U; i < n; ++i) {
+        /* the block pointer must be from this pool */
+        Q_ASSERT_MPOOL_CRIT_(me, 510,
+            QF_PTR_RANGE_(blocks[i], me->start, me->end));
+
+        /* link into list */
+        ((QFreeBlock *)blocks[i])->next = (QFreeBlock *)me->free_head;
+        me->free_head = blocks[i]; /* set as new head of the free list */
+    }
+    me->nFree += (QMPoolCtr)n; /* n more free blocks in this pool */
+
+    QS_BEGIN_NOCRIT_PRE_(QS_QF_MPOOL_PUT, qs_id)
+        QS_TIME_PRE_();         /* timestamp */
+        QS_OBJ_PRE_(me);        /* this memory pool */
+        QS_MPC_PRE_(me->nFree); /* the number of free blocks in the pool */
+    QS_END_NOCRIT_PRE_()
+
+    QF_MPOOL_CRIT_X_(me);
+    #endif /* QF_MPOOL_LOCKFREE */
 }
 /*$enddef${QF::QMPool} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
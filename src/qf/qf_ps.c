@@ -52,6 +52,107 @@
 
 Q_DEFINE_THIS_MODULE("qf_ps")
 
+/* Subscriber tables ======================================================*/
+/* The subscriber lists are numbered 0..(l_psLists - 1). In the dense table
+* (QActive_psInit()) the number of the list is the signal itself. In the
+* sparse table (QActive_psInitSparse()) it is the entry of the signal in the
+* open-addressing hash table with linear probing, where the signals are
+* hashed with the Fibonacci (multiplicative) hashing, so that the signals
+* allocated in widely separated ranges are spread over the whole table.
+* The sparse entries are never removed, so no deleted-entry markers are
+* needed for the probing.
+*/
+#define QF_PS_NONE_ (~(uint_fast32_t)0U) /* no subscriber list */
+
+static QSubscrEntry *l_psSparse;    /* sparse table (NULL for dense) */
+static uint_fast32_t l_psLists;     /* number of the subscriber lists */
+static uint_fast8_t  l_psShift;     /* 32 - log2(l_psLists) for sparse */
+
+/*..........................................................................*/
+/* the number of the subscriber list of the signal sig (or QF_PS_NONE_),
+* where the sparse entry of the signal is added if `insert` is true
+*/
+static uint_fast32_t QActive_psFind_(enum_t const sig, bool const insert) {
+    if (l_psSparse == (QSubscrEntry *)0) { /* dense table? */
+        return (uint_fast32_t)sig;
+    }
+    uint_fast32_t n = (uint_fast32_t)((uint32_t)((uint32_t)sig * 2654435769U)
+                                      >> l_psShift);
+    for (uint_fast32_t k = l_psLists; k > 0U; --k) {
+        QSignal const s = l_psSparse[n].sig;
+        if (s == (QSignal)sig) { /* found? */
+            return n;
+        }
+        if (s == 0U) { /* unused entry? */
+            if (insert) {
+                l_psSparse[n].sig = (QSignal)sig; /* take the entry */
+                return n;
+            }
+            return QF_PS_NONE_; /* the signal was never subscribed */
+        }
+        n = (n + 1U) & (l_psLists - 1U); /* linear probing */
+    }
+    return QF_PS_NONE_; /* the sparse table is full */
+}
+/*..........................................................................*/
+/* the subscriber list number n */
+static QSubscrList *QActive_psList_(uint_fast32_t const n) {
+    return (l_psSparse == (QSubscrEntry *)0)
+           ? &QActive_subscrList_[n]
+           : &l_psSparse[n].subscr;
+}
+/*..........................................................................*/
+/* the signal of the subscriber list number n */
+static enum_t QActive_psSig_(uint_fast32_t const n) {
+    return (l_psSparse == (QSubscrEntry *)0)
+           ? (enum_t)n
+           : (enum_t)l_psSparse[n].sig;
+}
+
+/* Reverse subscription index =============================================*/
+/* For every AO priority p the index holds the bitmap of the subscriber
+* lists the AO is in (one bit per list number), preceded by the summary
+* bitmap with one bit per non-zero word of that bitmap. The words are
+* ::QPSetBits, so that the highest set bit can be found with QF_LOG2().
+* The index is optional (see QActive_psIndexInit()) and is updated in the
+* same critical sections as the subscriber lists.
+*/
+#define QF_PS_IDX_BITS_ (8U * sizeof(QPSetBits))
+
+/* the bit of the number n in its ::QPSetBits word */
+#define QF_PS_IDX_BIT_(n_) \
+    ((QPSetBits)((QPSetBits)1U << ((n_) % QF_PS_IDX_BITS_)))
+
+static QPSetBits *l_psIdx;          /* index storage (NULL when not used) */
+static uint_fast32_t l_psIdxSum;    /* summary words per AO */
+static uint_fast32_t l_psIdxStride; /* all words per AO */
+
+/*..........................................................................*/
+/* the summary bitmap of the AO of priority p (followed by its lists) */
+static QPSetBits *QActive_psIndexOf_(uint_fast16_t const p) {
+    return &l_psIdx[(uint_fast32_t)(p - 1U) * l_psIdxStride];
+}
+/*..........................................................................*/
+static void QActive_psIndexInsert_(uint_fast16_t const p,
+                                   uint_fast32_t const n)
+{
+    QPSetBits * const idx = QActive_psIndexOf_(p);
+    uint_fast32_t const w = n / QF_PS_IDX_BITS_;
+    idx[l_psIdxSum + w] |= QF_PS_IDX_BIT_(n);
+    idx[w / QF_PS_IDX_BITS_] |= QF_PS_IDX_BIT_(w);
+}
+/*..........................................................................*/
+static void QActive_psIndexRemove_(uint_fast16_t const p,
+                                   uint_fast32_t const n)
+{
+    QPSetBits * const idx = QActive_psIndexOf_(p);
+    uint_fast32_t const w = n / QF_PS_IDX_BITS_;
+    idx[l_psIdxSum + w] &= (QPSetBits)~QF_PS_IDX_BIT_(n);
+    if (idx[l_psIdxSum + w] == 0U) { /* no more lists in this word? */
+        idx[w / QF_PS_IDX_BITS_] &= (QPSetBits)~QF_PS_IDX_BIT_(w);
+    }
+}
+
 /*==========================================================================*/
 /*$skip${QP_VERSION} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
 /* Check for the minimum required QP version */
@@ -82,8 +183,80 @@ void QActive_psInit(
     * (as is required by the C Standard).
     */
     QF_bzero(subscrSto, (uint_fast16_t)maxSignal * sizeof(QSubscrList));
+
+    l_psSparse = (QSubscrEntry *)0; /* dense subscriber table */
+    l_psLists  = (uint_fast32_t)maxSignal;
+    l_psIdx    = (QPSetBits *)0; /* no reverse subscription index (yet) */
 }
 /*$enddef${QF::QActive::psInit} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+/*$define${QF::QActive::psInitSparse} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
+
+/*${QF::QActive::psInitSparse} .............................................*/
+void QActive_psInitSparse(
+    QSubscrEntry * const subscrSto,
+    uint_fast16_t const nEntries,
+    enum_t const maxSignal)
+{
+    /*! @pre the number of entries must be a power of 2 */
+    Q_REQUIRE_ID(110, (subscrSto != (QSubscrEntry *)0)
+              && (nEntries >= 2U)
+              && ((nEntries & (nEntries - 1U)) == 0U));
+
+    QActive_subscrList_   = (QSubscrList *)0; /* no dense table */
+    QActive_maxPubSignal_ = maxSignal;
+
+    /* zero the entries (all unused), see QActive_psInit() */
+    QF_bzero(subscrSto, (uint_fast16_t)(nEntries * sizeof(QSubscrEntry)));
+
+    l_psSparse = subscrSto;
+    l_psLists  = nEntries;
+    l_psShift  = 32U;
+    for (uint_fast32_t n = nEntries; n > 1U; n >>= 1U) {
+        --l_psShift; /* 32 - log2(nEntries) */
+    }
+    l_psIdx    = (QPSetBits *)0; /* no reverse subscription index (yet) */
+}
+/*$enddef${QF::QActive::psInitSparse} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+/*$define${QF::QActive::psIndexInit} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
+
+/*${QF::QActive::psIndexInit} ..............................................*/
+void QActive_psIndexInit(
+    QPSetBits * const idxSto,
+    uint_fast32_t const idxLen)
+{
+    uint_fast32_t const nWords = QF_PS_INDEX_WORDS_(l_psLists);
+
+    /*! @pre QActive_psInit() or QActive_psInitSparse() must be called first
+    * and the index storage must be large enough for all subscriber lists
+    */
+    Q_REQUIRE_ID(100, (l_psLists != 0U)
+              && (idxSto != (QPSetBits *)0)
+              && (idxLen >= QF_PS_INDEX_LEN(l_psLists)));
+
+    uint_fast32_t const stride = QF_PS_INDEX_WORDS_(nWords) + nWords;
+    for (uint_fast16_t p = 0U; p < QF_MAX_ACTIVE; ++p) {
+        QF_bzero(&idxSto[p * stride],
+                 (uint_fast16_t)(stride * sizeof(QPSetBits)));
+    }
+
+    QF_CRIT_STAT_
+    QF_CRIT_E_();
+    l_psIdxSum    = stride - nWords;
+    l_psIdxStride = stride;
+    l_psIdx       = idxSto;
+
+    /* rebuild the index from the subscriptions made so far */
+    for (uint_fast32_t n = 0U; n < l_psLists; ++n) {
+        QPSet subscrList = *QActive_psList_(n);
+        while (QPSet_notEmpty(&subscrList)) {
+            uint_fast16_t const p = QPSet_findMax(&subscrList);
+            QActive_psIndexInsert_(p, n);
+            QPSet_remove(&subscrList, p);
+        }
+    }
+    QF_CRIT_X_();
+}
+/*$enddef${QF::QActive::psIndexInit} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
 /*$define${QF::QActive::publish_} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
 
 /*${QF::QActive::publish_} .................................................*/
@@ -117,20 +290,36 @@ void QActive_publish_(
         * recycles the event if the counter drops to zero. This covers the
         * case when the event was published without any subscribers.
         */
+        /* a moved event cannot be published (see QActive_postMove_()) */
+        Q_ASSERT_CRIT_(220, QF_EVT_NOT_MOVED_(e));
+
         QF_EVT_REF_CTR_INC_(e);
     }
 
     /* make a local, modifiable copy of the subscriber list */
-    QPSet subscrList = QActive_subscrList_[e->sig];
+    QPSet subscrList;
+    uint_fast32_t const n = QActive_psFind_((enum_t)e->sig, false);
+    if (n != QF_PS_NONE_) {
+        subscrList = *QActive_psList_(n);
+    }
+    else { /* the signal was never subscribed in the sparse table */
+        QPSet_setEmpty(&subscrList);
+    }
     QF_CRIT_X_();
 
     if (QPSet_notEmpty(&subscrList)) { /* any subscribers? */
         /* the highest-prio subscriber */;
-        uint_fast8_t p = QPSet_findMax(&subscrList);
+        uint_fast16_t p = QPSet_findMax(&subscrList);
         QActive *a = QActive_registry_[p];
         QF_SCHED_STAT_
 
         QF_SCHED_LOCK_(a->pthre); /* lock the scheduler up to threshold */
+    #ifdef QF_PUBLISH_BATCH
+        Q_UNUSED_PAR(a); /* when QF_SCHED_LOCK_() is empty */
+
+        /* fan-out to all subscribers at once (batched multicast) */
+        QF_multicast_(&subscrList, e, sender);
+    #else
         do { /* loop over all subscribers */
             /* the prio of the AO must be registered with the framework */
             Q_ASSERT_ID(210, a != (QActive *)0);
@@ -148,6 +337,7 @@ void QActive_publish_(
                 p = 0U; /* no more subscribers */
             }
         } while (p != 0U);
+    #endif /* QF_PUBLISH_BATCH */
         QF_SCHED_UNLOCK_(); /* unlock the scheduler */
     }
 
@@ -167,7 +357,7 @@ void QActive_publish_(
 void QActive_subscribe(QActive const * const me,
     enum_t const sig)
 {
-    uint_fast8_t const p = (uint_fast8_t)me->prio;
+    uint_fast16_t const p = me->prio;
 
     Q_REQUIRE_ID(300, ((enum_t)Q_USER_SIG <= sig)
               && (sig < QActive_maxPubSignal_)
@@ -183,8 +373,16 @@ void QActive_subscribe(QActive const * const me,
         QS_OBJ_PRE_(me);   /* this active object */
     QS_END_NOCRIT_PRE_()
 
+    uint_fast32_t const n = QActive_psFind_(sig, true);
+
+    /* the sparse subscriber table must not overflow */
+    Q_ASSERT_CRIT_(310, n != QF_PS_NONE_);
+
     /* set the priority bit */
-    QPSet_insert(&QActive_subscrList_[sig], p);
+    QPSet_insert(QActive_psList_(n), p);
+    if (l_psIdx != (QPSetBits *)0) { /* reverse index used? */
+        QActive_psIndexInsert_(p, n);
+    }
 
     QF_CRIT_X_();
 }
@@ -195,7 +393,7 @@ void QActive_subscribe(QActive const * const me,
 void QActive_unsubscribe(QActive const * const me,
     enum_t const sig)
 {
-    uint_fast8_t const p = (uint_fast8_t)me->prio;
+    uint_fast16_t const p = me->prio;
 
     /*! @pre the singal and the prioriy must be in ragne, the AO must also
     * be registered with the framework
@@ -214,8 +412,14 @@ void QActive_unsubscribe(QActive const * const me,
         QS_OBJ_PRE_(me);   /* this active object */
     QS_END_NOCRIT_PRE_()
 
-    /* clear priority bit */
-    QPSet_remove(&QActive_subscrList_[sig], p);
+    uint_fast32_t const n = QActive_psFind_(sig, false);
+    if (n != QF_PS_NONE_) { /* the signal has a subscriber list? */
+        /* clear priority bit */
+        QPSet_remove(QActive_psList_(n), p);
+        if (l_psIdx != (QPSetBits *)0) { /* reverse index used? */
+            QActive_psIndexRemove_(p, n);
+        }
+    }
 
     QF_CRIT_X_();
 }
@@ -224,16 +428,53 @@ void QActive_unsubscribe(QActive const * const me,
 
 /*${QF::QActive::unsubscribeAll} ...........................................*/
 void QActive_unsubscribeAll(QActive const * const me) {
-    uint_fast8_t const p = (uint_fast8_t)me->prio;
+    uint_fast16_t const p = me->prio;
 
     Q_REQUIRE_ID(500, (0U < p) && (p <= QF_MAX_ACTIVE)
                         && (QActive_registry_[p] == me));
 
-    for (enum_t sig = (enum_t)Q_USER_SIG; sig < QActive_maxPubSignal_; ++sig) {
+    if (l_psIdx != (QPSetBits *)0) { /* reverse index used? */
+        QPSetBits const * const idx = QActive_psIndexOf_(p);
+        uint_fast32_t s = 0U;
+        while (s < l_psIdxSum) { /* one subscription per critical section */
+            QF_CRIT_STAT_
+            QF_CRIT_E_();
+            if (idx[s] != 0U) {
+                /* the highest list word and subscriber list of this AO */
+                uint_fast32_t const w = (s * QF_PS_IDX_BITS_)
+                                        + QF_LOG2(idx[s]) - 1U;
+                uint_fast32_t const n = (w * QF_PS_IDX_BITS_)
+                                        + QF_LOG2(idx[l_psIdxSum + w]) - 1U;
+                enum_t const sig = QActive_psSig_(n);
+                Q_UNUSED_PAR(sig); /* when Q_SPY undefined */
+                QPSet_remove(QActive_psList_(n), p);
+                QActive_psIndexRemove_(p, n);
+
+                QS_BEGIN_NOCRIT_PRE_(QS_QF_ACTIVE_UNSUBSCRIBE, me->prio)
+                    QS_TIME_PRE_();   /* timestamp */
+                    QS_SIG_PRE_(sig); /* the signal of this event */
+                    QS_OBJ_PRE_(me);  /* this active object */
+                QS_END_NOCRIT_PRE_()
+            }
+            else {
+                ++s; /* no more subscriptions in this summary word */
+            }
+            QF_CRIT_X_();
+
+            /* prevent merging critical sections */
+            QF_CRIT_EXIT_NOP();
+        }
+        return;
+    }
+
+    for (uint_fast32_t n = 0U; n < l_psLists; ++n) {
         QF_CRIT_STAT_
         QF_CRIT_E_();
-        if (QPSet_hasElement(&QActive_subscrList_[sig], p)) {
-            QPSet_remove(&QActive_subscrList_[sig], p);
+        QSubscrList * const subscrList = QActive_psList_(n);
+        if (QPSet_hasElement(subscrList, p)) {
+            enum_t const sig = QActive_psSig_(n);
+            Q_UNUSED_PAR(sig); /* when Q_SPY undefined */
+            QPSet_remove(subscrList, p);
 
             QS_BEGIN_NOCRIT_PRE_(QS_QF_ACTIVE_UNSUBSCRIBE, me->prio)
                 QS_TIME_PRE_();   /* timestamp */
@@ -248,3 +489,11 @@ void QActive_unsubscribeAll(QActive const * const me) {
     }
 }
 /*$enddef${QF::QActive::unsubscribeAll} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+/*$define${QF::QF-pkg::subscrFind_} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
+
+/*${QF::QF-pkg::subscrFind_} ...............................................*/
+QSubscrList * QF_subscrFind_(enum_t const sig) {
+    uint_fast32_t const n = QActive_psFind_(sig, false);
+    return (n != QF_PS_NONE_) ? QActive_psList_(n) : (QSubscrList *)0;
+}
+/*$enddef${QF::QF-pkg::subscrFind_} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
@@ -121,7 +121,7 @@ void QActive_ctor(QActive * const me,
 
 /*${QF::QActive::register_} ................................................*/
 void QActive_register_(QActive * const me) {
-    uint8_t const prio  = me->prio;
+    uint_fast16_t const prio = me->prio;
 
     /*! @pre the priority of the AO must be in range. Also, the priority
     * must not be already in use. QF requires each active object to
@@ -135,17 +135,17 @@ void QActive_register_(QActive * const me) {
     if (me->pthre == 0U) { /* preemption-threshold not defined? */
         me->pthre = me->prio; /* apply the default */
     }
-    uint8_t prev_thre = me->pthre;
-    uint8_t next_thre = me->pthre;
+    uint_fast16_t prev_thre = me->pthre;
+    uint_fast16_t next_thre = me->pthre;
 
-    uint_fast8_t p;
-    for (p = (uint_fast8_t)prio - 1U; p > 0U; --p) {
+    uint_fast16_t p;
+    for (p = prio - 1U; p > 0U; --p) {
         if (QActive_registry_[p] != (QActive *)0) {
             prev_thre = QActive_registry_[p]->pthre;
             break;
         }
     }
-    for (p = (uint_fast8_t)prio + 1U; p <= QF_MAX_ACTIVE; ++p) {
+    for (p = prio + 1U; p <= QF_MAX_ACTIVE; ++p) {
         if (QActive_registry_[p] != (QActive *)0) {
             next_thre = QActive_registry_[p]->pthre;
             break;
@@ -169,7 +169,7 @@ void QActive_register_(QActive * const me) {
 
 /*${QF::QActive::unregister_} ..............................................*/
 void QActive_unregister_(QActive * const me) {
-    uint_fast8_t const p = (uint_fast8_t)me->prio;
+    uint_fast16_t const p = me->prio;
 
     /*! @pre the priority of the active object must not be zero and cannot
     * exceed the maximum #QF_MAX_ACTIVE. Also, the priority of the active
@@ -0,0 +1,96 @@
+/*$file${src::qf::qf_qtact.c} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
+/*
+* Model: qpc.qm
+* File:  ${src::qf::qf_qtact.c}
+*
+* This code has been generated by QM 5.2.1 <www.state-machine.com/qm>.
+* DO NOT EDIT THIS FILE MANUALLY. All your changes will be lost.
+*
+* This code is covered by the following QP license:
+* License #    : LicenseRef-QL-dual
+* Issued to    : Any user of the QP/C real-time embedded framework
+* Framework(s) : qpc
+* Support ends : 2023-12-31
+* License scope:
+*
+* Copyright (C) 2005 Quantum Leaps, LLC <state-machine.com>.
+*
+* SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+*
+* This software is dual-licensed under the terms of the open source GNU
+* General Public License version 3 (or any later version), or alternatively,
+* under the terms of one of the closed source Quantum Leaps commercial
+* licenses.
+*
+* The terms of the open source GNU General Public License version 3
+* can be found at: <www.gnu.org/licenses/gpl-3.0>
+*
+* The terms of the closed source Quantum Leaps commercial licenses
+* can be found at: <www.state-machine.com/licensing>
+*
+* Redistributions in source code must retain this top-level comment block.
+* Plagiarizing this software to sidestep the license obligations is illegal.
+*
+* Contact information:
+* <www.state-machine.com/licensing>
+* <info@state-machine.com>
+*/
+/*$endhead${src::qf::qf_qtact.c} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+/*! @file
+* @brief QTActive_ctor() definition
+*
+* @details
+* This file must remain separate from the rest to avoid pulling in the
+* "virtual" functions QHsm_init_() and QHsm_dispatch_() in case they
+* are not used by the application.
+*
+* @sa qf_qact.c
+*/
+#define QP_IMPL           /* this is QP implementation */
+#include "qf_port.h"      /* QF port */
+#include "qf_pkg.h"       /* QF package-scope interface */
+
+/*Q_DEFINE_THIS_MODULE("qf_qtact")*/
+
+/*$skip${QP_VERSION} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
+/* Check for the minimum required QP version */
+#if (QP_VERSION < 690U) || (QP_VERSION != ((QP_RELEASE^4294967295U) % 0x3E8U))
+#error qpc version 6.9.0 or higher required
+#endif
+/*$endskip${QP_VERSION} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+
+/*$define${QF::QTActive} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
+
+/*${QF::QTActive} ..........................................................*/
+
+/*${QF::QTActive::ctor} ....................................................*/
+void QTActive_ctor(
+    QActive * const me,
+    QTsmTable const * const table)
+{
+    static QActiveVtable const vtable = { /* QTActive virtual table */
+        { &QTsm_init_,
+          &QTsm_dispatch_
+    #ifdef Q_SPY
+         ,&QTsm_getStateHandler_
+    #endif
+        },
+        &QActive_start_,
+        &QActive_post_,
+        &QActive_postLIFO_
+    };
+
+    /* clear the whole QActive object, so that the framework can start
+    * correctly even if the startup code fails to clear the uninitialized
+    * data (as is required by the C Standard).
+    */
+    QF_bzero(me, sizeof(*me));
+
+    /* just like QMActive_ctor(), call QTsm_ctor() instead of QActive_ctor()
+    * to avoid pulling in the code for QHsm_init_() and QHsm_dispatch_()
+    */
+    QTsm_ctor(&me->super, table);
+
+    me->super.vptr = &vtable.super; /* hook vptr to QTActive vtable */
+}
+/*$enddef${QF::QTActive} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
@@ -62,6 +62,166 @@ Q_DEFINE_THIS_MODULE("qf_time")
 #define QACTIVE_CAST_(ptr_) ((QActive *)(ptr_))
 #endif
 
+#ifdef QF_TIMEEVT_WHEEL
+/* Hierarchical timing wheel =============================================*/
+/* The armed time events of every tick rate are kept in the slots of
+* QTE_WHEEL_LEVELS levels. A time event expiring in 'delta' ticks is linked
+* into the level 'l', such that delta < 2^(QF_TIMEEVT_WHEEL_BITS*(l+1)),
+* in the slot given by the digit 'l' of its expiration tick. Every time the
+* digits below the level 'l' of the tick counter wrap around to zero, the
+* slot of the level 'l' given by the new digit 'l' of the tick counter is
+* moved down the wheel ("cascaded"). This way, a clock tick processes only
+* the single slot of the level 0, which holds just the expiring time events.
+*/
+#define QTE_WHEEL_SLOTS  (1U << QF_TIMEEVT_WHEEL_BITS)
+#define QTE_WHEEL_MASK   (QTE_WHEEL_SLOTS - 1U)
+#define QTE_WHEEL_LEVELS \
+    (((8U * QF_TIMEEVT_CTR_SIZE) + QF_TIMEEVT_WHEEL_BITS - 1U) \
+     / QF_TIMEEVT_WHEEL_BITS)
+
+/* the digit of the tick 'tick_' at the level 'level_' of the wheel */
+#define QTE_WHEEL_DIGIT_(tick_, level_) \
+    ((uint_fast8_t)(((tick_) >> (QF_TIMEEVT_WHEEL_BITS * (level_))) \
+                    & QTE_WHEEL_MASK))
+
+/*! timing wheel of one tick rate */
+typedef struct {
+    QTimeEvt * volatile slot[QTE_WHEEL_LEVELS][QTE_WHEEL_SLOTS];
+    QTimeEvtCtr now;  /*!< the tick counter of this tick rate */
+    uint32_t nLinked; /*!< number of time events in the wheel */
+} QTimeEvtWheel;
+
+static QTimeEvtWheel l_wheel[QF_MAX_TICK_RATE];
+
+/* the number of ticks the time event 'me_' has left until it expires */
+#define QTE_CTR_(me_, tickRate_) \
+    ((QTimeEvtCtr)((me_)->expiry - l_wheel[(tickRate_)].now))
+
+/*..........................................................................*/
+/* link the time event into the wheel slot of its expiration tick
+* NOTE: must be called inside the time event critical section
+*/
+static void QTimeEvt_link_(QTimeEvt * const me,
+                           uint_fast8_t const tickRate)
+{
+    QTimeEvtWheel * const wheel = &l_wheel[tickRate];
+    QTimeEvtCtr delta = QTE_CTR_(me, tickRate);
+    uint_fast8_t level = 0U;
+    while (delta > QTE_WHEEL_MASK) { /* not within the next level? */
+        delta = (QTimeEvtCtr)(delta >> QF_TIMEEVT_WHEEL_BITS);
+        ++level;
+    }
+    QTimeEvt * volatile * const head
+        = &wheel->slot[level][QTE_WHEEL_DIGIT_(me->expiry, level)];
+
+    me->next = *head;
+    if (me->next != (QTimeEvt *)0) {
+        me->next->prev = &me->next;
+    }
+    me->prev = head;
+    *head = me;
+    ++wheel->nLinked;
+}
+/*..........................................................................*/
+/* unlink the time event from its wheel slot
+* NOTE: must be called inside the time event critical section
+*/
+static void QTimeEvt_unlink_(QTimeEvt * const me,
+                             uint_fast8_t const tickRate)
+{
+    *me->prev = me->next;
+    if (me->next != (QTimeEvt *)0) {
+        me->next->prev = me->prev;
+    }
+    me->next = (QTimeEvt *)0;
+    --l_wheel[tickRate].nLinked;
+}
+#else
+/* the number of ticks the time event 'me_' has left until it expires */
+#define QTE_CTR_(me_, tickRate_) ((me_)->ctr)
+
+/* The number of clock ticks until the nearest expiration at every tick rate
+* (0 for none), which QTimeEvt_ticksToNext() returns without scanning the
+* lists. QTimeEvt_tick_() recomputes it during its scan of the list and
+* arming a time event can only lower it, so it never exceeds the number of
+* ticks until the nearest expiration. It can be lower after a time event
+* has been disarmed or re-armed for later, which only causes an early
+* wake-up of the "tickless" ticker until the next clock tick.
+*/
+static QTimeEvtCtr l_nextCtr[QF_MAX_TICK_RATE];
+
+/*..........................................................................*/
+/* lower the nearest expiration at the tick rate to 'nTicks' (0 for none)
+* NOTE: must be called inside the time event critical section
+*/
+static void QTimeEvt_next_(uint_fast8_t const tickRate,
+                           QTimeEvtCtr const nTicks)
+{
+    if ((nTicks != 0U)
+        && ((l_nextCtr[tickRate] == 0U) || (nTicks < l_nextCtr[tickRate])))
+    {
+        l_nextCtr[tickRate] = nTicks;
+    }
+}
+#endif /* QF_TIMEEVT_WHEEL */
+
+#if (QF_MAX_HRTIMER > 0U)
+/* Heap of high-resolution time events ====================================*/
+#ifndef QF_HRTIMER_SET_
+    #error "QF port with QF_MAX_HRTIMER > 0 must define QF_HRTIMER_SET_()"
+#endif
+
+static QHrTimeEvt *l_hrHeap[QF_MAX_HRTIMER]; /* min-heap by the deadline */
+static uint_fast16_t l_hrHeapLen; /* number of armed time events */
+
+/*..........................................................................*/
+/* put the time event into the heap hole at 'idx' and restore the order
+* of the heap by moving the hole up or down
+* NOTE: must be called inside a critical section
+*/
+static void QHrTimeEvt_sift_(QHrTimeEvt * const me, uint_fast16_t idx) {
+    while (idx > 0U) { /* parent expires later? */
+        uint_fast16_t const parent = (idx - 1U) / 2U;
+        if (l_hrHeap[parent]->deadline <= me->deadline) {
+            break;
+        }
+        l_hrHeap[idx] = l_hrHeap[parent];
+        l_hrHeap[idx]->heapIdx = idx + 1U;
+        idx = parent;
+    }
+    for (;;) { /* any child expires sooner? */
+        uint_fast16_t child = (2U * idx) + 1U;
+        if (child >= l_hrHeapLen) {
+            break;
+        }
+        if (((child + 1U) < l_hrHeapLen)
+            && (l_hrHeap[child + 1U]->deadline < l_hrHeap[child]->deadline))
+        {
+            ++child;
+        }
+        if (me->deadline <= l_hrHeap[child]->deadline) {
+            break;
+        }
+        l_hrHeap[idx] = l_hrHeap[child];
+        l_hrHeap[idx]->heapIdx = idx + 1U;
+        idx = child;
+    }
+    l_hrHeap[idx] = me;
+    me->heapIdx = idx + 1U;
+}
+/*..........................................................................*/
+/* remove the time event at the heap position 'idx'
+* NOTE: must be called inside a critical section
+*/
+static void QHrTimeEvt_remove_(uint_fast16_t const idx) {
+    l_hrHeap[idx]->heapIdx = 0U; /* disarmed */
+    --l_hrHeapLen;
+    if (idx < l_hrHeapLen) { /* not the last one? */
+        QHrTimeEvt_sift_(l_hrHeap[l_hrHeapLen], idx);
+    }
+}
+#endif /* (QF_MAX_HRTIMER > 0U) */
+
 /*$skip${QP_VERSION} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
 /* Check for the minimum required QP version */
 #if (QP_VERSION < 690U) || (QP_VERSION != ((QP_RELEASE^4294967295U) % 0x3E8U))
@@ -132,11 +292,14 @@ void QTimeEvt_armX(QTimeEvt * const me,
     (void)ctr; /* avoid compiler warning about unused variable */
     #endif
 
+    QF_TICKLESS_SYNC_(tickRate); /* deliver the ticks skipped by the ticker */
+
     QF_CRIT_STAT_
-    QF_CRIT_E_();
+    QF_TIMEEVT_CRIT_E_(tickRate);
     me->ctr = nTicks;
     me->interval = interval;
 
+    #ifndef QF_TIMEEVT_WHEEL
     /* is the time event unlinked?
     * NOTE: For the duration of a single clock tick of the specified tick
     * rate a time event can be disarmed and yet still linked into the list,
@@ -156,6 +319,13 @@ void QTimeEvt_armX(QTimeEvt * const me,
         me->next = (QTimeEvt *)QTimeEvt_timeEvtHead_[tickRate].act;
         QTimeEvt_timeEvtHead_[tickRate].act = me;
     }
+    QTimeEvt_next_(tickRate, nTicks); /* the nearest expiration so far */
+    #else
+    /* a disarmed time event is never linked into the timing wheel */
+    me->super.refCtr_ |= QTE_IS_LINKED; /* mark as linked */
+    me->expiry = (QTimeEvtCtr)(l_wheel[tickRate].now + nTicks);
+    QTimeEvt_link_(me, tickRate);
+    #endif /* QF_TIMEEVT_WHEEL */
 
     QS_BEGIN_NOCRIT_PRE_(QS_QF_TIMEEVT_ARM, qs_id)
         QS_TIME_PRE_();        /* timestamp */
@@ -166,7 +336,9 @@ void QTimeEvt_armX(QTimeEvt * const me,
         QS_U8_PRE_(tickRate);  /* tick rate */
     QS_END_NOCRIT_PRE_()
 
-    QF_CRIT_X_();
+    QF_TIMEEVT_CRIT_X_(tickRate);
+
+    QF_TICKLESS_WAKE_(tickRate, nTicks); /* expires sooner than planned? */
 }
 
 /*${QF::QTimeEvt::disarm} ..................................................*/
@@ -175,8 +347,12 @@ bool QTimeEvt_disarm(QTimeEvt * const me) {
     uint_fast8_t const qs_id = QACTIVE_CAST_(me->act)->prio;
     #endif
 
+    uint_fast8_t const tickRate
+                       = (uint_fast8_t)me->super.refCtr_ & QTE_TICK_RATE;
+    Q_UNUSED_PAR(tickRate); /* when Q_SPY and QF_OBJ_CRIT undefined */
+
     QF_CRIT_STAT_
-    QF_CRIT_E_();
+    QF_TIMEEVT_CRIT_E_(tickRate);
 
     /* is the time event actually armed? */
     bool wasArmed;
@@ -188,12 +364,17 @@ bool QTimeEvt_disarm(QTimeEvt * const me) {
             QS_TIME_PRE_();            /* timestamp */
             QS_OBJ_PRE_(me);           /* this time event object */
             QS_OBJ_PRE_(me->act);      /* the target AO */
-            QS_TEC_PRE_(me->ctr);      /* the number of ticks */
+            QS_TEC_PRE_(QTE_CTR_(me, tickRate)); /* the number of ticks */
             QS_TEC_PRE_(me->interval); /* the interval */
-            QS_U8_PRE_(me->super.refCtr_ & QTE_TICK_RATE);
+            QS_U8_PRE_(tickRate);      /* tick rate */
         QS_END_NOCRIT_PRE_()
 
         me->ctr = 0U;  /* schedule removal from the list */
+    #ifdef QF_TIMEEVT_WHEEL
+        /* the timing wheel unlinks the time event right away */
+        QTimeEvt_unlink_(me, tickRate);
+        me->super.refCtr_ &= (uint8_t)(~QTE_IS_LINKED & 0xFFU);
+    #endif
     }
     else { /* the time event was already disarmed automatically */
         wasArmed = false;
@@ -203,11 +384,11 @@ bool QTimeEvt_disarm(QTimeEvt * const me) {
             QS_TIME_PRE_();            /* timestamp */
             QS_OBJ_PRE_(me);           /* this time event object */
             QS_OBJ_PRE_(me->act);      /* the target AO */
-            QS_U8_PRE_(me->super.refCtr_ & QTE_TICK_RATE);
+            QS_U8_PRE_(tickRate);      /* tick rate */
         QS_END_NOCRIT_PRE_()
 
     }
-    QF_CRIT_X_();
+    QF_TIMEEVT_CRIT_X_(tickRate);
 
     return wasArmed;
 }
@@ -230,14 +411,17 @@ bool QTimeEvt_rearm(QTimeEvt * const me,
                       && (nTicks != 0U)
                       && (me->super.sig >= (QSignal)Q_USER_SIG));
 
+    QF_TICKLESS_SYNC_(tickRate); /* deliver the ticks skipped by the ticker */
+
     QF_CRIT_STAT_
-    QF_CRIT_E_();
+    QF_TIMEEVT_CRIT_E_(tickRate);
 
     /* is the time evt not running? */
     bool wasArmed;
     if (me->ctr == 0U) {
         wasArmed = false;
 
+    #ifndef QF_TIMEEVT_WHEEL
         /* NOTE: For the duration of a single clock tick of the specified
         * tick rate a time event can be disarmed and yet still linked into
         * the list, because unlinking is performed exclusively in the
@@ -258,11 +442,23 @@ bool QTimeEvt_rearm(QTimeEvt * const me,
             me->next = (QTimeEvt *)QTimeEvt_timeEvtHead_[tickRate].act;
             QTimeEvt_timeEvtHead_[tickRate].act = me;
         }
+    #else
+        me->super.refCtr_ |= QTE_IS_LINKED; /* mark as linked */
+    #endif /* QF_TIMEEVT_WHEEL */
     }
     else { /* the time event was armed */
         wasArmed = true;
+    #ifdef QF_TIMEEVT_WHEEL
+        QTimeEvt_unlink_(me, tickRate); /* to be linked to the new slot */
+    #endif
     }
     me->ctr = nTicks; /* re-load the tick counter (shift the phasing) */
+    #ifndef QF_TIMEEVT_WHEEL
+    QTimeEvt_next_(tickRate, nTicks); /* the nearest expiration so far */
+    #else
+    me->expiry = (QTimeEvtCtr)(l_wheel[tickRate].now + nTicks);
+    QTimeEvt_link_(me, tickRate);
+    #endif
 
     QS_BEGIN_NOCRIT_PRE_(QS_QF_TIMEEVT_REARM, qs_id)
         QS_TIME_PRE_();            /* timestamp */
@@ -273,7 +469,9 @@ bool QTimeEvt_rearm(QTimeEvt * const me,
         QS_2U8_PRE_(tickRate, (wasArmed ? 1U : 0U));
     QS_END_NOCRIT_PRE_()
 
-    QF_CRIT_X_();
+    QF_TIMEEVT_CRIT_X_(tickRate);
+
+    QF_TICKLESS_WAKE_(tickRate, nTicks); /* expires sooner than planned? */
 
     return wasArmed;
 }
@@ -287,10 +485,14 @@ bool QTimeEvt_wasDisarmed(QTimeEvt * const me) {
 
 /*${QF::QTimeEvt::currCtr} .................................................*/
 QTimeEvtCtr QTimeEvt_currCtr(QTimeEvt const * const me) {
+    uint_fast8_t const tickRate
+                       = (uint_fast8_t)me->super.refCtr_ & QTE_TICK_RATE;
+    Q_UNUSED_PAR(tickRate); /* when QF_OBJ_CRIT undefined */
+
     QF_CRIT_STAT_
-    QF_CRIT_E_();
-    QTimeEvtCtr const ret = me->ctr;
-    QF_CRIT_X_();
+    QF_TIMEEVT_CRIT_E_(tickRate);
+    QTimeEvtCtr const ret = (me->ctr != 0U) ? QTE_CTR_(me, tickRate) : 0U;
+    QF_TIMEEVT_CRIT_X_(tickRate);
 
     return ret;
 }
@@ -302,10 +504,12 @@ void QTimeEvt_tick_(
 {
     Q_UNUSED_PAR(sender); /* when Q_SPY undefined */
 
+    #ifndef QF_TIMEEVT_WHEEL
     QTimeEvt *prev = &QTimeEvt_timeEvtHead_[tickRate];
+    QTimeEvtCtr nextCtr = 0U; /* the nearest expiration after this tick */
 
     QF_CRIT_STAT_
-    QF_CRIT_E_();
+    QF_TIMEEVT_CRIT_E_(tickRate);
 
     QS_BEGIN_NOCRIT_PRE_(QS_QF_TICK, 0U)
         ++prev->ctr;
@@ -313,6 +517,9 @@ void QTimeEvt_tick_(
         QS_U8_PRE_(tickRate);   /* tick rate */
     QS_END_NOCRIT_PRE_()
 
+    /* recomputed by the scan below and lowered by any arming meanwhile */
+    l_nextCtr[tickRate] = 0U;
+
     /* scan the linked-list of time events at this rate... */
     for (;;) {
         QTimeEvt *t = prev->next;  /* advance down the time evt. list */
@@ -324,12 +531,13 @@ void QTimeEvt_tick_(
             if (QTimeEvt_timeEvtHead_[tickRate].act != (void *)0) {
 
                 /* sanity check */
-                Q_ASSERT_CRIT_(110, prev != (QTimeEvt *)0);
+                Q_ASSERT_TIMEEVT_CRIT_(tickRate, 110, prev != (QTimeEvt *)0);
                 prev->next = (QTimeEvt *)QTimeEvt_timeEvtHead_[tickRate].act;
                 QTimeEvt_timeEvtHead_[tickRate].act = (void *)0;
                 t = prev->next;  /* switch to the new list */
             }
             else {
+                QTimeEvt_next_(tickRate, nextCtr);
                 break; /* all currently armed time evts. processed */
             }
         }
@@ -340,7 +548,8 @@ void QTimeEvt_tick_(
             /* mark time event 't' as NOT linked */
             t->super.refCtr_ &= (uint8_t)(~QTE_IS_LINKED & 0xFFU);
             /* do NOT advance the prev pointer */
-            QF_CRIT_X_(); /* exit crit. section to reduce latency */
+            /* exit crit. section to reduce latency */
+            QF_TIMEEVT_CRIT_X_(tickRate);
 
             /* prevent merging critical sections, see NOTE1 below  */
             QF_CRIT_EXIT_NOP();
@@ -357,6 +566,9 @@ void QTimeEvt_tick_(
                 if (t->interval != 0U) {
                     t->ctr = t->interval; /* rearm the time event */
                     prev = t; /* advance to this time event */
+                    if ((nextCtr == 0U) || (t->ctr < nextCtr)) {
+                        nextCtr = t->ctr;
+                    }
                 }
                 /* one-shot time event: automatically disarm */
                 else {
@@ -380,14 +592,19 @@ void QTimeEvt_tick_(
                     QS_U8_PRE_(tickRate);      /* tick rate */
                 QS_END_NOCRIT_PRE_()
 
-                QF_CRIT_X_(); /* exit critical section before posting */
+                /* exit critical section before posting */
+                QF_TIMEEVT_CRIT_X_(tickRate);
 
                 /* QACTIVE_POST() asserts internally if the queue overflows */
                 QACTIVE_POST(act, &t->super, sender);
             }
             else {
                 prev = t;         /* advance to this time event */
-                QF_CRIT_X_();  /* exit crit. section to reduce latency */
+                if ((nextCtr == 0U) || (t->ctr < nextCtr)) {
+                    nextCtr = t->ctr;
+                }
+                /* exit crit. section to reduce latency */
+                QF_TIMEEVT_CRIT_X_(tickRate);
 
                 /* prevent merging critical sections
                 * In some QF ports the critical section exit takes effect only
@@ -402,9 +619,102 @@ void QTimeEvt_tick_(
                 QF_CRIT_EXIT_NOP();
             }
         }
-        QF_CRIT_E_(); /* re-enter crit. section to continue */
+        /* re-enter crit. section to continue */
+        QF_TIMEEVT_CRIT_E_(tickRate);
     }
-    QF_CRIT_X_();
+    QF_TIMEEVT_CRIT_X_(tickRate);
+    #else /* the hierarchical timing wheel */
+    QTimeEvtWheel * const wheel = &l_wheel[tickRate];
+
+    QF_CRIT_STAT_
+    QF_TIMEEVT_CRIT_E_(tickRate);
+
+    QS_BEGIN_NOCRIT_PRE_(QS_QF_TICK, 0U)
+        ++QTimeEvt_timeEvtHead_[tickRate].ctr;
+        QS_TEC_PRE_(QTimeEvt_timeEvtHead_[tickRate].ctr); /* tick ctr */
+        QS_U8_PRE_(tickRate);   /* tick rate */
+    QS_END_NOCRIT_PRE_()
+
+    wheel->now = (QTimeEvtCtr)(wheel->now + 1U);
+
+    /* cascade the upper levels, whose lower digits wrapped around */
+    for (uint_fast8_t level = 1U;
+         (level < QTE_WHEEL_LEVELS)
+         && (QTE_WHEEL_DIGIT_(wheel->now, level - 1U) == 0U);
+         ++level)
+    {
+        /* detach the whole slot, so that the time events landing in
+        * the same slot again (next turn of the level) stay there
+        */
+        QTimeEvt * volatile * const head
+            = &wheel->slot[level][QTE_WHEEL_DIGIT_(wheel->now, level)];
+        QTimeEvt * volatile list = *head;
+        *head = (QTimeEvt *)0;
+        if (list != (QTimeEvt *)0) {
+            list->prev = &list;
+        }
+        while (list != (QTimeEvt *)0) {
+            QTimeEvt * const t = list;
+            QTimeEvt_unlink_(t, tickRate);
+            QTimeEvt_link_(t, tickRate); /* to a lower level */
+
+            /* exit crit. section to reduce latency */
+            QF_TIMEEVT_CRIT_X_(tickRate);
+
+            /* prevent merging critical sections */
+            QF_CRIT_EXIT_NOP();
+
+            QF_TIMEEVT_CRIT_E_(tickRate);
+        }
+    }
+
+    /* all time events in the current slot of the level 0 expire now */
+    QTimeEvt * volatile * const head
+        = &wheel->slot[0][QTE_WHEEL_DIGIT_(wheel->now, 0U)];
+    for (QTimeEvt *t = *head; t != (QTimeEvt *)0; t = *head) {
+        /* temporary for volatile */
+        QActive * const act = (QActive *)t->act;
+
+        QTimeEvt_unlink_(t, tickRate);
+
+        /* periodic time evt? */
+        if (t->interval != 0U) {
+            /* rearm the time event */
+            t->expiry = (QTimeEvtCtr)(wheel->now + t->interval);
+            QTimeEvt_link_(t, tickRate);
+        }
+        /* one-shot time event: automatically disarm */
+        else {
+            t->ctr = 0U;
+            /* mark time event 't' as NOT linked */
+            t->super.refCtr_ &= (uint8_t)(~QTE_IS_LINKED & 0xFFU);
+
+            QS_BEGIN_NOCRIT_PRE_(QS_QF_TIMEEVT_AUTO_DISARM, act->prio)
+                QS_OBJ_PRE_(t);        /* this time event object */
+                QS_OBJ_PRE_(act);      /* the target AO */
+                QS_U8_PRE_(tickRate);  /* tick rate */
+            QS_END_NOCRIT_PRE_()
+        }
+
+        QS_BEGIN_NOCRIT_PRE_(QS_QF_TIMEEVT_POST, act->prio)
+            QS_TIME_PRE_();            /* timestamp */
+            QS_OBJ_PRE_(t);            /* the time event object */
+            QS_SIG_PRE_(t->super.sig); /* signal of this time event */
+            QS_OBJ_PRE_(act);          /* the target AO */
+            QS_U8_PRE_(tickRate);      /* tick rate */
+        QS_END_NOCRIT_PRE_()
+
+        /* exit critical section before posting */
+        QF_TIMEEVT_CRIT_X_(tickRate);
+
+        /* QACTIVE_POST() asserts internally if the queue overflows */
+        QACTIVE_POST(act, &t->super, sender);
+
+        /* re-enter crit. section to continue */
+        QF_TIMEEVT_CRIT_E_(tickRate);
+    }
+    QF_TIMEEVT_CRIT_X_(tickRate);
+    #endif /* QF_TIMEEVT_WHEEL */
 }
 
 /*${QF::QTimeEvt::noActive} ................................................*/
@@ -413,15 +723,179 @@ bool QTimeEvt_noActive(uint_fast8_t const tickRate) {
     Q_REQUIRE_ID(200, tickRate < QF_MAX_TICK_RATE);
 
     bool inactive;
+    #ifdef QF_TIMEEVT_WHEEL
+    if (l_wheel[tickRate].nLinked != 0U) {
+        inactive = false;
+    }
+    #else
     if (QTimeEvt_timeEvtHead_[tickRate].next != (QTimeEvt *)0) {
         inactive = false;
     }
     else if ((QTimeEvt_timeEvtHead_[tickRate].act != (void *)0)) {
         inactive = false;
     }
+    #endif /* QF_TIMEEVT_WHEEL */
     else {
         inactive = true;
     }
     return inactive;
 }
+
+/*${QF::QTimeEvt::ticksToNext} .............................................*/
+QTimeEvtCtr QTimeEvt_ticksToNext(uint_fast8_t const tickRate) {
+    /*! @pre the tick rate must be in range */
+    Q_REQUIRE_ID(210, tickRate < QF_MAX_TICK_RATE);
+
+    QTimeEvtCtr nTicks = 0U;
+
+    QF_CRIT_STAT_
+    QF_TIMEEVT_CRIT_E_(tickRate);
+
+    #ifndef QF_TIMEEVT_WHEEL
+    /* kept up to date by QTimeEvt_tick_() and by arming time events */
+    nTicks = l_nextCtr[tickRate];
+    #else
+    /* The slots of every level cover consecutive ranges of ticks in the
+    * order of their cascading, so only the first occupied slot of every
+    * level (starting after the current digit of that level) can hold
+    * the nearest expiration.
+    */
+    QTimeEvtWheel const * const wheel = &l_wheel[tickRate];
+    for (uint_fast8_t level = 0U; level < QTE_WHEEL_LEVELS; ++level) {
+        uint_fast8_t const digit = QTE_WHEEL_DIGIT_(wheel->now, level);
+        QTimeEvt const *t = (QTimeEvt *)0;
+        for (uint_fast16_t n = 1U;
+             (n <= QTE_WHEEL_SLOTS) && (t == (QTimeEvt *)0);
+             ++n)
+        {
+            t = wheel->slot[level][(digit + n) & QTE_WHEEL_MASK];
+        }
+        for (; t != (QTimeEvt *)0; t = t->next) {
+            QTimeEvtCtr const left = QTE_CTR_(t, tickRate);
+            if ((nTicks == 0U) || (left < nTicks)) {
+                nTicks = left;
+            }
+        }
+    }
+    #endif /* QF_TIMEEVT_WHEEL */
+
+    QF_TIMEEVT_CRIT_X_(tickRate);
+
+    return nTicks;
+}
 /*$enddef${QF::QTimeEvt} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+#if (QF_MAX_HRTIMER > 0U)
+/*$define${QF::QHrTimeEvt} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
+
+/*${QF::QHrTimeEvt::ctor} ..................................................*/
+void QHrTimeEvt_ctor(QHrTimeEvt * const me,
+    QActive * const act,
+    enum_t const sig)
+{
+    /*! @pre The active object and the signal must be valid */
+    Q_REQUIRE_ID(700, (act != (QActive *)0)
+                      && (sig >= (enum_t)Q_USER_SIG));
+
+    me->super.sig = (QSignal)sig;
+    me->super.poolId_ = 0U; /* not allocated from an event pool */
+    me->super.refCtr_ = 0U;
+    me->act      = act;
+    me->deadline = 0U;
+    me->heapIdx  = 0U;
+}
+
+/*${QF::QHrTimeEvt::armAt} .................................................*/
+void QHrTimeEvt_armAt(QHrTimeEvt * const me,
+    uint64_t const deadline)
+{
+    /*! @pre the time event must be constructed and disarmed */
+    Q_REQUIRE_ID(800, (me->act != (void *)0)
+                      && (me->heapIdx == 0U)
+                      && (me->super.sig >= (QSignal)Q_USER_SIG));
+
+    QF_CRIT_STAT_
+    QF_CRIT_E_();
+
+    /* the heap must have room for the time event */
+    Q_ASSERT_CRIT_(810, l_hrHeapLen < QF_MAX_HRTIMER);
+
+    /* the deadline of 0 is reserved for "no deadline" */
+    me->deadline = (deadline != 0U) ? deadline : 1U;
+    ++l_hrHeapLen;
+    QHrTimeEvt_sift_(me, l_hrHeapLen - 1U);
+
+    if (me->heapIdx == 1U) { /* the new earliest deadline? */
+        QF_HRTIMER_SET_(me->deadline);
+    }
+
+    QF_CRIT_X_();
+}
+
+/*${QF::QHrTimeEvt::armIn} .................................................*/
+void QHrTimeEvt_armIn(QHrTimeEvt * const me,
+    uint64_t const delay)
+{
+    QHrTimeEvt_armAt(me, QF_hrTimeNow() + delay);
+}
+
+/*${QF::QHrTimeEvt::disarm} ................................................*/
+bool QHrTimeEvt_disarm(QHrTimeEvt * const me) {
+    QF_CRIT_STAT_
+    QF_CRIT_E_();
+
+    bool const wasArmed = (me->heapIdx != 0U);
+    if (wasArmed) {
+        /* NOTE: the QF port is not notified, so the earliest deadline
+        * might still wake it up once, finding nothing to post.
+        */
+        QHrTimeEvt_remove_(me->heapIdx - 1U);
+    }
+
+    QF_CRIT_X_();
+
+    return wasArmed;
+}
+
+/*${QF::QHrTimeEvt::expire_} ...............................................*/
+void QHrTimeEvt_expire_(
+    uint64_t const now,
+    void const * const sender)
+{
+    Q_UNUSED_PAR(sender); /* when Q_SPY undefined */
+
+    QF_CRIT_STAT_
+    QF_CRIT_E_();
+
+    /* post all time events with the deadline up to now, soonest first */
+    while ((l_hrHeapLen != 0U) && (l_hrHeap[0]->deadline <= now)) {
+        QHrTimeEvt * const t = l_hrHeap[0];
+        /* temporary for volatile */
+        QActive * const act = (QActive *)t->act;
+
+        QHrTimeEvt_remove_(0U); /* one-shot: automatically disarm */
+
+        QS_BEGIN_NOCRIT_PRE_(QS_QF_TIMEEVT_POST, act->prio)
+            QS_TIME_PRE_();            /* timestamp */
+            QS_OBJ_PRE_(t);            /* the time event object */
+            QS_SIG_PRE_(t->super.sig); /* signal of this time event */
+            QS_OBJ_PRE_(act);          /* the target AO */
+            QS_U8_PRE_(0xFFU);         /* no tick rate (high-resolution) */
+        QS_END_NOCRIT_PRE_()
+
+        /* exit critical section before posting */
+        QF_CRIT_X_();
+
+        /* QACTIVE_POST() asserts internally if the queue overflows */
+        QACTIVE_POST(act, &t->super, sender);
+
+        /* re-enter crit. section to continue */
+        QF_CRIT_E_();
+    }
+
+    /* the next deadline for the QF port (0 for none) */
+    QF_HRTIMER_SET_((l_hrHeapLen != 0U) ? l_hrHeap[0]->deadline : 0U);
+
+    QF_CRIT_X_();
+}
+/*$enddef${QF::QHrTimeEvt} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+#endif /* (QF_MAX_HRTIMER > 0U) */
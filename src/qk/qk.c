@@ -55,6 +55,11 @@
     #error "Source file included in a project NOT based on the QK kernel"
 #endif /* QK_H */
 
+/* the hierarchical ::QPSet (QF_MAX_ACTIVE > 64U) is for the POSIX ports */
+#if (QF_MAX_ACTIVE > 64U)
+    #error "The QK kernel supports at most 64 active objects"
+#endif
+
 Q_DEFINE_THIS_MODULE("qk")
 
 /*==========================================================================*/
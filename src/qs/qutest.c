@@ -50,6 +50,10 @@
 #include "qs_port.h"  /* include QS port */
 #include "qs_pkg.h"   /* QS facilities for pre-defined trace records */
 
+#ifdef QF_TIMEEVT_WHEEL
+    #error "QTimeEvt_tick1_() does not support QF_TIMEEVT_WHEEL"
+#endif /* QF_TIMEEVT_WHEEL */
+
 /*==========================================================================*/
 /* QUTest unit testing harness */
 /*$skip${QP_VERSION} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
@@ -55,6 +55,10 @@
     #error "Source file included in a project NOT based on the QXK kernel"
 #endif /* QXK_H */
 
+#ifdef QF_TIMEEVT_WHEEL
+    #error "The QXK extended threads do not support QF_TIMEEVT_WHEEL"
+#endif /* QF_TIMEEVT_WHEEL */
+
 Q_DEFINE_THIS_MODULE("qxk_xthr")
 
 /*==========================================================================*/